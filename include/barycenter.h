@@ -2,7 +2,7 @@
  * barycenter.h
  * Author: Sinan Demir
  * Date: 11/20/2025
- * Purpose: Declares barycenter normalization function
+ * Purpose: Declares barycenter normalization, tracking and re-centering
  ***********/
 
 #pragma once
@@ -12,6 +12,76 @@
 
 namespace physics {
 
+/***********************
+ * struct Barycenter
+ * @brief: Center of mass of a system.
+ ***********************/
+struct Barycenter {
+    double totalMass = 0.0;  ///< Σ m_i (kg)
+    vec3   position;         ///< R_cm = Σ m_i r_i / M (m)
+    vec3   velocity;         ///< V_cm = Σ m_i v_i / M (m/s)
+};
+
+/***********************
+ * computeBarycenter
+ * @brief: Single O(N) pass over the bodies.
+ * @return: Barycenter (zero vectors if total mass is zero)
+ ***********************/
+Barycenter computeBarycenter(const std::vector<CelestialBody>& bodies);
+
+/***********************
+ * shiftBodies
+ * @brief: Adds dr to every position and dv to every velocity.
+ ***********************/
+void shiftBodies(std::vector<CelestialBody>& bodies, const vec3& dr, const vec3& dv);
+
 void normalizeToBarycenter(std::vector<CelestialBody>& bodies);
 
+/***********************
+ * class BarycenterTracker
+ * @brief: Follows the center of mass during a run and removes numerical
+ *         drift from it.
+ *
+ * In exact Newtonian dynamics the barycenter moves uniformly:
+ *      R_cm(t) = R_cm(0) + V_cm(0) t,   V_cm(t) = V_cm(0)
+ * The tracker records that reference at reset() and, on every update(),
+ * measures how far the integrated system has wandered from it. recenter()
+ * shifts all bodies in one pass so the barycenter is back on its reference
+ * trajectory (for a --normalize'd system: the origin, at rest).
+ ***********************/
+class BarycenterTracker {
+public:
+    /// Records the reference barycenter of the initial state.
+    void reset(const std::vector<CelestialBody>& bodies);
+
+    /// Recomputes the current barycenter after advancing by dt seconds.
+    void update(const std::vector<CelestialBody>& bodies, double dt);
+
+    /// Shifts all bodies so the barycenter matches its reference again.
+    void recenter(std::vector<CelestialBody>& bodies);
+
+    /// @return Current position drift from the reference trajectory (m).
+    vec3 positionDrift() const { return current.position - expectedPosition(); }
+
+    /// @return Current velocity drift from the initial COM velocity (m/s).
+    vec3 velocityDrift() const { return current.velocity - reference.velocity; }
+
+    /// @return Largest |position drift| seen since reset (m).
+    double maxPositionDrift() const { return maxDrift; }
+
+    /// @return Number of recenter() corrections applied since reset.
+    long corrections() const { return correctionCount; }
+
+    const Barycenter& barycenter() const { return current; }
+
+private:
+    vec3 expectedPosition() const { return reference.position + reference.velocity * elapsed; }
+
+    Barycenter reference;
+    Barycenter current;
+    double     elapsed = 0.0;       // simulated time since reset (s)
+    double     maxDrift = 0.0;
+    long       correctionCount = 0;
+};
+
 } // end namespace physics
@@ -0,0 +1,205 @@
+/****************
+ * Author: Sinan Demir
+ * File: chebyshev_ephemeris.h
+ * Date: 10/16/2026
+ * Purpose:
+ *    Chebyshev-compressed ephemeris, in the spirit of JPL SPK type 2 / DE
+ *    files: the run is cut into fixed-length time windows and every body's
+ *    x, y, z in each window is stored as a Chebyshev series fitted to the
+ *    simulated positions and velocities.
+ *
+ *    Queries locate the window by direct index (no search) and evaluate
+ *    position and velocity together with one Clenshaw recurrence. The
+ *    last window may be partial; it spans [start + (W-1) * length, end].
+ *
+ *    Layout (little-endian, coefficients 8-byte aligned):
+ *
+ *      offset  size  field
+ *      0       8     magic "ORBEPH\0\0"
+ *      8       4     format version (EPHEMERIS_VERSION)
+ *      12      4     byte-order tag 0x01020304
+ *      16      4     body count N
+ *      20      4     coefficients per coordinate C (degree + 1)
+ *      24      8     window count W
+ *      32      8     start time  (s since epoch, f64)
+ *      40      8     window length (s, f64)
+ *      48      8     end of coverage (s since epoch, f64)
+ *      56      8     offset of coefficients
+ *      64      8     total file size (truncation check)
+ *      72      ...   u64 len + epoch, N x (u64 len + body name)
+ *      coeffs        W x N x 3 x C doubles (window, body, axis, k)
+ *****************/
+
+#ifndef ORBIT_SIM_CHEBYSHEV_EPHEMERIS_H
+#define ORBIT_SIM_CHEBYSHEV_EPHEMERIS_H
+
+#include "body.h"
+#include "trajectory_binary.h"   // TrajectoryFrame
+#include "vec3.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+constexpr std::uint32_t EPHEMERIS_VERSION = 2;   ///< 2: partial last window mapped over its own span
+
+/***********************
+ * struct ChebyshevFitOptions
+ * @brief: Window length and polynomial degree of the fit.
+ *
+ *  - windowSteps : integration steps per window (window = windowSteps * dt)
+ *  - degree      : Chebyshev degree per coordinate (coefficients = degree+1)
+ *  - tolerance   : largest position error (m) at any fitted sample before
+ *                  finish() rejects the ephemeris
+ *
+ *  Each window is fitted to windowSteps+1 positions and velocities, so
+ *  degree must stay below 2 * (windowSteps + 1).
+ ***********************/
+struct ChebyshevFitOptions {
+    int    windowSteps = 64;
+    int    degree      = 12;
+    double tolerance   = 1.0;
+};
+
+/***********************
+ * class ChebyshevEphemerisWriter
+ * @brief: Consumes frames in time order (uniform spacing) and writes one
+ *         fitted record per completed window. Memory holds one window.
+ ***********************/
+class ChebyshevEphemerisWriter {
+public:
+    /***********************
+     * open
+     * @brief: Creates the file and writes the provisional header.
+     * @param path   - output path
+     * @param names  - body names (order defines body indices)
+     * @param dt     - spacing of the frames that will be added (s)
+     * @param epoch  - calendar epoch of t = 0 (may be empty)
+     * @param fit    - window / degree settings
+     * @return false on invalid settings or if the file cannot be created
+     ***********************/
+    bool open(const std::string& path,
+              const std::vector<std::string>& names,
+              double dt,
+              const std::string& epoch,
+              const ChebyshevFitOptions& fit = ChebyshevFitOptions{});
+
+    /// Adds the state of all bodies at time t (s since epoch).
+    void add(double t, const std::vector<CelestialBody>& bodies);
+
+    /// Adds a frame read back from a binary trajectory.
+    void add(const TrajectoryFrame& frame);
+
+    /***********************
+     * finish
+     * @brief: Fits the trailing partial window and finalizes the header.
+     * @return false on I/O failure, or if a fitted series misses one of
+     *         the frames it was fitted to by more than the tolerance (the
+     *         file is then removed); error() says which
+     ***********************/
+    bool finish();
+
+    std::uint64_t      windows()  const { return windowCount; }
+    double             maxError() const { return fitError; }   ///< m, over all samples
+    const std::string& error()    const { return failure; }
+
+private:
+    void fitPending();
+
+    std::ofstream       out;
+    std::string         filePath;
+    std::string         failure;
+    double              tolerance    = 1.0;
+    double              fitError     = 0.0;
+    std::size_t         bodyCount    = 0;
+    int                 windowSteps  = 0;
+    int                 coeffCount   = 0;
+    double              windowLength = 0.0;
+    double              tStart       = 0.0;
+    double              tEnd         = 0.0;
+    std::uint64_t       coeffOffset  = 0;
+    std::uint64_t       windowCount  = 0;
+    bool                started      = false;
+
+    std::vector<double> times;    ///< pending frame times
+    std::vector<double> states;   ///< pending frames, N x {x,y,z,vx,vy,vz} each
+    std::vector<double> record;   ///< reused output record (N x 3 x C)
+};
+
+/***********************
+ * class ChebyshevEphemeris
+ * @brief: Maps an ephemeris file read-only and answers state queries in
+ *         place. Thread-safe for concurrent queries.
+ ***********************/
+class ChebyshevEphemeris {
+public:
+    /***********************
+     * ChebyshevEphemeris (constructor)
+     * @param path - ephemeris file
+     * @exception: runtime_error if the file cannot be mapped, is not an
+     *             ephemeris, has an unsupported version or is truncated
+     ***********************/
+    explicit ChebyshevEphemeris(const std::string& path);
+    ~ChebyshevEphemeris();
+
+    ChebyshevEphemeris(const ChebyshevEphemeris&)            = delete;
+    ChebyshevEphemeris& operator=(const ChebyshevEphemeris&) = delete;
+
+    std::size_t      size()         const { return count; }
+    std::string_view name(std::size_t i) const { return names[i]; }
+    std::string_view epoch()        const { return epochText; }
+    double           startTime()    const { return tStart; }
+    double           endTime()      const { return tEnd; }
+    double           windowLength() const { return window; }
+    std::size_t      windows()      const { return windowCount; }
+    int              degree()       const { return coeffCount - 1; }
+
+    /// @return Index of a body by name, or -1 if absent.
+    int bodyIndex(std::string_view name) const;
+
+    /// @return true if t lies inside the fitted span.
+    bool contains(double t) const { return t >= tStart && t <= tEnd; }
+
+    /***********************
+     * state
+     * @brief: Position (m) and velocity (m/s) of a body at time t.
+     * @param body - body index (< size())
+     * @param t    - seconds since epoch; outside [startTime, endTime] the
+     *               nearest window is extrapolated
+     ***********************/
+    void state(std::size_t body, double t, vec3& position, vec3& velocity) const;
+
+    /// @return Position (m) of a body at time t (see state()).
+    vec3 position(std::size_t body, double t) const;
+
+private:
+    const double* windowFor(std::size_t body, double t, double& x, double& scale) const;
+
+    void*                      mapping  = nullptr;
+    std::size_t                mapSize  = 0;
+    std::vector<unsigned char> fallback;   ///< used where mmap is unavailable
+
+    std::size_t                   count       = 0;
+    int                           coeffCount  = 0;
+    std::size_t                   windowCount = 0;
+    double                        tStart      = 0.0;
+    double                        tEnd        = 0.0;
+    double                        window      = 0.0;
+    double                        invWindow   = 0.0;
+    double                        lastWindowStart = 0.0;   ///< start of the (possibly partial) last window
+    double                        invLastSpan     = 0.0;
+    const double*                 coeffs      = nullptr;
+    std::string_view              epochText;
+    std::vector<std::string_view> names;
+};
+
+/***********************
+ * isChebyshevEphemeris
+ * @return true if the file starts with the ephemeris magic.
+ ***********************/
+bool isChebyshevEphemeris(const std::string& path);
+
+#endif // ORBIT_SIM_CHEBYSHEV_EPHEMERIS_H
@@ -21,7 +21,11 @@
  *    - list
  *    - info
  *    - fetch
- *   - validate
+ *    - validate
+ *    - shadow
+ *    - convert
+ *    - compare
+ *    - serve / query / loadtest
  * @note: Additional fields can be added as needed.
  ***********************/
 struct CLIOptions {
@@ -30,6 +34,17 @@ struct CLIOptions {
 
     int steps = 0;
     double dt = 0;
+    int recenterEvery = 0;
+    std::string trajectory;    // run: binary trajectory output; compare: input
+    std::string ephemeris;     // run: Chebyshev ephemeris output
+    int ephemWindow = 0;       // steps per Chebyshev window
+    int ephemDegree = -1;      // Chebyshev degree (-1 = default)
+    double ephemTolerance = 0; // max Chebyshev fit error in m (0 = default)
+    bool profile = false;      // print a per-phase timing breakdown
+    std::string profileTrace;  // Chrome trace-event JSON output
+    int progress = -1;         // -1 auto (terminal only), 0 off, 1 on
+    double progressInterval = 0;
+    std::string statusFile;    // JSON Lines progress for job schedulers
 
     // fetch
     std::string fetchBody;
@@ -37,9 +52,39 @@ struct CLIOptions {
     std::string fetchStart;
     std::string fetchStop;
     std::string fetchStep;
+    std::string fetchBodies;   // comma-separated NAIF IDs (concurrent fetch)
+    std::string cacheDir;
+    std::string horizonsUrl;   // endpoint override (e.g. local stub server)
+    int parallel = 0;
+    bool noCache = false;
     std::string output;
 
+    // shadow
+    std::string input;
+    std::string format;
+    int width   = 0;
+    int height  = 0;
+    int every   = 0;
+    int threads = 0;
+
+    // convert
+    std::string convertTo;
+
+    // compare
+    std::string reference;     // comma-separated HORIZONS files ([Body=]path)
+    std::string epoch;         // epoch of t = 0 (calendar or JD)
+
+    // serve / query / loadtest
+    std::string socketPath;
+    std::string queryOp;       // state | position | eclipse
+    double queryTime = 0;      // query: seconds since epoch
+    int connections = 0;
+    int batch = 0;
+    int pipeline = 0;
+    double seconds = 0;
+
     bool usePost = false;
+    bool emitSystem = false;
     bool verbose = false;
     bool normalize = false;
 };
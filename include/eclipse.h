@@ -10,6 +10,8 @@
  *    Provides:
  *      - EclipseResult struct
  *      - computeSolarEclipse function
+ *      - Vec3SoA / EclipseBatchOutput structs
+ *      - computeSolarEclipseBatch function (SoA, vectorizable)
  *
  * Note:
  *    EclipseResult describes the umbra, penumbra, and antumbra
@@ -22,6 +24,7 @@
 #include "vec3.h"
 #include "utils.h"
 #include <cmath>
+#include <cstddef>
 
 /****************
  * struct EclipseResult
@@ -48,4 +51,51 @@ struct EclipseResult {
  *****************/
 EclipseResult computeSolarEclipse(const vec3& S, const vec3& E, const vec3& M);
 
+/****************
+ * struct Vec3SoA
+ * Purpose: Read-only structure-of-arrays view over n 3D vectors (m).
+ *          x[i], y[i], z[i] are the components of sample i.
+ *****************/
+struct Vec3SoA {
+    const double* x;
+    const double* y;
+    const double* z;
+};
+
+/****************
+ * struct EclipseBatchOutput
+ * Purpose: Structure-of-arrays destination for computeSolarEclipseBatch.
+ *          Every array must hold at least n elements.
+ *****************/
+struct EclipseBatchOutput {
+    double* shadowX;        // shadow center x on Earth's surface (m)
+    double* shadowY;        // shadow center y on Earth's surface (m)
+    double* shadowZ;        // shadow center z on Earth's surface (m)
+    double* umbraRadius;    // umbra radius at Earth (m)
+    double* penumbraRadius; // penumbra radius at Earth (m)
+    int*    eclipseType;    // 0 = none, 1 = total, 2 = annular, 3 = partial
+};
+
+
+/****************
+ * computeSolarEclipseBatch
+ * @brief: Evaluates computeSolarEclipse for n sampled instants at once.
+ * @param: S   - Sun positions   (SoA, n samples)
+ * @param: E   - Earth positions (SoA, n samples)
+ * @param: M   - Moon positions  (SoA, n samples)
+ * @param: n   - number of samples
+ * @param: out - SoA destination arrays (n elements each)
+ * @exception: none
+ * @return: none
+ * @note: The loop body is branch-free (selects instead of if/else) so the
+ *        compiler can vectorize it across samples. Each sample performs the
+ *        same floating-point operations in the same order as the scalar
+ *        computeSolarEclipse, so results are bit-identical to it.
+ *****************/
+void computeSolarEclipseBatch(const Vec3SoA& S,
+                              const Vec3SoA& E,
+                              const Vec3SoA& M,
+                              std::size_t n,
+                              const EclipseBatchOutput& out);
+
 #endif // ECLIPSE_H
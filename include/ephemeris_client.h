@@ -0,0 +1,110 @@
+/********************
+ * Author: Sinan Demir
+ * File: ephemeris_client.h
+ * Date: 10/16/2026
+ * Purpose:
+ *    Blocking client for the `orbit-sim serve` query daemon, plus the
+ *    load generator behind `orbit-sim loadtest`.
+ *
+ *    Typical use:
+ *      EphemerisClient client("/tmp/orbit-sim.sock");
+ *      EphemerisInfo info = client.info();
+ *      std::vector<double> s;   // 6 doubles per query
+ *      client.states({{moon, 0, t0}, {moon, 0, t1}}, s);
+ *********************/
+
+#ifndef ORBIT_SIM_EPHEMERIS_CLIENT_H
+#define ORBIT_SIM_EPHEMERIS_CLIENT_H
+
+#include "ephemeris_protocol.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/********************
+ * struct EphemerisInfo
+ * @brief: What the server holds (OP_INFO reply).
+ *********************/
+struct EphemerisInfo {
+    std::vector<std::string> bodies;
+    std::string              epoch;
+    double                   startTime = 0.0;   ///< s since epoch
+    double                   endTime   = 0.0;
+    int                      degree    = 0;
+
+    /// @return Index of a body by name, or -1 if absent.
+    int bodyIndex(const std::string& name) const;
+};
+
+/********************
+ * class EphemerisClient
+ * @brief: One connection to the daemon. Not thread-safe; use one client
+ *         per thread.
+ *********************/
+class EphemerisClient {
+public:
+    /********************
+     * EphemerisClient (constructor)
+     * @param socketPath - daemon socket
+     * @exception: runtime_error if the connection fails
+     *********************/
+    explicit EphemerisClient(const std::string& socketPath);
+    ~EphemerisClient();
+
+    EphemerisClient(const EphemerisClient&)            = delete;
+    EphemerisClient& operator=(const EphemerisClient&) = delete;
+
+    EphemerisInfo info();
+
+    /// Batched queries; results are appended in query order.
+    /// @exception: runtime_error on a non-OK status or a broken connection
+    void states(const std::vector<protocol::QueryRecord>& queries, std::vector<double>& out);
+    void positions(const std::vector<protocol::QueryRecord>& queries, std::vector<double>& out);
+    void eclipses(const std::vector<double>& times, std::vector<protocol::EclipseRecord>& out);
+
+    /********************
+     * send / receive
+     * @brief: Low-level pipelining: send several requests, then read the
+     *         replies (which arrive in order).
+     *********************/
+    std::uint32_t send(protocol::Op op, const protocol::QueryRecord* queries, std::uint32_t count);
+    protocol::ResponseHeader receive(std::vector<char>& payload);
+
+private:
+    void roundTrip(protocol::Op op, const std::vector<protocol::QueryRecord>& queries,
+                   std::vector<char>& payload);
+
+    int           fd = -1;
+    std::uint32_t nextId = 1;
+    std::vector<char> sendBuffer;
+};
+
+/********************
+ * struct LoadTestOptions
+ * @brief: Options for `orbit-sim loadtest`.
+ *
+ *  - connections : concurrent client threads
+ *  - batch       : queries per request
+ *  - pipeline    : requests in flight per connection
+ *  - seconds     : test duration
+ *  - op          : OP_STATE, OP_POSITION or OP_ECLIPSE
+ *********************/
+struct LoadTestOptions {
+    std::string  socketPath = "/tmp/orbit-sim.sock";
+    int          connections = 4;
+    int          batch       = 256;
+    int          pipeline    = 4;
+    double       seconds     = 5.0;
+    protocol::Op op          = protocol::OP_STATE;
+};
+
+/********************
+ * runLoadTest
+ * @brief: Drives the daemon with random in-range queries and prints
+ *         throughput and per-request latency percentiles.
+ * @return true if every reply was OK
+ *********************/
+bool runLoadTest(const LoadTestOptions& opts);
+
+#endif // ORBIT_SIM_EPHEMERIS_CLIENT_H
@@ -0,0 +1,95 @@
+/****************
+ * Author: Sinan Demir
+ * File: ephemeris_protocol.h
+ * Date: 10/16/2026
+ * Purpose:
+ *    Binary wire format spoken by `orbit-sim serve` over a Unix domain
+ *    socket (native byte order, the peers share a machine).
+ *
+ *    Request  : RequestHeader, then `count` QueryRecord
+ *    Response : ResponseHeader, then `payloadBytes` of results:
+ *      OP_STATE    count x 6 doubles  (x, y, z, vx, vy, vz)  m, m/s
+ *      OP_POSITION count x 3 doubles  (x, y, z)              m
+ *      OP_ECLIPSE  count x EclipseRecord (body field ignored)
+ *      OP_INFO     InfoRecord, the epoch string (epochBytes), then the
+ *                  body names, each '\n'-terminated (count ignored)
+ *
+ *    Every request is a batch; a connection may pipeline requests and
+ *    receives responses in order.
+ *****************/
+
+#ifndef ORBIT_SIM_EPHEMERIS_PROTOCOL_H
+#define ORBIT_SIM_EPHEMERIS_PROTOCOL_H
+
+#include <cstdint>
+
+namespace protocol {
+
+constexpr std::uint32_t REQUEST_MAGIC  = 0x5152534Fu;   // "OSRQ"
+constexpr std::uint32_t RESPONSE_MAGIC = 0x5352534Fu;   // "OSRS"
+constexpr std::uint16_t VERSION        = 1;
+constexpr std::uint32_t MAX_BATCH      = 1u << 16;      // queries per request
+
+enum Op : std::uint16_t {
+    OP_INFO     = 0,
+    OP_STATE    = 1,
+    OP_POSITION = 2,
+    OP_ECLIPSE  = 3,
+};
+
+enum Status : std::uint16_t {
+    STATUS_OK           = 0,
+    STATUS_BAD_REQUEST  = 1,   ///< unknown op or oversized batch
+    STATUS_BAD_BODY     = 2,   ///< body index out of range
+    STATUS_OUT_OF_RANGE = 3,   ///< t outside the ephemeris span
+    STATUS_UNSUPPORTED  = 4,   ///< e.g. eclipse without Sun/Earth/Moon
+};
+
+struct RequestHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t op;
+    std::uint32_t count;       ///< number of QueryRecord that follow
+    std::uint32_t requestId;   ///< echoed in the response
+};
+static_assert(sizeof(RequestHeader) == 16, "request header must be packed");
+
+struct QueryRecord {
+    std::uint32_t body;        ///< index into the server's body list
+    std::uint32_t reserved;
+    double        t;           ///< seconds since the ephemeris epoch
+};
+static_assert(sizeof(QueryRecord) == 16, "query record must be packed");
+
+struct ResponseHeader {
+    std::uint32_t magic;
+    std::uint16_t status;
+    std::uint16_t op;
+    std::uint32_t count;
+    std::uint32_t requestId;
+    std::uint64_t payloadBytes;
+};
+static_assert(sizeof(ResponseHeader) == 24, "response header must be packed");
+
+struct EclipseRecord {
+    std::int32_t  eclipseType;   ///< 0 none, 1 total, 2 annular, 3 partial
+    std::uint32_t reserved;
+    double        shadow[3];     ///< shadow center (m)
+    double        umbraRadius;   ///< m
+    double        penumbraRadius;
+};
+static_assert(sizeof(EclipseRecord) == 48, "eclipse record must be packed");
+
+struct InfoRecord {
+    std::uint32_t bodyCount;
+    std::uint32_t degree;
+    double        startTime;     ///< s since epoch
+    double        endTime;
+    std::uint32_t epochBytes;    ///< epoch string follows the record
+    std::uint32_t reserved;
+};
+static_assert(sizeof(InfoRecord) == 32, "info record must be packed");
+
+} // namespace protocol
+
+#endif // ORBIT_SIM_EPHEMERIS_PROTOCOL_H
@@ -0,0 +1,44 @@
+/********************
+ * Author: Sinan Demir
+ * File: ephemeris_server.h
+ * Date: 10/16/2026
+ * Purpose:
+ *    Long-running query daemon (orbit-sim serve). Maps a Chebyshev
+ *    ephemeris once and answers batched position / velocity / eclipse
+ *    queries over a Unix domain socket (see ephemeris_protocol.h).
+ *
+ *    One epoll thread owns every socket; decoded batches go to a worker
+ *    pool and finished responses come back through an eventfd. Linux only.
+ *********************/
+
+#ifndef ORBIT_SIM_EPHEMERIS_SERVER_H
+#define ORBIT_SIM_EPHEMERIS_SERVER_H
+
+#include "chebyshev_ephemeris.h"
+
+#include <string>
+
+/********************
+ * ServeOptions
+ * @brief: Options for the query daemon.
+ *
+ *  - inputPath  : Chebyshev ephemeris (.oeph) or binary trajectory
+ *                 (.otraj, fitted in memory at startup with `fit`)
+ *  - socketPath : Unix socket to listen on (replaced if stale)
+ *  - threads    : worker threads (0 = hardware concurrency)
+ *********************/
+struct ServeOptions {
+    std::string         inputPath;
+    std::string         socketPath = "/tmp/orbit-sim.sock";
+    unsigned            threads    = 0;
+    ChebyshevFitOptions fit;
+};
+
+/********************
+ * runEphemerisServer
+ * @brief: Serves until SIGINT/SIGTERM, then removes the socket.
+ * @return true on clean shutdown, false if startup failed
+ *********************/
+bool runEphemerisServer(const ServeOptions& opts);
+
+#endif // ORBIT_SIM_EPHEMERIS_SERVER_H
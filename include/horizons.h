@@ -5,13 +5,17 @@
  * Purpose:
  *    Thin wrapper around NASA/JPL HORIZONS File API using libcurl.
  *    Fetches raw ephemeris output (as text inside JSON "result")
- *    and saves it to a local file for further processing.
+ *    and returns it or saves it to a local file for further processing
+ *    (see horizons_parser.h for turning it into bodies).
  *********************/
 
 #ifndef ORBIT_SIM_HORIZONS_H
 #define ORBIT_SIM_HORIZONS_H
 
 #include <string>
+#include <vector>
+
+class HorizonsCache;
 
 /********************
  * HorizonsFetchOptions
@@ -29,6 +33,35 @@ struct HorizonsFetchOptions {
     std::string step_size;   ///< e.g. "1 d", "1 h"
 };
 
+/********************
+ * horizonsTime
+ * @brief: Time string as sent to HORIZONS: a bare date gets " 00:00"
+ *         appended, anything with a time of day is passed through.
+ *********************/
+std::string horizonsTime(const std::string& s);
+
+/********************
+ * horizonsEndpoint
+ * @brief: URL a request goes to.
+ * @param usePost  - true = POST API, false = GET File API
+ * @param endpoint - base URL override (empty = NASA endpoint)
+ *********************/
+std::string horizonsEndpoint(bool usePost, const std::string& endpoint);
+
+/********************
+ * fetchHorizonsText
+ * @brief: Calls HORIZONS and returns the ephemeris text (JSON "result").
+ * @param opts    - HORIZONS request options
+ * @param text    - receives the ephemeris text
+ * @param usePost - true = POST API, false = GET File API
+ * @param verbose - Enable verbose output
+ * @return true on success, false on failure
+ *********************/
+bool fetchHorizonsText(const HorizonsFetchOptions& opts,
+                       std::string& text,
+                       bool usePost,
+                       bool verbose);
+
 /********************
  * fetchHorizonsEphemeris
  * @brief: Calls the HORIZONS File API and writes raw ephemeris to a file.
@@ -44,4 +77,77 @@ bool fetchHorizonsEphemerisPOST(const HorizonsFetchOptions& opts,
                                 const std::string& outputPath,
                                 bool verbose);
 
+/********************
+ * HorizonsReply
+ * @brief: Outcome of one transport request.
+ *********************/
+struct HorizonsReply {
+    bool        ok = false;    ///< true on HTTP 200
+    long        httpCode = 0;
+    std::string body;          ///< raw reply (API JSON)
+    std::string error;         ///< transport/HTTP error when !ok
+};
+
+/********************
+ * class HorizonsTransport
+ * @brief: Pluggable way of executing HORIZONS requests. The default is
+ *         CurlMultiTransport; tests or tools can substitute their own
+ *         (e.g. canned replies) or point curl at a local stub server.
+ *********************/
+class HorizonsTransport {
+public:
+    virtual ~HorizonsTransport() = default;
+
+    /// Executes all requests (possibly concurrently); result i answers request i.
+    virtual std::vector<HorizonsReply> fetchAll(const std::vector<HorizonsFetchOptions>& requests) = 0;
+
+    /// Where replies come from, e.g. "POST https://ssd.jpl.nasa.gov/api/horizons.api".
+    /// Part of the cache key, so replies from a stub server or another
+    /// API never answer requests sent elsewhere.
+    virtual std::string source() const = 0;
+};
+
+/********************
+ * CurlTransportOptions
+ * @brief: Settings for CurlMultiTransport.
+ *********************/
+struct CurlTransportOptions {
+    std::string endpoint;          ///< base URL override, e.g. http://127.0.0.1:8000/api (empty = NASA)
+    bool        usePost = false;   ///< POST API instead of GET File API
+    int         maxConnections = 4;
+    long        timeoutSeconds = 120;
+    bool        verbose = false;
+};
+
+/********************
+ * class CurlMultiTransport
+ * @brief: Runs every request concurrently on one curl_multi handle with a
+ *         shared connection cache.
+ *********************/
+class CurlMultiTransport : public HorizonsTransport {
+public:
+    explicit CurlMultiTransport(const CurlTransportOptions& options = CurlTransportOptions{});
+    std::vector<HorizonsReply> fetchAll(const std::vector<HorizonsFetchOptions>& requests) override;
+    std::string source() const override;
+
+private:
+    CurlTransportOptions opt;
+};
+
+/********************
+ * fetchHorizonsBatch
+ * @brief: Fetches several ephemerides, serving repeats from the cache.
+ *         Only replies carrying a $$SOE/$$EOE block are cached; HORIZONS
+ *         in-band errors (unknown or ambiguous target, bad dates) fail.
+ * @param requests  - one request per body
+ * @param transport - executes the requests not found in the cache
+ * @param cache     - optional on-disk cache (nullptr = always fetch)
+ * @param texts     - receives the ephemeris text of each request
+ * @return true if every request produced an ephemeris
+ *********************/
+bool fetchHorizonsBatch(const std::vector<HorizonsFetchOptions>& requests,
+                        HorizonsTransport& transport,
+                        const HorizonsCache* cache,
+                        std::vector<std::string>& texts);
+
 #endif // ORBIT_SIM_HORIZONS_H
@@ -0,0 +1,61 @@
+/********************
+ * Author: Sinan Demir
+ * File: horizons_cache.h
+ * Date: 10/16/2026
+ * Purpose:
+ *    On-disk cache of HORIZONS ephemeris texts.
+ *
+ *    Entries are addressed by a 64-bit FNV-1a hash of the request as it
+ *    goes on the wire (transport source = method + endpoint, body, center,
+ *    start and stop as sent, step) and stored as <dir>/<hash>.txt. The
+ *    first line of each entry repeats the full request key, so a hash
+ *    collision is detected and treated as a miss. Only texts with a
+ *    $$SOE/$$EOE block are stored or served.
+ *********************/
+
+#ifndef ORBIT_SIM_HORIZONS_CACHE_H
+#define ORBIT_SIM_HORIZONS_CACHE_H
+
+#include "horizons.h"
+
+#include <cstdint>
+#include <string>
+
+/********************
+ * class HorizonsCache
+ * @brief: Load/store ephemeris texts keyed on the request parameters.
+ *********************/
+class HorizonsCache {
+public:
+    /// @param dir - cache directory (created on first store)
+    explicit HorizonsCache(std::string dir);
+
+    /// @return Default directory: $XDG_CACHE_HOME/orbit-sim/horizons,
+    ///         ~/.cache/orbit-sim/horizons, or ./.horizons_cache.
+    static std::string defaultDirectory();
+
+    /// @param source - HorizonsTransport::source() of the transport used
+    /// @return Canonical request key, e.g.
+    ///   "GET https://ssd-api.jpl.nasa.gov/horizons_file.api|399|@0|2025-01-01 00:00|2025-01-02 00:00|1 d".
+    static std::string requestKey(const std::string& source, const HorizonsFetchOptions& opts);
+
+    /// @return FNV-1a 64-bit hash of requestKey().
+    static std::uint64_t hash(const std::string& source, const HorizonsFetchOptions& opts);
+
+    /// @return Path of the entry for a request.
+    std::string pathFor(const std::string& source, const HorizonsFetchOptions& opts) const;
+
+    /// @return true and the cached text on a hit.
+    bool load(const std::string& source, const HorizonsFetchOptions& opts, std::string& text) const;
+
+    /// @return true if the entry was written (atomically, via rename);
+    ///         false without writing if text has no $$SOE/$$EOE block.
+    bool store(const std::string& source, const HorizonsFetchOptions& opts, const std::string& text) const;
+
+    const std::string& directory() const { return dir; }
+
+private:
+    std::string dir;
+};
+
+#endif // ORBIT_SIM_HORIZONS_CACHE_H
@@ -0,0 +1,119 @@
+/********************
+ * Author: Sinan Demir
+ * File: horizons_parser.h
+ * Date: 10/16/2026
+ * Purpose:
+ *    Parser for NASA/JPL HORIZONS VECTORS ephemerides (the text inside the
+ *    API's JSON "result", or the file written by `orbit-sim fetch`).
+ *
+ *    Handles:
+ *      - labelled tables ("X = ... Y = ... Z = ...", VEC_TABLE 2 or 3)
+ *      - CSV tables (CSV_FORMAT=YES)
+ *      - output units KM-S, KM-D and AU-D (converted to m and m/s)
+ *      - target/center names and the body's GM from the header
+ *
+ *    The text is scanned in place through std::string_view; the only
+ *    allocations are the output strings and the state vector.
+ *********************/
+
+#ifndef ORBIT_SIM_HORIZONS_PARSER_H
+#define ORBIT_SIM_HORIZONS_PARSER_H
+
+#include "body.h"
+#include "json_loader.h"   // SystemMetadata
+#include "vec3.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/********************
+ * struct HorizonsState
+ * @brief: One row of a VECTORS table, in SI units.
+ *********************/
+struct HorizonsState {
+    double      jdTDB = 0.0;   ///< Julian date (TDB)
+    std::string calendar;      ///< e.g. "2025-Jan-01 00:00:00.0000 TDB"
+    vec3        position;      ///< m
+    vec3        velocity;      ///< m/s
+};
+
+/********************
+ * struct HorizonsEphemeris
+ * @brief: Parsed VECTORS ephemeris of one target.
+ *********************/
+struct HorizonsEphemeris {
+    std::string targetName;    ///< e.g. "Earth"
+    std::string targetId;      ///< e.g. "399" (empty if not printed)
+    std::string centerName;    ///< e.g. "Solar System Barycenter"
+    std::string centerId;      ///< e.g. "0"
+    double      gm = 0.0;      ///< m^3/s^2 from the header, 0 if absent
+    std::vector<HorizonsState> states;
+};
+
+/********************
+ * extractHorizonsResult
+ * @brief: Returns the ephemeris text of a HORIZONS reply. Raw API JSON
+ *         ({"result": ...}) is unwrapped; plain text (a file saved by
+ *         `orbit-sim fetch`) is returned as is unless requireJson is set.
+ * @param reply - reply body or file contents
+ * @param requireJson - true for live API replies, which are always JSON;
+ *                      anything else (proxy/HTML error page) is rejected
+ * @exception: runtime_error if the JSON reply carries "error" or lacks
+ *             "result", or requireJson is set and the reply is not JSON
+ *********************/
+std::string extractHorizonsResult(const std::string& reply, bool requireJson = false);
+
+/********************
+ * hasVectorsTable
+ * @brief: Cheap pre-check: true if the text has a $$SOE ... $$EOE block.
+ *         HORIZONS reports in-band errors (unknown or ambiguous target,
+ *         bad dates) as a "result" without one.
+ *********************/
+bool hasVectorsTable(std::string_view text);
+
+/********************
+ * parseHorizonsVectors
+ * @brief: Parses the $$SOE ... $$EOE block and the relevant header lines.
+ * @param text - ephemeris text
+ * @return HorizonsEphemeris with at least one state
+ * @exception: runtime_error if there is no $$SOE/$$EOE block, a record is
+ *             incomplete, or the output units are not supported
+ *********************/
+HorizonsEphemeris parseHorizonsVectors(std::string_view text);
+
+/********************
+ * naifFallbackMass
+ * @brief: Mass (kg) of common NAIF IDs for ephemerides whose header
+ *         carries no GM (e.g. planet barycenters).
+ * @return mass in kg, or 0 if the ID is unknown
+ *********************/
+double naifFallbackMass(const std::string& naifId);
+
+/********************
+ * assembleHorizonsSystem
+ * @brief: Builds initial conditions from several ephemerides sampled at
+ *         the same epoch (first row of each).
+ * @param ephems - one parsed ephemeris per body
+ * @param meta - receives the epoch and a descriptive name
+ * @return bodies in input order; mass from GM, else naifFallbackMass()
+ * @exception: runtime_error if epochs or centers differ, or a mass is
+ *             unknown
+ *********************/
+std::vector<CelestialBody> assembleHorizonsSystem(const std::vector<HorizonsEphemeris>& ephems,
+                                                  SystemMetadata& meta);
+
+/********************
+ * calendarToJD
+ * @brief: Converts an epoch string to a Julian date. Accepts the formats
+ *         found in system files and HORIZONS output:
+ *           "2025-01-01", "2025-01-01 12:00[:00]", "2025-01-01T12:00:00",
+ *           "2025-Jan-01 00:00:00.0000 TDB", "A.D. 2025-Jan-01 ...",
+ *           "2460676.5", "JD 2460676.5"
+ *         A trailing time-scale tag (TDB/TT/UTC/UT) is accepted but not
+ *         converted; HORIZONS VECTORS epochs are TDB.
+ * @return false if the text is not a recognised epoch
+ *********************/
+bool calendarToJD(std::string_view text, double& jd);
+
+#endif // ORBIT_SIM_HORIZONS_PARSER_H
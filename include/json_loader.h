@@ -12,6 +12,32 @@
 #include <vector>
 #include "body.h"   // CelestialBody
 
-std::vector<CelestialBody> loadSystemFromJSON(const std::string& path);
+/***********************
+ * struct SystemMetadata
+ * @brief: Optional top-level descriptors of a system file.
+ ***********************/
+struct SystemMetadata {
+    std::string name;    ///< "name"  (e.g. "Sun-Earth-Moon (simple)")
+    std::string epoch;   ///< "epoch" (e.g. "2025-01-01 00:00:00 TDB")
+};
+
+/***********************
+ * loadSystemFromJSON
+ * @brief: Loads bodies from a JSON system file.
+ * @param path - JSON file
+ * @param meta - if non-null, receives top-level "name"/"epoch" (empty when absent)
+ * @exception: runtime_error / json exceptions on I/O or schema errors
+ ***********************/
+std::vector<CelestialBody> loadSystemFromJSON(const std::string& path,
+                                              SystemMetadata* meta = nullptr);
+
+/***********************
+ * writeSystemJSON
+ * @brief: Writes bodies (and name/epoch, if set) in the loader's schema.
+ * @return true on success, false on I/O failure
+ ***********************/
+bool writeSystemJSON(const std::string& path,
+                     const std::vector<CelestialBody>& bodies,
+                     const SystemMetadata& meta);
 
 #endif // ORBIT_SIM_JSON_LOADER_H
@@ -0,0 +1,113 @@
+/********************
+ * Author: Sinan Demir
+ * File: kernels.h
+ * Date: 10/16/2026
+ * Purpose:
+ *    Hot physics kernels (pairwise gravity, RK4 stage updates, conservation
+ *    sums) compiled for several ISA levels and selected once at startup:
+ *
+ *      sse2    baseline x86-64 build (named "generic" on other CPUs)
+ *      avx2    -mavx2 -mfma
+ *      avx512  -mavx512f -mavx512dq -mavx512vl, 512-bit vectors
+ *
+ *    The best level the CPU reports (cpuid) wins unless ORBIT_ISA names
+ *    another one (ORBIT_ISA=avx2 for A/B runs; "auto" or unset = best).
+ *    Backends agree to rounding, not bit for bit: wider lanes regroup the
+ *    sums and avx2/avx512 contract multiply-adds into FMA.
+ *
+ *    Kernels work on flat state blocks [x | y | z | vx | vy | vz], each N
+ *    doubles long, so the RK4 derivative of a state is
+ *    [vx | vy | vz | ax | ay | az] and a stage update is one axpy.
+ *
+ *    For FIXED_MIN_N <= N <= FIXED_MAX_N each backend also has a stepper
+ *    specialized on N: stage buffers are fixed-size stack arrays and the
+ *    i < j pair triangle is unrolled row by row at compile time, leaving
+ *    only constant-length (fully vectorized) loops over j.
+ *********************/
+
+#ifndef ORBIT_SIM_KERNELS_H
+#define ORBIT_SIM_KERNELS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct CelestialBody;
+
+namespace kernels {
+
+/// Body counts with compile-time specialized steppers.
+constexpr std::size_t FIXED_MIN_N = 2;
+constexpr std::size_t FIXED_MAX_N = 16;
+
+/********************
+ * struct ConservationSums
+ * @brief: Raw sums behind physics::Conservations (SI units).
+ * @note: Plain aggregate on purpose (no member initializers), so the ISA
+ *        translation units never instantiate an inline constructor.
+ *********************/
+struct ConservationSums {
+    double kinetic;
+    double potential;
+    double P[3];
+    double L[3];
+};
+
+/********************
+ * struct Backend
+ * @brief: One ISA build of the kernels.
+ *
+ *  - accelerations : acc[0..3N) = pairwise gravity from pos[0..3N) (i < j,
+ *                    Newton's 3rd law; pairs closer than 1 m are skipped)
+ *  - axpy          : out[k] = y[k] + h * d[k] for k < len
+ *  - rk4Combine    : y[k] += h6 * (k1 + 2 k2 + 2 k3 + k4)[k] for k < len
+ *  - conservation  : energy and momentum sums of a 6N state
+ *  - fixedAccelerations : accelerations, specialized on N
+ *  - fixedRk4      : one full RK4 step of y in place, specialized on N;
+ *                    acc receives a(t) of the starting state
+ *    Both fixed entries return false (and do nothing) outside
+ *    [FIXED_MIN_N, FIXED_MAX_N].
+ *********************/
+struct Backend {
+    const char* name;
+
+    void (*accelerations)(const double* pos, const double* mass, std::size_t n, double* acc);
+    void (*axpy)(double* out, const double* y, const double* d, double h, std::size_t len);
+    void (*rk4Combine)(double* y, const double* k1, const double* k2, const double* k3,
+                       const double* k4, double h6, std::size_t len);
+    ConservationSums (*conservation)(const double* state, const double* mass, std::size_t n);
+
+    bool (*fixedAccelerations)(const double* pos, const double* mass, std::size_t n, double* acc);
+    bool (*fixedRk4)(double* y, const double* mass, std::size_t n, double dt, double* acc);
+};
+
+/// @return the backend chosen at first use (cpuid, then ORBIT_ISA).
+const Backend& active();
+
+/********************
+ * describe
+ * @brief: One-line summary for logs, e.g.
+ *         "avx2 (cpu: avx512, ORBIT_ISA=avx2)".
+ *********************/
+std::string describe();
+
+/********************
+ * packState
+ * @brief: Copies positions and velocities into a 6N state block and the
+ *         masses into mass[0..N). Both vectors are resized as needed.
+ *********************/
+void packState(const std::vector<CelestialBody>& bodies,
+               std::vector<double>& state,
+               std::vector<double>& mass);
+
+namespace detail {
+
+// One per ISA translation unit (kernels_<isa>.cpp)
+const Backend& baselineBackend();
+const Backend& avx2Backend();
+const Backend& avx512Backend();
+
+} // namespace detail
+} // namespace kernels
+
+#endif // ORBIT_SIM_KERNELS_H
@@ -0,0 +1,354 @@
+/********************
+ * Author: Sinan Demir
+ * File: kernels_impl.h
+ * Date: 10/16/2026
+ * Purpose:
+ *    Kernel bodies shared by the per-ISA translation units
+ *    (src/core/kernels_<isa>.cpp). Each of those includes this file once,
+ *    compiled with its own -m flags, and wraps the result in a Backend.
+ *
+ *    Everything here has internal linkage and calls nothing but std::sqrt:
+ *    an inline function shared with baseline code could be emitted with
+ *    AVX-512 instructions and picked by the linker for every caller.
+ *
+ *    Reductions use `omp simd` (-fopenmp-simd, no runtime) so the compiler
+ *    may split them across lanes without -ffast-math.
+ *
+ *    The fixed-N steppers keep their state in plain stack arrays rather
+ *    than std::array for the same reason: std::array's members are inline
+ *    templates shared with the rest of the program. Their profiling zones
+ *    go through KernelZone (below), not the inline profiling::detail::Scope.
+ *********************/
+
+#ifndef ORBIT_SIM_KERNELS_IMPL_H
+#define ORBIT_SIM_KERNELS_IMPL_H
+
+#include "kernels.h"
+#include "profiler.h"
+#include "utils.h"
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+namespace {
+
+#if ORBIT_ENABLE_PROFILING
+/********************
+ * struct KernelZone
+ * @brief: ORBIT_PROFILE_SCOPE for kernel code: the timing itself runs in
+ *         profiler.cpp (baseline ISA); only the `active` test is inlined.
+ *********************/
+struct KernelZone {
+    explicit KernelZone(int zone)
+        : open(profiling::detail::active && profiling::detail::openScope(zone)) {}
+    ~KernelZone() {
+        if (open) profiling::detail::closeScope();
+    }
+    KernelZone(const KernelZone&)            = delete;
+    KernelZone& operator=(const KernelZone&) = delete;
+
+    bool open;
+};
+
+#define ORBIT_KERNEL_ZONE(name)                                                            \
+    static const int ORBIT_PROFILE_CAT(orbitZone_, __LINE__) =                             \
+        ::profiling::detail::registerZone(name);                                           \
+    KernelZone ORBIT_PROFILE_CAT(orbitScope_, __LINE__)(ORBIT_PROFILE_CAT(orbitZone_, __LINE__))
+#else
+#define ORBIT_KERNEL_ZONE(name) ((void)0)
+#endif
+
+/********************
+ * accelerationsKernel
+ * @brief: Pairwise gravity over i < j; a_i and a_j get equal and opposite
+ *         contributions (same math as computeGravitationalForce).
+ *********************/
+void accelerationsKernel(const double* __restrict pos,
+                         const double* __restrict mass,
+                         std::size_t n,
+                         double* __restrict acc) {
+    const double G = physics::constants::G;
+
+    const double* __restrict x = pos;
+    const double* __restrict y = pos + n;
+    const double* __restrict z = pos + 2 * n;
+    double* __restrict ax = acc;
+    double* __restrict ay = acc + n;
+    double* __restrict az = acc + 2 * n;
+
+    for (std::size_t k = 0; k < 3 * n; ++k) acc[k] = 0.0;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const double xi = x[i], yi = y[i], zi = z[i];
+        const double Gmi = G * mass[i];
+        double sx = 0.0, sy = 0.0, sz = 0.0;
+
+#pragma omp simd reduction(+:sx, sy, sz)
+        for (std::size_t j = i + 1; j < n; ++j) {
+            const double dx = x[j] - xi;
+            const double dy = y[j] - yi;
+            const double dz = z[j] - zi;
+            const double r2 = dx*dx + dy*dy + dz*dz;
+
+            const double r     = std::sqrt(r2);
+            const double invr3 = (1.0 / r) / r2;
+            // Close-approach guard as a select, so the loop stays branch-free
+            const double w     = r2 < 1.0 ? 0.0 : invr3;
+
+            const double si = G * mass[j] * w;
+            sx += si * dx;
+            sy += si * dy;
+            sz += si * dz;
+
+            const double sj = Gmi * w;
+            ax[j] -= sj * dx;
+            ay[j] -= sj * dy;
+            az[j] -= sj * dz;
+        }
+
+        ax[i] += sx;
+        ay[i] += sy;
+        az[i] += sz;
+    }
+}
+
+/// out = y + h * d over len doubles (one RK4 stage state).
+void axpyKernel(double* __restrict out,
+                const double* __restrict y,
+                const double* __restrict d,
+                double h,
+                std::size_t len) {
+#pragma omp simd
+    for (std::size_t k = 0; k < len; ++k) {
+        out[k] = y[k] + h * d[k];
+    }
+}
+
+/// y += h6 * (k1 + 2 k2 + 2 k3 + k4) over len doubles.
+void rk4CombineKernel(double* __restrict y,
+                      const double* __restrict k1,
+                      const double* __restrict k2,
+                      const double* __restrict k3,
+                      const double* __restrict k4,
+                      double h6,
+                      std::size_t len) {
+#pragma omp simd
+    for (std::size_t k = 0; k < len; ++k) {
+        y[k] += h6 * (k1[k] + 2.0*k2[k] + 2.0*k3[k] + k4[k]);
+    }
+}
+
+/********************
+ * conservationKernel
+ * @brief: Kinetic energy, linear and angular momentum (O(N)) and the
+ *         pairwise potential energy (O(N^2), coincident pairs skipped).
+ *********************/
+kernels::ConservationSums conservationKernel(const double* __restrict state,
+                                             const double* __restrict mass,
+                                             std::size_t n) {
+    const double G = physics::constants::G;
+
+    const double* __restrict x  = state;
+    const double* __restrict y  = state + n;
+    const double* __restrict z  = state + 2 * n;
+    const double* __restrict vx = state + 3 * n;
+    const double* __restrict vy = state + 4 * n;
+    const double* __restrict vz = state + 5 * n;
+
+    double ke = 0.0, px = 0.0, py = 0.0, pz = 0.0, lx = 0.0, ly = 0.0, lz = 0.0;
+
+#pragma omp simd reduction(+:ke, px, py, pz, lx, ly, lz)
+    for (std::size_t i = 0; i < n; ++i) {
+        const double m  = mass[i];
+        const double v2 = vx[i]*vx[i] + vy[i]*vy[i] + vz[i]*vz[i];
+        ke += 0.5 * m * v2;
+
+        // p = m v, L = r x p
+        const double pxi = m * vx[i], pyi = m * vy[i], pzi = m * vz[i];
+        px += pxi;
+        py += pyi;
+        pz += pzi;
+        lx += y[i]*pzi - z[i]*pyi;
+        ly += z[i]*pxi - x[i]*pzi;
+        lz += x[i]*pyi - y[i]*pxi;
+    }
+
+    double pe = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double xi = x[i], yi = y[i], zi = z[i];
+        const double Gmi = G * mass[i];
+        double s = 0.0;
+
+#pragma omp simd reduction(+:s)
+        for (std::size_t j = i + 1; j < n; ++j) {
+            const double dx = xi - x[j];
+            const double dy = yi - y[j];
+            const double dz = zi - z[j];
+            const double r  = std::sqrt(dx*dx + dy*dy + dz*dz);
+            const double t  = Gmi * mass[j] / r;
+            s += r == 0.0 ? 0.0 : t;
+        }
+        pe -= s;
+    }
+
+    kernels::ConservationSums c;
+    c.kinetic   = ke;
+    c.potential = pe;
+    c.P[0] = px; c.P[1] = py; c.P[2] = pz;
+    c.L[0] = lx; c.L[1] = ly; c.L[2] = lz;
+    return c;
+}
+
+/********************
+ * fixedRow
+ * @brief: Row I of the i < j pair triangle for a compile-time N: the
+ *         N-1-I pairs (I, j > I), same arithmetic and order as one outer
+ *         iteration of accelerationsKernel. The trip count is a constant,
+ *         so the loop vectorizes without a remainder.
+ * @note: No __restrict here: with every row inlined into one function,
+ *        GCC 12 (-O2 and up, 512-bit vectors) mis-vectorized a restrict-
+ *        qualified variant of these helpers.
+ *********************/
+template <std::size_t N, std::size_t I>
+inline void fixedRow(const double* pos, const double* Gm, double* acc) {
+    constexpr std::size_t L = N - 1 - I;
+
+    const double xi = pos[I], yi = pos[N + I], zi = pos[2 * N + I];
+    const double Gmi = Gm[I];
+    double sx = 0.0, sy = 0.0, sz = 0.0;
+
+#pragma omp simd reduction(+:sx, sy, sz)
+    for (std::size_t l = 0; l < L; ++l) {
+        const std::size_t j = I + 1 + l;
+
+        const double dx = pos[j]         - xi;
+        const double dy = pos[N + j]     - yi;
+        const double dz = pos[2 * N + j] - zi;
+        const double r2 = dx*dx + dy*dy + dz*dz;
+
+        const double r     = std::sqrt(r2);
+        const double invr3 = (1.0 / r) / r2;
+        const double w     = r2 < 1.0 ? 0.0 : invr3;
+
+        const double si = Gm[j] * w;
+        sx += si * dx;
+        sy += si * dy;
+        sz += si * dz;
+
+        const double sj = Gmi * w;
+        acc[j]         -= sj * dx;
+        acc[N + j]     -= sj * dy;
+        acc[2 * N + j] -= sj * dz;
+    }
+
+    acc[I]         += sx;
+    acc[N + I]     += sy;
+    acc[2 * N + I] += sz;
+}
+
+template <std::size_t N, std::size_t... I>
+inline void fixedRows(const double* pos, const double* Gm, double* acc,
+                      std::index_sequence<I...>) {
+    for (std::size_t k = 0; k < 3 * N; ++k) acc[k] = 0.0;
+    (fixedRow<N, I>(pos, Gm, acc), ...);
+}
+
+/// acc[0..3N) from pos[0..3N) (Gm = G * mass), every row unrolled.
+template <std::size_t N>
+void fixedForces(const double* pos, const double* Gm, double* acc) {
+    fixedRows<N>(pos, Gm, acc, std::make_index_sequence<N - 1>{});
+}
+
+template <std::size_t N>
+void fixedAccelerations(const double* pos, const double* mass, double* acc) {
+    double Gm[N];
+    for (std::size_t k = 0; k < N; ++k) Gm[k] = physics::constants::G * mass[k];
+    fixedForces<N>(pos, Gm, acc);
+}
+
+/********************
+ * fixedRk4
+ * @brief: One classical RK4 step on a 6N state with all stage buffers on
+ *         the stack; same stage arithmetic and profiling zones
+ *         (derivatives > forces, stage state, combine) as rk4Step's
+ *         generic path.
+ *********************/
+template <std::size_t N>
+void fixedRk4(double* __restrict y, const double* __restrict mass, double dt,
+              double* __restrict acc) {
+    constexpr std::size_t V = 3 * N;   // position (or velocity) block
+    constexpr std::size_t S = 6 * N;   // full state
+
+    double Gm[N];
+    for (std::size_t k = 0; k < N; ++k) Gm[k] = physics::constants::G * mass[k];
+
+    double k1[S], k2[S], k3[S], k4[S], s[S];
+
+    // One zone per phase, shared by the four stages (as in the generic path)
+    auto derive = [&Gm](const double* state, double* k) {
+        ORBIT_KERNEL_ZONE("derivatives");
+        for (std::size_t c = 0; c < V; ++c) k[c] = state[V + c];
+        ORBIT_KERNEL_ZONE("forces");
+        fixedForces<N>(state, Gm, k + V);
+    };
+    auto stage = [y, &s](const double* k, double h) {
+        ORBIT_KERNEL_ZONE("stage state");
+        for (std::size_t c = 0; c < S; ++c) s[c] = y[c] + h * k[c];
+    };
+
+    const double half = dt * 0.5;
+
+    derive(y, k1);
+    stage(k1, half);
+    derive(s, k2);
+    stage(k2, half);
+    derive(s, k3);
+    stage(k3, dt);
+    derive(s, k4);
+
+    ORBIT_KERNEL_ZONE("combine");
+    const double h6 = dt / 6.0;
+    for (std::size_t c = 0; c < S; ++c) {
+        y[c] += h6 * (k1[c] + 2.0*k2[c] + 2.0*k3[c] + k4[c]);
+    }
+    for (std::size_t c = 0; c < V; ++c) acc[c] = k1[V + c];
+}
+
+// N = FIXED_MIN_N .. FIXED_MAX_N
+#define ORBIT_FIXED_N_CASES(X) \
+    X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11) X(12) X(13) X(14) X(15) X(16)
+
+static_assert(kernels::FIXED_MIN_N == 2 && kernels::FIXED_MAX_N == 16,
+              "update ORBIT_FIXED_N_CASES");
+
+bool fixedAccelerationsKernel(const double* pos, const double* mass, std::size_t n, double* acc) {
+    switch (n) {
+#define ORBIT_FIXED_CASE(N) case N: fixedAccelerations<N>(pos, mass, acc); return true;
+    ORBIT_FIXED_N_CASES(ORBIT_FIXED_CASE)
+#undef ORBIT_FIXED_CASE
+    default: return false;
+    }
+}
+
+bool fixedRk4Kernel(double* y, const double* mass, std::size_t n, double dt, double* acc) {
+    switch (n) {
+#define ORBIT_FIXED_CASE(N) case N: fixedRk4<N>(y, mass, dt, acc); return true;
+    ORBIT_FIXED_N_CASES(ORBIT_FIXED_CASE)
+#undef ORBIT_FIXED_CASE
+    default: return false;
+    }
+}
+
+#undef ORBIT_FIXED_N_CASES
+
+/// Backend over the kernels above, tagged with the including TU's ISA.
+kernels::Backend makeBackend(const char* name) {
+    return kernels::Backend{name, accelerationsKernel, axpyKernel,
+                            rk4CombineKernel, conservationKernel,
+                            fixedAccelerationsKernel, fixedRk4Kernel};
+}
+
+} // namespace
+
+#endif // ORBIT_SIM_KERNELS_IMPL_H
@@ -16,10 +16,24 @@
 #include "cli.h"
 #include "json_loader.h"
 #include "horizons.h"
+#include "horizons_cache.h"
+#include "horizons_parser.h"
 #include "validate.h"
 #include "barycenter.h"
+#include "shadow_export.h"
+#include "system_snapshot.h"
+#include "trajectory_compare.h"
+#include "chebyshev_ephemeris.h"
+#include "ephemeris_client.h"
+#include "ephemeris_server.h"
+#include "profiler.h"
+#include "kernels.h"
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
 
 #endif //MAIN_H
\ No newline at end of file
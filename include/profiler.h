@@ -0,0 +1,139 @@
+/********************
+ * Author: Sinan Demir
+ * File: profiler.h
+ * Date: 10/16/2026
+ * Purpose:
+ *    Scoped phase timers for the simulation hot path.
+ *
+ *      void rk4Step(...) {
+ *          ORBIT_PROFILE_SCOPE("rk4Step");
+ *          ...
+ *      }
+ *
+ *    Each scope adds its elapsed ticks (RDTSC on x86, steady_clock
+ *    elsewhere) to a named zone; nested scopes give the zone's self time.
+ *    Zones cost one predictable branch while the profiler is stopped and
+ *    nothing at all when built with ORBIT_ENABLE_PROFILING=0.
+ *
+ *    Single-threaded: the integrator runs on one thread and so do the
+ *    zones. Scopes opened on other threads are ignored.
+ *********************/
+
+#ifndef ORBIT_SIM_PROFILER_H
+#define ORBIT_SIM_PROFILER_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+#ifndef ORBIT_ENABLE_PROFILING
+#define ORBIT_ENABLE_PROFILING 0
+#endif
+
+#if ORBIT_ENABLE_PROFILING && (defined(__x86_64__) || defined(__i386__))
+#define ORBIT_PROFILE_RDTSC 1
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace profiling {
+
+/// @return true if zones were compiled in (ORBIT_ENABLE_PROFILING).
+constexpr bool compiledIn() { return ORBIT_ENABLE_PROFILING != 0; }
+
+/********************
+ * start
+ * @brief: Clears all zones and starts recording.
+ * @param recordTrace - also keep one event per scope for writeChromeTrace
+ *                      (capped; see the report's "dropped" count)
+ *********************/
+void start(bool recordTrace = false);
+
+/// Stops recording; zones keep their totals until the next start().
+void stop();
+
+/********************
+ * report
+ * @brief: Prints one row per zone (calls, total, self, share of the
+ *         outermost zone), indented by nesting depth.
+ *********************/
+void report(std::ostream& os);
+
+/********************
+ * writeChromeTrace
+ * @brief: Writes the recorded events as Chrome trace-event JSON
+ *         (chrome://tracing, ui.perfetto.dev).
+ * @return false if no trace was recorded or the file cannot be written
+ *********************/
+bool writeChromeTrace(const std::string& path);
+
+namespace detail {
+
+extern bool active;   ///< true between start() and stop()
+
+/// Registers a zone name once (called from a function-local static);
+/// call sites with the same name get the same zone.
+int registerZone(const char* name);
+
+class Scope;
+
+/// Scope bookkeeping; only called while `active`. enter() returns false
+/// for scopes opened on a thread other than the one that called start().
+bool enter(Scope* scope);
+void leave(int zone, std::uint64_t begin, std::uint64_t end, std::uint64_t children);
+
+/// Out-of-line Scope for code built with other -m flags (kernels_impl.h),
+/// which must not instantiate the inline one. Strictly nested; open
+/// returns false off the profiling thread or when nested too deep.
+bool openScope(int zone);
+void closeScope();
+
+inline std::uint64_t ticks() {
+#ifdef ORBIT_PROFILE_RDTSC
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/********************
+ * class Scope
+ * @brief: RAII timer behind ORBIT_PROFILE_SCOPE.
+ *********************/
+class Scope {
+public:
+    explicit Scope(int zone) : zone(zone) {
+        if (active && enter(this)) begin = ticks();
+    }
+    ~Scope() {
+        if (begin != 0) leave(zone, begin, ticks(), children);
+    }
+    Scope(const Scope&)            = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    std::uint64_t children = 0;   ///< ticks spent in nested scopes
+
+private:
+    int           zone;
+    std::uint64_t begin = 0;
+};
+
+} // namespace detail
+} // namespace profiling
+
+#define ORBIT_PROFILE_CAT2(a, b) a##b
+#define ORBIT_PROFILE_CAT(a, b)  ORBIT_PROFILE_CAT2(a, b)
+
+#if ORBIT_ENABLE_PROFILING
+#define ORBIT_PROFILE_SCOPE(name)                                                          \
+    static const int ORBIT_PROFILE_CAT(orbitZone_, __LINE__) =                             \
+        ::profiling::detail::registerZone(name);                                           \
+    ::profiling::detail::Scope ORBIT_PROFILE_CAT(orbitScope_, __LINE__)(                   \
+        ORBIT_PROFILE_CAT(orbitZone_, __LINE__))
+#else
+#define ORBIT_PROFILE_SCOPE(name) ((void)0)
+#endif
+
+#endif // ORBIT_SIM_PROFILER_H
@@ -0,0 +1,46 @@
+/********************
+ * Author: Sinan Demir
+ * File: shadow_export.h
+ * Date: 10/16/2026
+ * Purpose:
+ *    Renders eclipse shadow maps for every frame of a trajectory and
+ *    writes them as an image sequence (orbit-sim shadow).
+ *********************/
+
+#ifndef ORBIT_SIM_SHADOW_EXPORT_H
+#define ORBIT_SIM_SHADOW_EXPORT_H
+
+#include "shadow_map.h"
+
+#include <string>
+
+/********************
+ * ShadowExportOptions
+ * @brief: Options for a shadow-map export run.
+ *
+ *  - inputPath : trajectory from `orbit-sim run` (needs Sun/Earth/Moon):
+ *                the .otraj (--trajectory), or a CSV with at least
+ *                10 significant digits per position
+ *  - outputDir : directory receiving shadow_<step>.<ext> files (CSV step,
+ *                or .otraj frame index with 0 = initial state)
+ *  - format    : "ppm" (shaded RGB), "pgm" (8-bit obscuration),
+ *                "pfm" (float obscuration)
+ *  - every     : render one frame every N trajectory frames
+ *********************/
+struct ShadowExportOptions {
+    std::string      inputPath;
+    std::string      outputDir;
+    std::string      format = "ppm";
+    int              every  = 1;
+    ShadowMapOptions map;
+};
+
+/********************
+ * exportShadowMaps
+ * @brief: Streams the trajectory, renders each selected frame and writes
+ *         it while the next frame renders.
+ * @return true on success, false on failure
+ *********************/
+bool exportShadowMaps(const ShadowExportOptions& opts);
+
+#endif // ORBIT_SIM_SHADOW_EXPORT_H
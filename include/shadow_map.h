@@ -0,0 +1,120 @@
+/****************
+ * File: shadow_map.h
+ * Author: Sinan Demir
+ * Date: 10/16/2026
+ *
+ * Purpose:
+ *    CPU ray tracer for the Moon's shadow on Earth's surface.
+ *
+ *    For every pixel of an equirectangular (lat/lon) map of Earth, a ray is
+ *    cast from the surface point toward the Sun and the fraction of the
+ *    limb-darkened solar disk hidden by the Moon is integrated analytically.
+ *    Work is split into bands of scanlines ("tiles") rendered on a pool.
+ *
+ *    Provides:
+ *      - ShadowMapOptions / ShadowMap structs
+ *      - ShadowMapRenderer class
+ *      - writeShadowPPM / writeShadowPGM / writeShadowPFM image writers
+ *
+ * Note:
+ *    Longitude/latitude are measured in the simulation's inertial frame
+ *    (lon 0 = +x, lat +90° = +z). Earth rotation is not modelled, so the
+ *    maps show where the shadow falls in space, not on a geographic grid.
+ *****************/
+
+#ifndef ORBIT_SIM_SHADOW_MAP_H
+#define ORBIT_SIM_SHADOW_MAP_H
+
+#include "vec3.h"
+#include "thread_pool.h"
+
+#include <string>
+#include <vector>
+
+/****************
+ * struct ShadowMapOptions
+ * Purpose: Resolution, tiling and limb-darkening settings.
+ *****************/
+struct ShadowMapOptions {
+    int      width         = 1920;  // map width  (pixels, longitude)
+    int      height        = 1080;  // map height (pixels, latitude)
+    int      tileRows      = 8;     // scanlines per work item
+    unsigned threads       = 0;     // 0 = hardware concurrency
+    double   limbDarkening = 0.6;   // linear limb-darkening coefficient u
+    int      limbRings     = 12;    // annuli used to integrate the solar disk
+};
+
+/****************
+ * struct ShadowMap
+ * Purpose: Per-pixel results of one rendered instant (row-major, top row =
+ *          north pole).
+ *****************/
+struct ShadowMap {
+    int width  = 0;
+    int height = 0;
+    std::vector<float> obscuration; // fraction of solar flux blocked by the Moon [0,1]
+    std::vector<float> irradiance;  // cos(zenith) * (1 - obscuration), 0 at night
+};
+
+/****************
+ * class ShadowMapRenderer
+ * Purpose: Owns the thread pool and per-row/column trig tables so that
+ *          rendering a frame is pure arithmetic.
+ *****************/
+class ShadowMapRenderer {
+public:
+    explicit ShadowMapRenderer(const ShadowMapOptions& options);
+
+    /****************
+     * render
+     * @brief: Ray-traces one instant into `out` (resized as needed).
+     * @param: S - Sun position (m)
+     * @param: E - Earth position (m)
+     * @param: M - Moon position (m)
+     * @param: out - destination map
+     * @exception: none
+     * @return: none
+     *****************/
+    void render(const vec3& S, const vec3& E, const vec3& M, ShadowMap& out);
+
+    const ShadowMapOptions& options() const { return opt; }
+
+private:
+    void renderRows(int y0, int y1,
+                    const vec3& S, const vec3& E, const vec3& M,
+                    bool shadowPossible, ShadowMap& out) const;
+
+    double obscuredFraction(double sunRadius, double moonRadius,
+                            double separation) const;
+
+    ShadowMapOptions    opt;
+    ThreadPool          pool;
+
+    std::vector<double> sinLat, cosLat;   // per row
+    std::vector<double> sinLon, cosLon;   // per column
+    std::vector<double> ringOuter;        // normalized outer radius of each annulus
+    std::vector<double> ringWeight;       // limb-darkened flux weight per unit area
+};
+
+/****************
+ * writeShadowPPM
+ * @brief: Writes a shaded RGB preview (day side lit, shadow darkened).
+ * @return: true on success
+ *****************/
+bool writeShadowPPM(const std::string& path, const ShadowMap& map);
+
+/****************
+ * writeShadowPGM
+ * @brief: Writes obscuration as 8-bit grayscale (255 = Sun fully hidden).
+ * @return: true on success
+ *****************/
+bool writeShadowPGM(const std::string& path, const ShadowMap& map);
+
+/****************
+ * writeShadowPFM
+ * @brief: Writes obscuration as a Portable Float Map (lossless float32).
+ * @return: true on success
+ *****************/
+bool writeShadowPFM(const std::string& path, const ShadowMap& map);
+
+#endif // ORBIT_SIM_SHADOW_MAP_H
@@ -12,19 +12,41 @@
 #include "utils.h"
 #include "conservations.h"
 #include "eclipse.h"
+#include "barycenter.h"
+#include "chebyshev_ephemeris.h"
+#include "progress.h"
 #include "vec3.h"
 #include <cmath>
+#include <string>
 #include <iostream>
 #include <fstream>  // for CSV output
 #include <vector>
 
+/***********************
+ * struct SimulationOptions
+ * @brief: Optional behaviour for runSimulation. Defaults reproduce the
+ *         plain RK4 run.
+ ***********************/
+struct SimulationOptions {
+    int recenterEvery = 0;       ///< Remove barycenter drift every K steps (0 = never)
+    std::string trajectoryPath;  ///< Also write a binary trajectory (positions + velocities)
+    std::string epoch;           ///< Calendar epoch of t = 0, stored in trajectory/ephemeris headers
+    std::string ephemerisPath;   ///< Also write a Chebyshev-compressed ephemeris
+    ChebyshevFitOptions ephemerisFit;
+    ProgressOptions progress;    ///< Console / status-file progress (off by default)
+};
+
 //void computeAcceleration(CelestialBody& earth, const CelestialBody& sun);
 void computeGravitationalForce(CelestialBody& a, CelestialBody& b);
 void eulerStep(CelestialBody& body, double dt);
+void resetAccelerations(std::vector<CelestialBody>& bodies);
+void updateAccelerations(std::vector<CelestialBody>& bodies);   // pairwise O(N^2) force pass
 void rk4Step(std::vector<CelestialBody>& bodies, double dt);
+void rk4StepGeneric(std::vector<CelestialBody>& bodies, double dt); // no fixed-N specialization
 void runSimulation(std::vector<CelestialBody>& bodies,
                    int steps,
                    double dt,
-                   const std::string& outputPath);
+                   const std::string& outputPath,
+                   const SimulationOptions& options = SimulationOptions{});
 
 #endif //SIMULATION_H
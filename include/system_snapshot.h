@@ -0,0 +1,129 @@
+/****************
+ * Author: Sinan Demir
+ * File: system_snapshot.h
+ * Date: 10/16/2026
+ * Purpose:
+ *    Versioned binary snapshot of an N-body system, designed to be
+ *    memory-mapped and read in place (no parsing at startup).
+ *
+ *    Layout (little-endian, every section 8-byte aligned):
+ *
+ *      offset  size  field
+ *      0       8     magic "ORBSNAP\0"
+ *      8       4     format version (SNAPSHOT_VERSION)
+ *      12      4     byte-order tag 0x01020304 (detects foreign endianness)
+ *      16      8     body count N
+ *      24      8     offset of masses    : N doubles (kg)
+ *      32      8     offset of states    : N x {x,y,z,vx,vy,vz} doubles (m, m/s)
+ *      40      8     offset of name index: N+1 uint64 offsets into the name blob
+ *      48      8     offset of name blob : concatenated UTF-8 body names
+ *      56      8     offset of metadata  : u64 len + system name, u64 len + epoch
+ *      64      8     total file size (truncation check)
+ *
+ *    Provides:
+ *      - writeSystemSnapshot  (bodies + metadata → file)
+ *      - SystemSnapshot       (read-only mmap view with zero-copy accessors)
+ *      - isSystemSnapshot / loadSystem (format-agnostic loading for the CLI)
+ *****************/
+
+#ifndef ORBIT_SIM_SYSTEM_SNAPSHOT_H
+#define ORBIT_SIM_SYSTEM_SNAPSHOT_H
+
+#include "body.h"
+#include "json_loader.h"   // SystemMetadata
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+constexpr std::uint32_t SNAPSHOT_VERSION = 1;
+
+/***********************
+ * writeSystemSnapshot
+ * @brief: Serializes bodies (name, mass, position, velocity) and metadata.
+ * @param path - destination file
+ * @param bodies - system to write
+ * @param meta - system name / epoch
+ * @return true on success, false on I/O failure
+ ***********************/
+bool writeSystemSnapshot(const std::string& path,
+                         const std::vector<CelestialBody>& bodies,
+                         const SystemMetadata& meta);
+
+/***********************
+ * class SystemSnapshot
+ * @brief: Maps a snapshot file read-only and exposes its arrays in place.
+ *         Pointers and views stay valid for the lifetime of the object.
+ ***********************/
+class SystemSnapshot {
+public:
+    /***********************
+     * SystemSnapshot (constructor)
+     * @param path - snapshot file
+     * @exception: runtime_error if the file cannot be mapped, is not a
+     *             snapshot, has an unsupported version or is truncated
+     ***********************/
+    explicit SystemSnapshot(const std::string& path);
+    ~SystemSnapshot();
+
+    SystemSnapshot(const SystemSnapshot&)            = delete;
+    SystemSnapshot& operator=(const SystemSnapshot&) = delete;
+
+    std::size_t   size()    const { return count; }
+    std::uint32_t version() const { return formatVersion; }
+
+    /// @return N masses (kg).
+    const double* masses() const { return massData; }
+
+    /// @return N states, 6 doubles each: x, y, z, vx, vy, vz.
+    const double* states() const { return stateData; }
+
+    /// @return Name of body i (view into the mapping).
+    std::string_view name(std::size_t i) const;
+
+    std::string_view systemName() const { return metaName; }
+    std::string_view epoch()      const { return metaEpoch; }
+
+    /***********************
+     * toBodies
+     * @brief: Copies the snapshot into mutable CelestialBody objects for
+     *         integration (accelerations zeroed).
+     ***********************/
+    std::vector<CelestialBody> toBodies() const;
+
+private:
+    void*          mapping   = nullptr;
+    std::size_t    mapSize   = 0;
+    std::vector<unsigned char> fallback;   ///< used where mmap is unavailable
+
+    std::uint32_t        formatVersion = 0;
+    std::size_t          count     = 0;
+    const double*        massData  = nullptr;
+    const double*        stateData = nullptr;
+    const std::uint64_t* nameIndex = nullptr;
+    const char*          nameBlob  = nullptr;
+    std::string_view     metaName;
+    std::string_view     metaEpoch;
+};
+
+/***********************
+ * isSystemSnapshot
+ * @brief: Checks the magic bytes at the start of a file.
+ * @return true if the file looks like a binary snapshot
+ ***********************/
+bool isSystemSnapshot(const std::string& path);
+
+/***********************
+ * loadSystem
+ * @brief: Loads a system from either a JSON file or a binary snapshot,
+ *         detected by content (not extension).
+ * @param path - system file
+ * @param meta - optional out-param for name / epoch
+ * @exception: propagates loader exceptions
+ ***********************/
+std::vector<CelestialBody> loadSystem(const std::string& path,
+                                      SystemMetadata* meta = nullptr);
+
+#endif // ORBIT_SIM_SYSTEM_SNAPSHOT_H
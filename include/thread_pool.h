@@ -0,0 +1,158 @@
+/****************
+ * Author: Sinan Demir
+ * File: thread_pool.h
+ * Date: 10/16/2026
+ * Purpose:
+ *    Small fixed-size worker pool used by the CPU renderers and loaders.
+ *
+ *    Provides:
+ *      - submit(fn)            → std::future of fn's result
+ *      - parallelFor(n, fn)    → runs fn(0..n-1) across all workers and
+ *                                the calling thread, blocking until done
+ *
+ * Note:
+ *    parallelFor hands out indices through an atomic counter, so uneven
+ *    work items (e.g. image tiles that hit the eclipse shadow) balance
+ *    themselves without a static partition.
+ *****************/
+
+#ifndef ORBIT_SIM_THREAD_POOL_H
+#define ORBIT_SIM_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/***********************
+ * class ThreadPool
+ * @brief: Fixed set of worker threads consuming a FIFO task queue.
+ ***********************/
+class ThreadPool {
+public:
+    /***********************
+     * ThreadPool (constructor)
+     * @brief: Starts `threads` workers (0 = hardware concurrency).
+     ***********************/
+    explicit ThreadPool(unsigned threads = 0) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    /***********************
+     * ~ThreadPool
+     * @brief: Drains the queue and joins all workers.
+     ***********************/
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto& t : workers) {
+            t.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// @return Number of worker threads.
+    std::size_t size() const { return workers.size(); }
+
+    /***********************
+     * submit
+     * @brief: Queues fn for execution on a worker.
+     * @return: future holding fn's result (or exception)
+     ***********************/
+    template <typename Fn>
+    auto submit(Fn&& fn) -> std::future<typename std::invoke_result<Fn>::type> {
+        using R = typename std::invoke_result<Fn>::type;
+
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<Fn>(fn));
+        std::future<R> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            tasks.emplace([task] { (*task)(); });
+        }
+        cv.notify_one();
+        return result;
+    }
+
+    /***********************
+     * parallelFor
+     * @brief: Calls fn(i) for every i in [0, count) using all workers plus
+     *         the calling thread. Blocks until every index has finished.
+     * @note: Exceptions thrown by fn are rethrown on the calling thread.
+     ***********************/
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn) {
+        if (count == 0) return;
+
+        std::atomic<std::size_t> next{0};
+        auto drain = [&] {
+            for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+                fn(i);
+            }
+        };
+
+        const std::size_t helpers = std::min(workers.size(), count - 1);
+        std::vector<std::future<void>> pending;
+        pending.reserve(helpers);
+        for (std::size_t h = 0; h < helpers; ++h) {
+            pending.push_back(submit(drain));
+        }
+
+        // Always join the helpers before unwinding: they reference locals.
+        std::exception_ptr error;
+        try {
+            drain();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        for (auto& f : pending) {
+            try {
+                f.get();
+            } catch (...) {
+                if (!error) error = std::current_exception();
+            }
+        }
+        if (error) std::rethrow_exception(error);
+    }
+
+private:
+    void workerLoop() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (stopping && tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread>          workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex                        mtx;
+    std::condition_variable           cv;
+    bool                              stopping = false;
+};
+
+#endif // ORBIT_SIM_THREAD_POOL_H
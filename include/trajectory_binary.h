@@ -0,0 +1,119 @@
+/****************
+ * Author: Sinan Demir
+ * File: trajectory_binary.h
+ * Date: 10/16/2026
+ * Purpose:
+ *    Binary trajectory format written by `orbit-sim run --trajectory`.
+ *    Unlike the CSV it stores full-precision positions AND velocities and
+ *    the simulation time of every frame, including the initial state.
+ *
+ *    Layout (little-endian):
+ *      header : "ORBTRAJ\0", u32 version, u32 N, f64 dt,
+ *               u64 len + epoch string, N x (u64 len + body name)
+ *      frames : f64 t (s since epoch), N x {x,y,z,vx,vy,vz} f64
+ *
+ *    The frame count is implicit (frames run to end of file), so the file
+ *    is valid to read while the simulation is still appending to it; a
+ *    trailing partial frame is ignored.
+ *****************/
+
+#ifndef ORBIT_SIM_TRAJECTORY_BINARY_H
+#define ORBIT_SIM_TRAJECTORY_BINARY_H
+
+#include "body.h"
+#include "vec3.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+constexpr std::uint32_t TRAJECTORY_VERSION = 1;
+
+/***********************
+ * struct TrajectoryFrame
+ * @brief: State of every body at one instant.
+ ***********************/
+struct TrajectoryFrame {
+    double t = 0.0;                 ///< seconds since the trajectory epoch
+    std::vector<vec3> positions;    ///< m, indexed like bodyNames()
+    std::vector<vec3> velocities;   ///< m/s (empty when the source has none)
+};
+
+/***********************
+ * class TrajectoryBinaryWriter
+ * @brief: Appends frames to a binary trajectory file.
+ ***********************/
+class TrajectoryBinaryWriter {
+public:
+    /***********************
+     * open
+     * @brief: Creates the file and writes the header.
+     * @param path   - output path
+     * @param bodies - body names (and count) for the header
+     * @param dt     - nominal step (s), informational
+     * @param epoch  - calendar epoch of t = 0 (may be empty)
+     * @return false if the file cannot be created
+     ***********************/
+    bool open(const std::string& path,
+              const std::vector<CelestialBody>& bodies,
+              double dt,
+              const std::string& epoch);
+
+    /// Appends one frame (positions and velocities of all bodies).
+    void write(double t, const std::vector<CelestialBody>& bodies);
+
+    bool good() const { return static_cast<bool>(out); }
+    void close() { out.close(); }
+
+private:
+    std::ofstream       out;
+    std::vector<double> buffer;   ///< reused frame buffer
+};
+
+/***********************
+ * class TrajectoryBinaryReader
+ * @brief: Streams frames from a binary trajectory file.
+ ***********************/
+class TrajectoryBinaryReader {
+public:
+    /***********************
+     * TrajectoryBinaryReader (constructor)
+     * @param path - trajectory file
+     * @exception: runtime_error if the file cannot be opened, is not a
+     *             trajectory, or has an unsupported version
+     ***********************/
+    explicit TrajectoryBinaryReader(const std::string& path);
+
+    const std::vector<std::string>& bodyNames() const { return names; }
+    const std::string& epoch() const { return epochText; }
+    double dt() const { return step; }
+
+    /// @return false at end of file (or at a trailing partial frame).
+    bool next(TrajectoryFrame& frame);
+
+    /// @return Byte offset of the next frame (for seek()).
+    std::streampos tell() { return in.tellg(); }
+
+    /// Resumes reading at an offset returned by tell(); clears EOF.
+    void seek(std::streampos pos) { in.clear(); in.seekg(pos); }
+
+    /// @return Size of one frame in bytes (frames follow the header back to back).
+    std::size_t frameBytes() const { return buffer.size() * sizeof(double); }
+
+private:
+    std::ifstream            in;
+    std::vector<std::string> names;
+    std::string              epochText;
+    double                   step = 0.0;
+    std::vector<double>      buffer;
+};
+
+/***********************
+ * isTrajectoryBinary
+ * @return true if the file starts with the binary trajectory magic.
+ ***********************/
+bool isTrajectoryBinary(const std::string& path);
+
+#endif // ORBIT_SIM_TRAJECTORY_BINARY_H
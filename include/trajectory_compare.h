@@ -0,0 +1,55 @@
+/********************
+ * Author: Sinan Demir
+ * File: trajectory_compare.h
+ * Date: 10/16/2026
+ * Purpose:
+ *    Compares a simulated trajectory against HORIZONS reference
+ *    ephemerides (orbit-sim compare).
+ *
+ *    The trajectory is streamed frame by frame and interpolated to every
+ *    reference epoch with a cubic Hermite spline, so memory stays
+ *    constant in the length of the run:
+ *      - binary trajectories (run --trajectory) carry velocities, which
+ *        are used directly as the Hermite tangents;
+ *      - CSV trajectories carry positions only; tangents come from
+ *        finite differences of neighbouring frames.
+ *********************/
+
+#ifndef ORBIT_SIM_TRAJECTORY_COMPARE_H
+#define ORBIT_SIM_TRAJECTORY_COMPARE_H
+
+#include <string>
+#include <vector>
+
+/********************
+ * CompareOptions
+ * @brief: Options for a trajectory comparison.
+ *
+ *  - referencePaths : HORIZONS VECTORS files (fetch output or raw API
+ *                     JSON); "Body=path" matches a file to a trajectory
+ *                     body explicitly, otherwise the target name is used
+ *  - trajectoryPath : binary trajectory or trajectory CSV
+ *  - dt             : step size (s), required for CSV input
+ *  - epoch          : epoch of t = 0 (calendar or JD); defaults to the
+ *                     epoch stored in a binary trajectory
+ *  - outputPath     : optional per-epoch error CSV
+ *  - tableRows      : sampled rows per body in the console table
+ *********************/
+struct CompareOptions {
+    std::vector<std::string> referencePaths;
+    std::string              trajectoryPath;
+    double                   dt = 0.0;
+    std::string              epoch;
+    std::string              outputPath;
+    int                      tableRows = 10;
+};
+
+/********************
+ * compareTrajectory
+ * @brief: Reports per-body position/velocity error against the references
+ *         and how fast it grows over the run.
+ * @return true on success, false on failure
+ *********************/
+bool compareTrajectory(const CompareOptions& opts);
+
+#endif // ORBIT_SIM_TRAJECTORY_COMPARE_H
@@ -0,0 +1,110 @@
+/****************
+ * Author: Sinan Demir
+ * File: trajectory_csv.h
+ * Date: 10/16/2026
+ * Purpose:
+ *    Streaming reader for the trajectory CSV written by runSimulation().
+ *
+ *    The CSV layout is:
+ *      step, x_<Body>, y_<Body>, z_<Body>, ..., E_total, KE, ...
+ *
+ *    Rows are parsed one at a time (no whole-file buffering), so tools that
+ *    post-process long runs keep constant memory.
+ *
+ *    loadTrajectoryCSV() is the whole-file counterpart for when everything
+ *    is needed in memory (the viewer): the file is mapped, split at row
+ *    boundaries across threads and parsed with std::from_chars straight
+ *    into preallocated per-body arrays.
+ *****************/
+
+#ifndef ORBIT_SIM_TRAJECTORY_CSV_H
+#define ORBIT_SIM_TRAJECTORY_CSV_H
+
+#include "vec3.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+/***********************
+ * struct TrajectoryCSVRow
+ * @brief: One parsed CSV row: step index and body positions (m).
+ ***********************/
+struct TrajectoryCSVRow {
+    long step = 0;
+    std::vector<vec3> positions;   ///< indexed like bodyNames()
+};
+
+/***********************
+ * class TrajectoryCSVReader
+ * @brief: Opens a trajectory CSV, maps x_/y_/z_ column triplets to body
+ *         names, and yields rows sequentially.
+ ***********************/
+class TrajectoryCSVReader {
+public:
+    /***********************
+     * TrajectoryCSVReader (constructor)
+     * @param path - CSV path
+     * @exception: throws runtime_error if the file cannot be opened or the
+     *             header has no x_* body columns
+     ***********************/
+    explicit TrajectoryCSVReader(const std::string& path);
+
+    /// @return Body names in column order.
+    const std::vector<std::string>& bodyNames() const { return names; }
+
+    /// @return Index of a body by name, or -1 if absent.
+    int bodyIndex(const std::string& name) const;
+
+    /***********************
+     * next
+     * @brief: Parses the next data row into `row`.
+     * @return false at end of file. Malformed rows are skipped.
+     ***********************/
+    bool next(TrajectoryCSVRow& row);
+
+    /// @return Byte offset of the next row (for seek()).
+    std::streampos tell() { return file.tellg(); }
+
+    /// Resumes reading at an offset returned by tell(); clears EOF.
+    void seek(std::streampos pos) { file.clear(); file.seekg(pos); }
+
+    /// Resumes reading at the first row starting at or after byte `pos`
+    /// (any offset past the header row, e.g. an estimate); clears EOF.
+    void syncTo(std::streampos pos);
+
+private:
+    std::ifstream            file;
+    std::string              line;
+    std::vector<std::string> names;
+    std::vector<int>         xCols;     ///< column index of x_<name>
+    std::size_t              columnCount = 0;
+    std::vector<double>      values;    ///< reused row buffer
+};
+
+/***********************
+ * struct TrajectoryCSVData
+ * @brief: A whole trajectory CSV in memory, one position array per body.
+ ***********************/
+struct TrajectoryCSVData {
+    std::vector<std::string>       names;
+    std::vector<long>              steps;       ///< step column per frame
+    std::vector<std::vector<vec3>> positions;   ///< [body][frame], m
+
+    std::size_t frames() const { return positions.empty() ? 0 : positions[0].size(); }
+};
+
+/***********************
+ * loadTrajectoryCSV
+ * @brief: Parallel whole-file load of a trajectory CSV.
+ * @param path    - CSV path
+ * @param threads - parser threads (0 = all hardware threads)
+ * @return body names and positions of every well-formed row, in order.
+ *         A row is well-formed if it has at least as many fields as the
+ *         header and the step and x_/y_/z_ fields are numbers; other
+ *         fields are not parsed.
+ * @exception: runtime_error as TrajectoryCSVReader
+ ***********************/
+TrajectoryCSVData loadTrajectoryCSV(const std::string& path, unsigned threads = 0);
+
+#endif // ORBIT_SIM_TRAJECTORY_CSV_H
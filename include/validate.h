@@ -9,16 +9,17 @@
 #define ORBIT_SIM_VALIDATE_H
 
 #include "json_loader.h"
+#include "system_snapshot.h"
 #include "body.h"
 #include <iostream>
 #include <stdexcept>
 #include <string>
 
 /**
- * @brief Validate a JSON system file.
- * Loads the system using loadSystemFromJSON() and prints summary.
+ * @brief Validate a system file (JSON or binary snapshot).
+ * Loads the system using loadSystem() and prints summary.
  *
- * @param path Path to JSON file
+ * @param path Path to JSON or snapshot file
  * @return true if valid, false if invalid
  */
 bool validateSystemFile(const std::string& path);
@@ -0,0 +1,58 @@
+/**********************
+ * body_culler.h
+ * @brief Frustum culling and level-of-detail selection for the bodies
+ * @author Sinan Demir
+ * @date 10/16/2026
+ *
+ * Every frame the bounding sphere of each body is tested against the
+ * view frustum (left, right, bottom, top and near planes; the projection
+ * has no far plane) and the visible ones are sorted into LOD_LEVELS
+ * lists by their radius on screen. The test runs over structure-of-
+ * arrays copies of the centers and radii in one branch-free `omp simd`
+ * loop, as the physics kernels do, so it vectorizes at any body count.
+ **********************/
+
+#ifndef BODY_CULLER_H
+#define BODY_CULLER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "viewer/body_instance.h"
+
+class BodyCuller {
+public:
+    /// Detail levels, 0 = coarsest.
+    static constexpr int LOD_LEVELS = 4;
+
+    /// Smallest radius on screen (pixels) drawn at each level.
+    static constexpr std::array<float, LOD_LEVELS> LOD_MIN_PIXELS = {0.0f, 4.0f, 16.0f, 96.0f};
+
+    /**
+     * @brief Culls `instances` (centers and radii) and selects their LOD.
+     * @param viewProj    projection * view, same space as the centers
+     * @param viewPos     camera position
+     * @param pixelAngle  view angle of one pixel (radians)
+     */
+    void cull(const std::vector<BodyInstance>& instances,
+              const glm::mat4& viewProj,
+              const glm::vec3& viewPos,
+              float pixelAngle);
+
+    /// Indices of the visible bodies drawn at `level`.
+    const std::vector<std::uint32_t>& level(int level) const { return levels[level]; }
+
+    std::size_t visible() const;
+
+private:
+    // Structure-of-arrays copies of the instances
+    std::vector<float> x, y, z, r;
+    std::vector<std::int8_t> codes;   ///< per body: LOD level, -1 = culled
+
+    std::array<std::vector<std::uint32_t>, LOD_LEVELS> levels;
+};
+
+#endif // BODY_CULLER_H
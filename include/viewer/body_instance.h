@@ -0,0 +1,36 @@
+/**********************
+ * body_instance.h
+ * @brief Per-body drawing attributes shared by the viewer renderers
+ * @author Sinan Demir
+ * @date 10/16/2026
+ **********************/
+
+#ifndef BODY_INSTANCE_H
+#define BODY_INSTANCE_H
+
+#include <algorithm>
+#include <glm/glm.hpp>
+
+/**
+ * @brief Per-instance attributes (locations 2..4 in the body shader).
+ */
+struct BodyInstance {
+    glm::vec3 center;  ///< position relative to the camera target (GL units)
+    float     radius;  ///< physical radius (GL units)
+    glm::vec3 color;   ///< linear RGB, may exceed 1 (Sun)
+};
+
+/// Smallest radius on screen (pixels) a body is drawn with: at true
+/// scale most bodies are far below a pixel when the whole system is in view.
+constexpr float MIN_BODY_PIXELS = 1.0f;
+
+/**
+ * @brief Radius to draw a body with at `distance` from the camera: its
+ *        own, or MIN_BODY_PIXELS on screen if that is larger.
+ * @param pixelAngle  view angle of one pixel (radians)
+ */
+inline float drawRadius(float radius, float distance, float pixelAngle) {
+    return std::max(radius, distance * pixelAngle * MIN_BODY_PIXELS);
+}
+
+#endif // BODY_INSTANCE_H
@@ -0,0 +1,137 @@
+/**********************
+ * body_renderer.h
+ * @brief Instanced sphere renderer for the orbit viewer
+ * @author Sinan Demir
+ * @date 10/16/2026
+ *
+ * All bodies share a few unit-sphere meshes of increasing tessellation
+ * (levels of detail). Each frame the bodies are frustum-culled on the CPU
+ * (BodyCuller), and the visible ones are drawn with one
+ * glDrawElementsInstanced call per level, so draw calls stay O(1) in
+ * body count. Per-body center, radius, color and index come from a
+ * streaming instance buffer that is re-specified (orphaned) each frame.
+ * It is sorted by level, and each level's draw points the instance
+ * attributes at its range (GL 3.3 has no base instance).
+ *
+ * Centers are camera-relative (the caller subtracts the camera target in
+ * double precision), so float holds them exactly enough at any zoom, and
+ * depth is logarithmic (see LOG_DEPTH_C).
+ *
+ * With a TrajectoryBuffer the centers are computed in the vertex shader
+ * instead: the high/low states of the two frames around the playback
+ * time are fetched by body index, made relative to the camera target
+ * half by half, and Hermite-interpolated. Culling still runs on the CPU
+ * (on the caller's centers), so only visible bodies are submitted.
+ **********************/
+
+#ifndef BODY_RENDERER_H
+#define BODY_RENDERER_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "viewer/body_culler.h"
+#include "viewer/body_instance.h"
+#include "viewer/sphere_mesh.h"
+#include "viewer/trajectory_buffer.h"
+
+class BodyRenderer {
+public:
+    BodyRenderer() = default;
+    ~BodyRenderer();
+
+    BodyRenderer(const BodyRenderer&)            = delete;
+    BodyRenderer& operator=(const BodyRenderer&) = delete;
+
+    /**
+     * @brief Compiles the body shader, builds the sphere meshes and the
+     *        instance buffer. Requires a current GL 3.3 context.
+     * @return false if the shader failed to compile or link
+     */
+    bool init();
+
+    /**
+     * @brief Culls `instances`, uploads the visible ones and draws them
+     *        (at least MIN_BODY_PIXELS in radius).
+     * @param viewProj    projection * view, camera-relative
+     * @param lightPos    light position (Sun), camera-relative
+     * @param viewPos     camera position, camera-relative
+     * @param pixelAngle  view angle of one pixel (radians), for the LOD
+     */
+    void draw(const std::vector<BodyInstance>& instances,
+              const glm::mat4& viewProj,
+              const glm::vec3& lightPos,
+              const glm::vec3& viewPos,
+              float pixelAngle);
+
+    /**
+     * @brief Draws the bodies of `traj`, centers interpolated between
+     *        `frame` and frame + 1 on the GPU.
+     * @param s          fraction of the frame interval in [0, 1]
+     * @param span       frame interval (s), scales the stored velocities
+     * @param origin     camera target, world space (GL units)
+     * @param instances  radius and color per body in trajectory order;
+     *                   the centers (same playback time, camera-relative,
+     *                   on the CPU) are used for culling only
+     * @param viewProj, lightPos, viewPos, pixelAngle  as for draw()
+     */
+    void drawTrajectory(TrajectoryBuffer& traj,
+                        std::size_t frame,
+                        float s,
+                        float span,
+                        const glm::dvec3& origin,
+                        const std::vector<BodyInstance>& instances,
+                        const glm::mat4& viewProj,
+                        const glm::vec3& lightPos,
+                        const glm::vec3& viewPos,
+                        float pixelAngle);
+
+private:
+    /// Instance buffer layout (attribute locations 2..5).
+    struct GpuInstance {
+        glm::vec3     center;
+        float         radius;
+        glm::vec3     color;
+        std::uint32_t body;    ///< index into the trajectory
+    };
+
+    bool cullAndUpload(const std::vector<BodyInstance>& instances,
+                       const glm::mat4& viewProj,
+                       const glm::vec3& viewPos,
+                       float pixelAngle);
+    void reserve(std::size_t instances);
+    void upload();
+    void drawLevels();
+    void setCommonUniforms(const glm::mat4& viewProj,
+                           const glm::vec3& lightPos,
+                           const glm::vec3& viewPos);
+
+    std::array<SphereMesh, BodyCuller::LOD_LEVELS> meshes;
+    BodyCuller  culler;
+    GLuint      program     = 0;
+    GLuint      instanceVBO = 0;
+    std::size_t capacity    = 0;   ///< instance slots in instanceVBO
+
+    std::vector<BodyInstance> sized;     ///< instances at their drawn radius
+    std::vector<GpuInstance>  staging;   ///< visible instances, by level
+
+    GLint locViewProj     = -1;
+    GLint locLight        = -1;
+    GLint locViewPos      = -1;
+    GLint locLogDepthC    = -1;
+    GLint locLogDepthScale = -1;
+    GLint locFromTraj     = -1;
+    GLint locTraj         = -1;
+    GLint locFrame        = -1;
+    GLint locNext         = -1;
+    GLint locFraction     = -1;
+    GLint locSpan         = -1;
+    GLint locBodies       = -1;
+    GLint locOriginHigh   = -1;
+    GLint locOriginLow    = -1;
+};
+
+#endif // BODY_RENDERER_H
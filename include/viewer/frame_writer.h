@@ -0,0 +1,73 @@
+/**********************
+ * frame_writer.h
+ * @brief Image sequence output for headless orbit-viewer runs
+ * @author Sinan Demir
+ * @date 10/16/2026
+ *
+ * Frames go either to stdout as raw RGB24 (for piping into ffmpeg) or
+ * into a directory as frame_000000.png, ... The PNGs are encoded on a
+ * pool of encoder threads while the next frames render; at most a few
+ * frames per encoder are in flight, so memory stays bounded.
+ *
+ * The tree has no zlib, so encodePNG carries its own deflate: greedy
+ * LZ77 with fixed Huffman codes. That is far from zlib's ratio on noisy
+ * images, but the viewer's mostly-black frames compress well.
+ **********************/
+
+#ifndef FRAME_WRITER_H
+#define FRAME_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "thread_pool.h"
+
+/**
+ * @brief Encodes a top-row-first RGB24 image as PNG.
+ */
+std::vector<std::uint8_t> encodePNG(int width, int height, const std::uint8_t* rgb);
+
+class FrameWriter {
+public:
+    /**
+     * @param target   "-" for raw RGB24 on stdout, else an output directory
+     * @param threads  encoder threads for PNG output (0 = hardware concurrency)
+     * @throws std::runtime_error if the directory cannot be created
+     */
+    FrameWriter(const std::string& target, int width, int height, unsigned threads = 0);
+    ~FrameWriter();
+
+    FrameWriter(const FrameWriter&)            = delete;
+    FrameWriter& operator=(const FrameWriter&) = delete;
+
+    /**
+     * @brief Queues the next frame (width * height * 3 bytes). May wait
+     *        for earlier frames to finish encoding.
+     * @return false once any write has failed
+     */
+    bool write(std::vector<std::uint8_t>&& rgb);
+
+    /// Waits for all queued frames. @return false if any write failed
+    bool finish();
+
+    std::size_t frames() const { return written; }
+
+private:
+    bool collect(std::size_t keep);
+
+    std::string directory;   ///< empty = stdout
+    int         w, h;
+    std::size_t written = 0;
+    bool        ok      = true;
+
+    ThreadPool                     pool;
+    std::size_t                    maxPending;
+    std::deque<std::future<bool>>  pending;
+};
+
+#endif // FRAME_WRITER_H
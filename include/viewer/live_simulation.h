@@ -0,0 +1,107 @@
+/**********************
+ * live_simulation.h
+ * @brief In-process simulation feeding the orbit viewer
+ * @author Sinan Demir
+ * @date 10/16/2026
+ *
+ * A producer thread integrates the system with rk4Step and publishes its
+ * latest state; the render loop picks up whatever is newest without
+ * waiting, so long runs can be watched as they are computed and nothing
+ * touches the disk.
+ *
+ * The handoff is a lock-free triple buffer: the producer fills a back
+ * slot and atomically swaps it with the shared middle slot; the viewer
+ * swaps the middle slot out only when it is newer. Neither side ever
+ * blocks the other and the viewer always sees a complete state.
+ *
+ * Each published state holds the last two steps (before and after the
+ * viewer's playback time) with velocities, for Hermite interpolation.
+ * The producer runs up to the time requested with advanceTo() and then
+ * idles, so playback speed and pause carry over to the integration; if
+ * it cannot keep up it simply runs flat out.
+ **********************/
+
+#ifndef LIVE_SIMULATION_H
+#define LIVE_SIMULATION_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "body.h"
+#include "trajectory_binary.h"   // TrajectoryFrame
+
+/**
+ * @brief Latest integration result: the step at or before the requested
+ *        time (`a`) and the one after it (`b`, == `a` before the first step).
+ */
+struct LiveState {
+    TrajectoryFrame a;
+    TrajectoryFrame b;
+    std::uint64_t   steps = 0;   ///< steps integrated so far
+};
+
+class LiveSimulation {
+public:
+    /**
+     * @brief Takes the initial system and starts the producer thread,
+     *        which publishes the initial state right away.
+     * @param dt  integration step (s)
+     */
+    LiveSimulation(std::vector<CelestialBody> bodies, double dt);
+    ~LiveSimulation();
+
+    LiveSimulation(const LiveSimulation&)            = delete;
+    LiveSimulation& operator=(const LiveSimulation&) = delete;
+
+    /// Lets the producer integrate until simulated time `t` (s).
+    void advanceTo(double t);
+
+    /**
+     * @brief Newest published state, if there is one the caller has not
+     *        seen yet. Never blocks.
+     * @return nullptr if nothing new was published since the last call;
+     *         otherwise valid until the next call
+     */
+    const LiveState* latest();
+
+    const std::vector<std::string>& bodyNames() const { return names; }
+    double dt() const { return step; }
+
+private:
+    void run();
+    void publish();
+
+    static constexpr std::uint8_t FRESH = 0x4;   ///< middle slot not yet consumed
+    static constexpr std::uint8_t INDEX = 0x3;
+
+    std::vector<CelestialBody> bodies;   ///< producer only
+    std::vector<std::string>   names;
+    double                     step = 0.0;
+
+    // Triple buffer: back (producer), middle (shared), front (consumer)
+    std::array<LiveState, 3>  slots;
+    std::atomic<std::uint8_t> middle{1};
+    std::uint8_t              back  = 0;
+    std::uint8_t              front = 2;
+
+    // Producer state between publishes
+    TrajectoryFrame previous;
+    TrajectoryFrame current;
+    std::uint64_t   steps = 0;
+
+    // Pacing: the producer idles once current.t reaches the horizon
+    std::atomic<double>     horizon{0.0};
+    std::atomic<bool>       stopping{false};
+    std::mutex              idleMtx;
+    std::condition_variable idleCv;
+
+    std::thread producer;
+};
+
+#endif // LIVE_SIMULATION_H
@@ -0,0 +1,69 @@
+/**********************
+ * playback_clock.h
+ * @brief Wall-clock driven playback time and Hermite interpolation
+ * @author Sinan Demir
+ * @date 10/16/2026
+ *
+ * Playback advances in simulated seconds at `speed` simulated seconds per
+ * wall second, independent of the display refresh rate. Positions between
+ * stored frames come from cubic Hermite interpolation of the bracketing
+ * positions and velocities, so sparse trajectories still move smoothly.
+ **********************/
+
+#ifndef PLAYBACK_CLOCK_H
+#define PLAYBACK_CLOCK_H
+
+#include <chrono>
+#include <glm/glm.hpp>
+
+class PlaybackClock {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @param speed  simulated seconds per wall second
+    explicit PlaybackClock(double speed = 1.0) : rate(speed) {}
+
+    /**
+     * @brief Advances by the wall time since the previous tick (times the
+     *        speed) unless paused.
+     * @return current simulated time (s)
+     */
+    double tick();
+
+    double time() const   { return t; }
+    void   seek(double simTime) { t = simTime; }
+
+    double speed() const  { return rate; }
+    void   setSpeed(double simSecondsPerWallSecond) { rate = simSecondsPerWallSecond; }
+
+    bool   paused() const { return isPaused; }
+    void   togglePause()  { isPaused = !isPaused; }
+
+private:
+    Clock::time_point last;
+    bool   started  = false;
+    bool   isPaused = false;
+    double t        = 0.0;
+    double rate     = 1.0;
+};
+
+/**
+ * @brief Cubic Hermite interpolation on one frame interval.
+ * @param p0,v0  position and velocity at the start of the interval
+ * @param p1,v1  position and velocity at the end
+ * @param span   interval length (s), scales the velocities
+ * @param s      fraction of the interval in [0, 1]
+ */
+inline glm::dvec3 hermite(const glm::dvec3& p0, const glm::dvec3& v0,
+                          const glm::dvec3& p1, const glm::dvec3& v1,
+                          double span, double s) {
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+    const double h00 =  2.0 * s3 - 3.0 * s2 + 1.0;
+    const double h10 =        s3 - 2.0 * s2 + s;
+    const double h01 = -2.0 * s3 + 3.0 * s2;
+    const double h11 =        s3 -       s2;
+    return h00 * p0 + (h10 * span) * v0 + h01 * p1 + (h11 * span) * v1;
+}
+
+#endif // PLAYBACK_CLOCK_H
@@ -0,0 +1,42 @@
+/**********************
+ * shader_utils.h
+ * @brief GLSL compile/link helpers shared by the viewer renderers
+ * @author Sinan Demir
+ * @date 10/16/2026
+ **********************/
+
+#ifndef SHADER_UTILS_H
+#define SHADER_UTILS_H
+
+#include <cmath>
+#include <glad/glad.h>
+
+/**
+ * Logarithmic depth, shared by the 3D shaders: a fragment at view
+ * distance w (GL units) gets depth log2(1 + C * w) / log2(1 + C * FAR).
+ * Precision is then relative to distance (about 1e-6 of it), so surfaces
+ * meters apart and planets AU apart both resolve in one depth buffer.
+ * Vertex shaders pass 1 + C * w to the fragment shader, which writes
+ * gl_FragDepth (uniforms uLogDepthC and uLogDepthScale).
+ */
+constexpr float LOG_DEPTH_C   = 1.0e6f;   ///< 1 / (5 km in GL units)
+constexpr float LOG_DEPTH_FAR = 1.0e9f;   ///< GL units, far beyond any orbit
+
+/// Value of uLogDepthScale: 1 / log2(1 + C * FAR).
+inline float logDepthScale() {
+    return 1.0f / std::log2(1.0f + LOG_DEPTH_C * LOG_DEPTH_FAR);
+}
+
+/**
+ * @brief Compiles a shader of given type from source code.
+ *        Errors are logged to stderr; the shader object is returned anyway.
+ */
+GLuint compileShader(GLenum type, const char* src);
+
+/**
+ * @brief Creates an OpenGL program from a vertex + fragment shader pair.
+ * @return program object, or 0 if linking failed (log printed to stderr)
+ */
+GLuint createProgram(const char* vsSrc, const char* fsSrc);
+
+#endif // SHADER_UTILS_H
@@ -0,0 +1,128 @@
+/**********************
+ * software_renderer.h
+ * @brief CPU renderer for headless orbit-viewer output
+ * @author Sinan Demir
+ * @date 10/16/2026
+ *
+ * Renders the viewer's scene without a GPU or window: every body is an
+ * analytic sphere, ray-cast per pixel (double precision) inside its
+ * projected bounding rectangle and shaded exactly like the body shader
+ * (ambient-boosted Lambert + Blinn-Phong + rim, gamma 2.2). Trails are
+ * 1-pixel lines, depth-tested against the bodies and alpha-blended; each
+ * segment is clipped to the near plane in camera space and to the image
+ * in pixels before it is stepped, so its cost is bounded by the image
+ * size however close to the camera it passes.
+ *
+ * The image is split into bands of scanlines rendered on a ThreadPool,
+ * as in the shadow-map ray tracer.
+ **********************/
+
+#ifndef SOFTWARE_RENDERER_H
+#define SOFTWARE_RENDERER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "thread_pool.h"
+#include "viewer/body_instance.h"
+
+/**
+ * @brief Camera of one headless frame (same model as the viewer:
+ *        lookAt with +y up, perspective with vertical field of view).
+ *        Bodies, camera and light are relative to `origin` (the viewer's
+ *        camera target); trails are in world space.
+ */
+struct SoftwareCamera {
+    glm::dvec3 origin{0.0};
+    glm::dvec3 position;
+    glm::dvec3 target;
+    double     fovY = 0.7853981633974483;   ///< 45 degrees
+};
+
+/**
+ * @brief Recent body positions for trails: one point per rendered frame,
+ *        a fixed ring of `points` per body.
+ */
+class SoftwareTrails {
+public:
+    SoftwareTrails(std::size_t bodies, std::size_t points);
+
+    void clear() { length = 0; }
+
+    /// Appends the current position of every body (world space, double).
+    void append(const std::vector<glm::dvec3>& centers);
+
+    std::size_t bodies() const   { return numBodies; }
+    std::size_t points() const   { return length; }
+    std::size_t capacity() const { return ring.size() / (numBodies ? numBodies : 1); }
+
+    /// @return point `age` frames ago (0 = newest) of body `b`.
+    const glm::dvec3& point(std::size_t b, std::size_t age) const {
+        const std::size_t cap = capacity();
+        return ring[((head + cap - age) % cap) * numBodies + b];
+    }
+
+private:
+    std::size_t            numBodies = 0;
+    std::vector<glm::dvec3> ring;   ///< frame-major: [slot * bodies + body]
+    std::size_t            head   = 0;
+    std::size_t            length = 0;
+};
+
+class SoftwareRenderer {
+public:
+    /// Scanlines per work item.
+    static constexpr int BAND_ROWS = 8;
+
+    /**
+     * @param threads  render threads (0 = hardware concurrency)
+     */
+    SoftwareRenderer(int width, int height, unsigned threads = 0);
+
+    /**
+     * @brief Renders one frame into `rgb` (width * height * 3 bytes,
+     *        top row first).
+     * @param trails    optional trails (colors from `bodies`)
+     * @param lightPos  light position (Sun), relative to camera.origin
+     */
+    void render(const std::vector<BodyInstance>& bodies,
+                const SoftwareTrails* trails,
+                const SoftwareCamera& camera,
+                const glm::vec3& lightPos,
+                std::vector<std::uint8_t>& rgb);
+
+    int width() const  { return w; }
+    int height() const { return h; }
+
+private:
+    struct Rect { int x0, y0, x1, y1; };   ///< pixel bounds, inclusive
+    /// Clipped trail segment: pixel coords and 1 / view depth per end
+    struct Segment {
+        float x0, y0, iz0, x1, y1, iz1;
+        std::uint32_t body;
+        float alpha;
+    };
+
+    void renderBand(int band,
+                    const std::vector<BodyInstance>& bodies,
+                    const SoftwareCamera& camera,
+                    const glm::vec3& lightPos);
+
+    int        w, h;
+    ThreadPool pool;
+
+    // Per frame
+    glm::dvec3 right, up, forward;
+    double     tanX = 0.0, tanY = 0.0;
+    std::vector<Rect>                       rects;      ///< per body (x0 > x1: off screen)
+    std::vector<glm::dvec3>                 viewPoints; ///< trail points in camera space, [age * bodies + body]
+    std::vector<Segment>                    segments;
+    std::vector<std::vector<std::uint32_t>> bandSegments;
+
+    std::vector<glm::vec3> color;   ///< display-space RGB
+    std::vector<float>     depth;   ///< view depth, +inf = empty
+};
+
+#endif // SOFTWARE_RENDERER_H
@@ -14,6 +14,13 @@ public:
 
     void draw() const;
 
+    /// Draws `instances` copies in one call (per-instance attributes must
+    /// already be attached to vertexArray()).
+    void drawInstanced(GLsizei instances) const;
+
+    /// VAO holding position (location 0) and normal (location 1).
+    GLuint vertexArray() const { return vao; }
+
 private:
     GLuint vao = 0;
     GLuint vbo = 0;
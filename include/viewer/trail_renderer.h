@@ -0,0 +1,149 @@
+/**********************
+ * trail_renderer.h
+ * @brief Orbit trails for the orbit viewer
+ * @author Sinan Demir
+ * @date 10/16/2026
+ *
+ * Every body owns a fixed ring of trail points in one GPU vertex buffer,
+ * so memory and per-frame work are bounded by bodies * points no matter
+ * how long playback runs. Points are decimated as they are appended
+ * (distance/curvature LOD): a new point is kept only once the body has
+ * moved a few pixels AND turned by more than MAX_TURN_DEGREES, or moved
+ * MAX_SEGMENT_PX, so straight stretches cost few points and the ring
+ * covers a long arc. A live segment from the newest kept point to the
+ * body follows it every frame.
+ *
+ * All trails are drawn with one glMultiDrawArrays call (one or two ring
+ * ranges plus the live segment per body). GL 3.3 has no persistent
+ * mapping, so each frame maps the buffer unsynchronized with explicit
+ * flushes of only the written vertices. Up to REGIONS frames are in
+ * flight, each with a fence. A ring has REGIONS - 1 slots beyond the
+ * points it draws, and a body keeps at most one point per frame, so a new
+ * point overwrites a slot no in-flight draw reads. Only the live segments,
+ * rewritten every frame, have REGIONS copies. The CPU waits only on the
+ * draw from REGIONS frames ago (and on all of them after clear()).
+ *
+ * Memory is one ring per body plus the live segments: 10k bodies with
+ * DEFAULT_POINTS take about 236 MiB. Trails that would exceed
+ * MAX_BUFFER_BYTES are shortened to
+ * MAX_BUFFER_BYTES / (24 B * bodies) - 3 * REGIONS points per body
+ * (1109 for 10k bodies).
+ *
+ * Points are kept in double on the CPU and stored as high/low float
+ * pairs (position = high + low). draw() takes the camera target in double
+ * and the shader subtracts it the same way, half by half, so a trail is
+ * as precise as the camera-relative bodies at any distance from the
+ * origin (a single float is ~16 km coarse at 1 AU).
+ **********************/
+
+#ifndef TRAIL_RENDERER_H
+#define TRAIL_RENDERER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+class TrailRenderer {
+public:
+    /// Default trail length in kept points per body.
+    static constexpr std::size_t DEFAULT_POINTS = 1024;
+
+    /// Upper bound on GPU memory for the trail rings and live segments.
+    static constexpr std::size_t MAX_BUFFER_BYTES = 256u << 20;
+
+    /// Frames in flight (one fence each, one live-segment copy each).
+    static constexpr std::size_t REGIONS = 3;
+
+    // LOD thresholds (screen pixels at the body's distance, degrees)
+    static constexpr float MIN_SEGMENT_PX   = 2.0f;
+    static constexpr float MAX_SEGMENT_PX   = 48.0f;
+    static constexpr float MAX_TURN_DEGREES = 2.0f;
+
+    TrailRenderer() = default;
+    ~TrailRenderer();
+
+    TrailRenderer(const TrailRenderer&)            = delete;
+    TrailRenderer& operator=(const TrailRenderer&) = delete;
+
+    /**
+     * @brief Compiles the trail shader and allocates one ring per body.
+     *        Requires a current GL 3.3 context.
+     * @param colors  per-body trail color (linear RGB)
+     * @param points  ring size per body, reduced to fit MAX_BUFFER_BYTES
+     * @return false if the shader failed or there is nothing to trail
+     */
+    bool init(const std::vector<glm::vec3>& colors, std::size_t points = DEFAULT_POINTS);
+
+    /// Forgets all trails (after a seek or when playback loops).
+    void clear();
+
+    /**
+     * @brief Moves the live segments to `centers` and keeps a new point
+     *        for every body whose trail needs one.
+     * @param viewPos     camera position, world space
+     * @param pixelAngle  view angle of one pixel (radians), for the LOD
+     */
+    void update(const std::vector<glm::dvec3>& centers,
+                const glm::dvec3& viewPos,
+                float pixelAngle);
+
+    /**
+     * @brief Draws all trails in one multi-draw call (blended, no depth writes).
+     * @param viewProj  projection * view, relative to `origin`
+     * @param origin    camera target, world space
+     */
+    void draw(const glm::mat4& viewProj, const glm::dvec3& origin);
+
+    std::size_t points() const { return capacity; }
+
+private:
+    /**
+     * @brief Per-body ring state: kept points end at slot `head`;
+     *        `length` of them are valid.
+     */
+    struct Track {
+        glm::dvec3    last{0.0};    ///< newest kept point
+        glm::vec3     dir{0.0f};    ///< unit direction of the newest kept segment
+        std::uint32_t head   = 0;   ///< slot in [0, ringSlots)
+        std::uint32_t length = 0;   ///< at most capacity
+    };
+
+    /// One vertex: a double position split into two floats.
+    struct TrailVertex {
+        glm::vec3 high;
+        glm::vec3 low;
+    };
+
+    void waitForGPU(std::size_t region);
+
+    GLuint program = 0;
+    GLuint vao     = 0;
+    GLuint vbo     = 0;   ///< bodies rings of (ringSlots + 1) points, then REGIONS x live segments
+    GLuint trackBuffer  = 0;   ///< per body: color, head slot (buffer texture)
+    GLuint trackTexture = 0;
+    GLsync fence[REGIONS] = {};   ///< last draw in each frame slot
+
+    GLint locViewProj   = -1;
+    GLint locOriginHigh = -1;
+    GLint locOriginLow  = -1;
+    GLint locTrack    = -1;
+    GLint locSlots    = -1;
+    GLint locRing     = -1;
+    GLint locPoints   = -1;
+    GLint locLiveBase = -1;
+
+    std::size_t                capacity  = 0;   ///< points drawn per ring
+    std::size_t                ringSlots = 0;   ///< capacity + REGIONS - 1
+    std::size_t                region    = 0;   ///< frame slot of the last update(), drawn next
+    std::vector<Track>         tracks;
+    std::vector<glm::vec4>     trackData;       ///< mirror of trackBuffer
+    bool                       trackDirty = false;
+
+    // Multi-draw ranges, rebuilt per frame
+    std::vector<GLint>   firsts;
+    std::vector<GLsizei> counts;
+};
+
+#endif // TRAIL_RENDERER_H
@@ -0,0 +1,83 @@
+/**********************
+ * trajectory_buffer.h
+ * @brief GPU-resident trajectory window for the orbit viewer
+ * @author Sinan Demir
+ * @date 10/16/2026
+ *
+ * Body states are uploaded once into a buffer texture (GL 3.3 has no
+ * SSBOs) laid out frame-major, three RGBA32F texels per body:
+ *     texel 3 * (frame * numBodies + body)      position, high float
+ *     texel 3 * (frame * numBodies + body) + 1  position, low float
+ *     texel 3 * (frame * numBodies + body) + 2  velocity (xyz, per second)
+ * The double position is high + low. The body shader subtracts the camera
+ * target from each half separately, then Hermite-interpolates between the
+ * two frames around the playback time, so centers fetched on the GPU are
+ * as precise as the camera-relative ones computed on the CPU. Advancing
+ * playback is a uniform update.
+ *
+ * If the whole trajectory does not fit (GL_MAX_TEXTURE_BUFFER_SIZE or the
+ * byte budget below), a window of frames is kept resident and re-uploaded
+ * when the playhead leaves it.
+ **********************/
+
+#ifndef TRAJECTORY_BUFFER_H
+#define TRAJECTORY_BUFFER_H
+
+#include <cstddef>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+class TrajectoryBuffer {
+public:
+    /// Texels per body per frame (position high, position low, velocity).
+    static constexpr std::size_t TEXELS_PER_BODY = 3;
+
+    /// Upper bound on GPU memory used by the resident window.
+    static constexpr std::size_t MAX_WINDOW_BYTES = 256u << 20;
+
+    TrajectoryBuffer() = default;
+    ~TrajectoryBuffer();
+
+    TrajectoryBuffer(const TrajectoryBuffer&)            = delete;
+    TrajectoryBuffer& operator=(const TrajectoryBuffer&) = delete;
+
+    /**
+     * @brief Creates the buffer texture and uploads the first window.
+     * @param states  numFrames * numBodies (position, velocity) pairs in
+     *                double, frame-major; not copied, must outlive this
+     *                object
+     * @return false if there is nothing to upload
+     */
+    bool init(const glm::dvec3* states, std::size_t numFrames, std::size_t numBodies);
+
+    /**
+     * @brief Makes `frame` and the frame after it resident (re-uploading
+     *        the window if needed).
+     * @return the frame's index inside the resident window (shader uniform)
+     */
+    GLint select(std::size_t frame);
+
+    /// Binds the buffer texture to texture unit `unit`.
+    void bind(GLuint unit) const;
+
+    std::size_t bodies() const       { return numBodies; }
+    std::size_t frames() const       { return numFrames; }
+    std::size_t windowFrames() const { return window; }
+
+private:
+    void uploadWindow(std::size_t first);
+
+    const glm::dvec3* source = nullptr;
+    std::size_t numFrames   = 0;
+    std::size_t numBodies   = 0;
+    std::size_t window      = 0;   ///< frames resident on the GPU
+    std::size_t firstFrame  = 0;   ///< first resident frame
+
+    std::vector<glm::vec4> texels;   ///< upload staging (one window)
+
+    GLuint buffer  = 0;
+    GLuint texture = 0;
+};
+
+#endif // TRAJECTORY_BUFFER_H
@@ -0,0 +1,121 @@
+/**********************
+ * trajectory_stream.h
+ * @brief Out-of-core trajectory playback for the orbit viewer
+ * @author Sinan Demir
+ * @date 10/16/2026
+ *
+ * A background thread reads frames (CSV or binary .otraj) into a bounded
+ * ring buffer ahead of the playhead, so the window can open before the file
+ * is parsed and memory stays constant in trajectory length.
+ *
+ * Every frame carries its time and body velocities: binary trajectories
+ * store both, CSV frames get t = (step + 1) * dt and central-difference
+ * velocities (one-sided at the two ends of the file).
+ *
+ * Seeking outside the buffered range drops the ring and restarts the reader
+ * one frame before the target. Binary frames have a fixed size, so their
+ * offset is computed. CSV rows are found by an interpolation search on the
+ * step column: probe an estimated byte offset, resync on the next row,
+ * refine. The search is bracketed by checkpoints, the byte offset of every
+ * CHECKPOINT_EVERY-th frame remembered as the reader passes it (8 bytes per
+ * checkpoint).
+ **********************/
+
+#ifndef TRAJECTORY_STREAM_H
+#define TRAJECTORY_STREAM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "trajectory_binary.h"
+#include "vec3.h"
+
+class TrajectoryStream {
+public:
+    /// Default ring size (position + velocity, 48 bytes per body per frame).
+    static constexpr std::size_t DEFAULT_BUFFER_BYTES = 64u << 20;
+    static constexpr std::size_t CHECKPOINT_EVERY     = 1024;
+
+    /**
+     * @brief Opens `path` (header only) and starts the reader thread.
+     * @param csvDt  step size (s) used for CSV frame times
+     * @throws std::runtime_error if the file cannot be opened or parsed
+     */
+    explicit TrajectoryStream(const std::string& path,
+                              double csvDt,
+                              std::size_t bufferBytes = DEFAULT_BUFFER_BYTES);
+    ~TrajectoryStream();
+
+    TrajectoryStream(const TrajectoryStream&)            = delete;
+    TrajectoryStream& operator=(const TrajectoryStream&) = delete;
+
+    const std::vector<std::string>& bodyNames() const { return names; }
+
+    /**
+     * @brief Copies frame `frame` (SI units) into `out` and lets the reader
+     *        discard everything before it. Frames outside the buffered
+     *        range trigger a seek.
+     * @param following  if given, also receives frame + 1 (a copy of
+     *                   `frame` if that is the last one)
+     * @return false if the frame(s) are not buffered yet (or past the end)
+     */
+    bool acquire(std::size_t frame, TrajectoryFrame& out,
+                 TrajectoryFrame* following = nullptr);
+
+    /// @return exact frame count once the reader has hit end of file, else 0.
+    std::size_t frameCount() const { return total.load(); }
+
+    /// @return frame count (exact, or estimated from bytes per frame so far).
+    std::size_t approxFrames() const;
+
+    /// @return frames buffered ahead of (and including) the playhead.
+    std::size_t buffered() const;
+
+    std::size_t capacityFrames() const { return capacity; }
+
+    /// Frame source (CSV or binary), defined in trajectory_stream.cpp.
+    struct Source;
+
+private:
+    void run();
+    bool reposition(std::size_t target);
+
+    std::unique_ptr<Source>  source;
+    std::vector<std::string> names;
+    std::size_t              bodies   = 0;
+    std::size_t              capacity = 0;   ///< ring size in frames
+
+    void copySlot(std::size_t frame, TrajectoryFrame& out) const;
+
+    // Ring: frames [base, base + count) at slot (frame % capacity);
+    // per slot, positions then velocities (2 * bodies) and a time
+    mutable std::mutex      mtx;
+    std::condition_variable cv;
+    std::vector<vec3>       ring;
+    std::vector<double>     times;
+    std::size_t             base  = 0;
+    std::size_t             count = 0;
+    std::size_t             seekTarget = 0;
+    bool                    seekPending = false;
+    bool                    stopping    = false;
+    bool                    atEnd       = false;
+
+    // Reader-thread only
+    std::vector<long long>   checkpoints;   ///< offset of frame k * CHECKPOINT_EVERY
+    std::size_t              endFrame  = 0;   ///< frame count found by a seek past EOF
+    long long                headerEnd = 0;
+    long long                fileBytes = 0;
+
+    std::atomic<std::size_t> total{0};
+    std::atomic<std::size_t> estimate{0};
+
+    std::thread reader;
+};
+
+#endif // TRAJECTORY_STREAM_H
@@ -0,0 +1,1256 @@
+/********************
+ * Author: Sinan Demir
+ * File: orbit_bench.cpp
+ * Date: 10/16/2026
+ * Purpose:
+ *    Micro-benchmarks for the physics core (orbit-bench executable).
+ *    Currently covers:
+ *      - computeSolarEclipse (scalar, per sample)
+ *      - computeSolarEclipseBatch (SoA, vectorized across samples), on a
+ *        mixed catalog and on no-overlap, annular and partial sets
+ *      - loadSystemFromJSON (streaming SAX) vs. a json DOM parse, and
+ *        SystemSnapshot (mmap) load of the same system
+ *      - trajectory CSV loading: streaming reader, the old per-row
+ *        stringstream/stod path and the parallel from_chars loader
+ *      - parseHorizonsVectors on a synthetic multi-year VECTORS table
+ *      - ChebyshevEphemeris fit accuracy and state-query latency
+ *      - updateAccelerations / rk4Step / physics::compute per N and
+ *        computeSolarEclipse per call (ns/call, ns/pair interaction)
+ *      - fixed-N RK4 steppers vs. the N-generic path for N = 2..16
+ *      - full runSimulation over an N x steps matrix (steps/s)
+ *
+ * Usage:
+ *    orbit-bench [--samples N] [--bodies N] [--reps R]
+ *                [--only eclipse|loader|csv|horizons|ephemeris|kernels|fixed|run]
+ *                [--n 2,8,32] [--steps 100,1000] [--csv-mb MB] [--json FILE]
+ *    (--bodies also sets the number of HORIZONS records, --samples the
+ *     number of ephemeris queries; --n / --steps set the kernel and run
+ *     matrices; --csv-mb sizes the synthetic trajectory CSV, 1024 by
+ *     default; --json writes every kernel/run record for tracking across
+ *     versions)
+ *********************/
+
+#include "chebyshev_ephemeris.h"
+#include "conservations.h"
+#include "eclipse.h"
+#include "horizons_parser.h"
+#include "json_loader.h"
+#include "kernels.h"
+#include "simulation.h"
+#include "system_snapshot.h"
+#include "trajectory_csv.h"
+#include "utils.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+/********************
+ * struct EclipseSamples
+ * @brief: SoA Sun/Earth/Moon positions (m) for a synthetic eclipse catalog.
+ *********************/
+struct EclipseSamples {
+    std::vector<double> sx, sy, sz;
+    std::vector<double> ex, ey, ez;
+    std::vector<double> mx, my, mz;
+};
+
+/********************
+ * makeEclipseSamples
+ * @brief: Generates n instants of a simplified Sun–Earth–Moon geometry.
+ * @param n - number of samples
+ * @return EclipseSamples with Sun at origin, Earth on a 1 AU circle and the
+ *         Moon on an inclined circle around Earth, plus a few degenerate
+ *         instants.
+ * @note: Geometry only — no dynamics. Realistic magnitudes, so nearly
+ *        every instant is partial; makeEclipseCase covers the other classes.
+ *********************/
+static EclipseSamples makeEclipseSamples(std::size_t n) {
+    using namespace physics::constants;
+
+    EclipseSamples s;
+    for (auto* v : {&s.sx, &s.sy, &s.sz, &s.ex, &s.ey, &s.ez, &s.mx, &s.my, &s.mz}) {
+        v->resize(n);
+    }
+
+    const double earthPeriod = 365.25 * 86400.0;   // s
+    const double moonPeriod  = 29.53 * 86400.0;    // s (synodic)
+    const double dt          = 600.0;              // 10 min sampling
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const double t  = dt * static_cast<double>(i);
+        const double ae = 2.0 * M_PI * t / earthPeriod;
+        const double am = 2.0 * M_PI * t / moonPeriod + ae;
+
+        s.sx[i] = 0.0;
+        s.sy[i] = 0.0;
+        s.sz[i] = 0.0;
+
+        s.ex[i] = AU * std::cos(ae);
+        s.ey[i] = AU * std::sin(ae);
+        s.ez[i] = 0.0;
+
+        s.mx[i] = s.ex[i] + MOON_ORBIT_RADIUS * std::cos(am);
+        s.my[i] = s.ey[i] + MOON_ORBIT_RADIUS * std::sin(am) * std::cos(MOON_INCLINATION);
+        s.mz[i] =           MOON_ORBIT_RADIUS * std::sin(am) * std::sin(MOON_INCLINATION);
+
+        // Sprinkle degenerate (Moon == Earth) instants to cover the
+        // zero-distance path of the classifier.
+        if (i % 4096 == 0) {
+            s.mx[i] = s.ex[i];
+            s.my[i] = s.ey[i];
+            s.mz[i] = s.ez[i];
+        }
+    }
+    return s;
+}
+
+/// Geometry of a targeted eclipse sample set (makeEclipseCase).
+enum class EclipseCase { NoOverlap, Annular, Partial };
+
+/********************
+ * makeEclipseCase
+ * @brief: Generates n instants that all fall into one eclipse class, so
+ *         each branch of the classifier is timed on its own.
+ * @param n     - number of samples
+ * @param which - NoOverlap: degenerate instants (Moon on Earth or on the
+ *                Sun); Annular: Moon 1.2e9–4e9 m from Earth, past the
+ *                ~1e9 m where the penumbra outgrows Earth; Partial: Moon
+ *                between perigee and apogee distance
+ * @note: The classifier only looks at distances, so directions are
+ *        random (fixed seed). Total is unreachable: the umbra radius at
+ *        Earth is at most R_MOON < R_EARTH.
+ *********************/
+static EclipseSamples makeEclipseCase(std::size_t n, EclipseCase which) {
+    using namespace physics::constants;
+
+    EclipseSamples s;
+    for (auto* v : {&s.sx, &s.sy, &s.sz, &s.ex, &s.ey, &s.ez, &s.mx, &s.my, &s.mz}) {
+        v->resize(n);
+    }
+
+    std::mt19937_64 rng(26);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    std::uniform_real_distribution<double> angle(0.0, 2.0 * M_PI);
+    std::uniform_real_distribution<double> annular(1.2e9, 4.0e9);
+    std::uniform_real_distribution<double> partial(3.563e8, 4.067e8);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const double ae = angle(rng);
+        s.sx[i] = 0.0;
+        s.sy[i] = 0.0;
+        s.sz[i] = 0.0;
+        s.ex[i] = AU * std::cos(ae);
+        s.ey[i] = AU * std::sin(ae);
+        s.ez[i] = 0.0;
+
+        if (which == EclipseCase::NoOverlap) {
+            const bool onEarth = (i % 2) == 0;
+            s.mx[i] = onEarth ? s.ex[i] : s.sx[i];
+            s.my[i] = onEarth ? s.ey[i] : s.sy[i];
+            s.mz[i] = onEarth ? s.ez[i] : s.sz[i];
+            continue;
+        }
+
+        // Uniform direction on the sphere
+        const double z   = unit(rng);
+        const double phi = angle(rng);
+        const double rxy = std::sqrt(1.0 - z * z);
+        const double d   = which == EclipseCase::Annular ? annular(rng) : partial(rng);
+        s.mx[i] = s.ex[i] + d * rxy * std::cos(phi);
+        s.my[i] = s.ey[i] + d * rxy * std::sin(phi);
+        s.mz[i] = s.ez[i] + d * z;
+    }
+    return s;
+}
+
+/********************
+ * bestOf
+ * @brief: Runs fn() reps times and returns the fastest wall time (s).
+ *********************/
+template <typename Fn>
+static double bestOf(int reps, Fn&& fn) {
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        auto t0 = Clock::now();
+        fn();
+        auto t1 = Clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+    }
+    return best;
+}
+
+/********************
+ * benchEclipseSet
+ * @brief: Times scalar vs batch eclipse classification on one sample set
+ *         and checks that both paths produce bit-identical results.
+ * @param label    - set name for the report
+ * @param expected - eclipse type every sample must have, or -1 for a mix
+ * @return true if results match (and all have `expected`), false otherwise
+ *********************/
+static bool benchEclipseSet(const char* label, const EclipseSamples& s, int reps, int expected) {
+    const std::size_t n = s.sx.size();
+
+    // ---- scalar reference ----
+    std::vector<EclipseResult> ref(n);
+    double tScalar = bestOf(reps, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            ref[i] = computeSolarEclipse(vec3(s.sx[i], s.sy[i], s.sz[i]),
+                                         vec3(s.ex[i], s.ey[i], s.ez[i]),
+                                         vec3(s.mx[i], s.my[i], s.mz[i]));
+        }
+    });
+
+    // ---- SoA batch ----
+    std::vector<double> ox(n), oy(n), oz(n), ou(n), op(n);
+    std::vector<int>    ot(n);
+    EclipseBatchOutput out{ox.data(), oy.data(), oz.data(),
+                           ou.data(), op.data(), ot.data()};
+
+    double tBatch = bestOf(reps, [&] {
+        computeSolarEclipseBatch({s.sx.data(), s.sy.data(), s.sz.data()},
+                                 {s.ex.data(), s.ey.data(), s.ez.data()},
+                                 {s.mx.data(), s.my.data(), s.mz.data()},
+                                 n, out);
+    });
+
+    // ---- bitwise comparison ----
+    auto same = [](double a, double b) {
+        return std::memcmp(&a, &b, sizeof(double)) == 0;
+    };
+
+    std::size_t mismatches = 0;
+    std::size_t counts[4] = {0, 0, 0, 0};
+    for (std::size_t i = 0; i < n; ++i) {
+        const EclipseResult& r = ref[i];
+        if (!same(r.shadowCenter.x(), ox[i]) ||
+            !same(r.shadowCenter.y(), oy[i]) ||
+            !same(r.shadowCenter.z(), oz[i]) ||
+            !same(r.umbraRadius, ou[i])      ||
+            !same(r.penumbraRadius, op[i])   ||
+            r.eclipseType != ot[i]) {
+            ++mismatches;
+        }
+        if (r.eclipseType >= 0 && r.eclipseType <= 3) ++counts[r.eclipseType];
+    }
+
+    const double nd = static_cast<double>(n);
+    std::cout << "computeSolarEclipse, " << label << " (" << n << " samples, best of " << reps << ")\n"
+              << " - scalar: " << tScalar * 1e9 / nd << " ns/sample, "
+              << nd / tScalar / 1e6 << " Msamples/s\n"
+              << " - batch:  " << tBatch * 1e9 / nd << " ns/sample, "
+              << nd / tBatch / 1e6 << " Msamples/s\n"
+              << " - speedup: " << tScalar / tBatch << "x\n"
+              << " - types:  none=" << counts[0] << " total=" << counts[1]
+              << " annular=" << counts[2] << " partial=" << counts[3] << "\n";
+
+    if (mismatches != 0) {
+        std::cerr << "❌ Batch/scalar mismatch in " << mismatches << " samples\n";
+        return false;
+    }
+    if (expected >= 0 && counts[expected] != n) {
+        std::cerr << "❌ " << (n - counts[expected]) << " " << label
+                  << " samples fell into another class\n";
+        return false;
+    }
+    std::cout << "✅ Batch results bit-identical to scalar\n";
+    return true;
+}
+
+/********************
+ * benchEclipse
+ * @brief: Runs benchEclipseSet on the mixed catalog and on one set per
+ *         reachable eclipse class.
+ * @return true if every set passes, false otherwise
+ *********************/
+static bool benchEclipse(std::size_t n, int reps) {
+    bool ok = benchEclipseSet("catalog", makeEclipseSamples(n), reps, -1);
+    ok = benchEclipseSet("no overlap", makeEclipseCase(n, EclipseCase::NoOverlap), reps, 0) && ok;
+    ok = benchEclipseSet("annular", makeEclipseCase(n, EclipseCase::Annular), reps, 2) && ok;
+    ok = benchEclipseSet("partial", makeEclipseCase(n, EclipseCase::Partial), reps, 3) && ok;
+
+    // Total needs an umbra wider than Earth; at Earth it is at most R_MOON
+    static_assert(physics::constants::R_MOON < physics::constants::R_EARTH,
+                  "total eclipses are reachable: add a total sample set");
+    std::cout << "ℹ️ total: unreachable for the classifier (umbra radius <= R_MOON < R_EARTH)\n";
+    return ok;
+}
+
+/********************
+ * writeSyntheticSystem
+ * @brief: Writes an n-body system file in the loader's schema (asteroid-
+ *         catalog sized when n is large).
+ * @param path - destination JSON file
+ * @param n - number of bodies
+ * @return file size in bytes, or 0 on failure
+ *********************/
+static std::uintmax_t writeSyntheticSystem(const std::string& path, std::size_t n) {
+    std::ofstream out(path);
+    if (!out) return 0;
+
+    out.precision(17);
+    out << "{\n  \"name\": \"synthetic\",\n  \"bodies\": [\n";
+    for (std::size_t i = 0; i < n; ++i) {
+        const double a  = 2.0e11 + 1.0e3 * static_cast<double>(i);
+        const double th = 1.0e-3 * static_cast<double>(i);
+        out << "    { \"name\": \"A" << i << "\", \"mass\": " << 1.0e15 + static_cast<double>(i)
+            << ", \"position\": [" << a * std::cos(th) << ", " << a * std::sin(th) << ", " << 1.0e7 * std::sin(3.0 * th) << "]"
+            << ", \"velocity\": [" << -1.9e4 * std::sin(th) << ", " << 1.9e4 * std::cos(th) << ", 0.0] }"
+            << (i + 1 < n ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    out.close();
+
+    return out ? std::filesystem::file_size(path) : 0;
+}
+
+/********************
+ * loadSystemDOM
+ * @brief: Reference loader that builds a full json DOM first (the approach
+ *         loadSystemFromJSON used before it was made streaming).
+ *********************/
+static std::vector<CelestialBody> loadSystemDOM(const std::string& path) {
+    std::ifstream file(path);
+    nlohmann::json j;
+    file >> j;
+
+    std::vector<CelestialBody> bodies;
+    for (const auto& b : j["bodies"]) {
+        auto p = b.at("position");
+        auto v = b.at("velocity");
+        bodies.emplace_back(b.at("name").get<std::string>(), b.at("mass").get<double>(),
+                            p.at(0).get<double>(), p.at(1).get<double>(), p.at(2).get<double>(),
+                            v.at(0).get<double>(), v.at(1).get<double>(), v.at(2).get<double>(),
+                            0.0, 0.0, 0.0);
+    }
+    return bodies;
+}
+
+/********************
+ * benchLoader
+ * @brief: Times the streaming loader against the DOM reference on a
+ *         synthetic n-body file and checks both produce the same bodies.
+ * @return true if results match, false otherwise
+ *********************/
+static bool benchLoader(std::size_t n, int reps) {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "orbit_bench_system.json").string();
+
+    const std::uintmax_t bytes = writeSyntheticSystem(path, n);
+    if (bytes == 0) {
+        std::cerr << "❌ Could not write " << path << "\n";
+        return false;
+    }
+
+    std::vector<CelestialBody> sax, dom, snap;
+    double tSax = bestOf(reps, [&] { sax = loadSystemFromJSON(path); });
+    double tDom = bestOf(reps, [&] { dom = loadSystemDOM(path); });
+    std::filesystem::remove(path);
+
+    // Same system as a binary snapshot: map-only vs. map + copy to bodies
+    const std::string snapPath = path + ".osnap";
+    if (!writeSystemSnapshot(snapPath, sax, SystemMetadata{})) {
+        std::cerr << "❌ Could not write " << snapPath << "\n";
+        return false;
+    }
+    double tMap = bestOf(reps, [&] {
+        SystemSnapshot s(snapPath);
+        if (s.size() != n) std::cerr << "❌ Snapshot body count mismatch\n";
+    });
+    double tSnap = bestOf(reps, [&] { snap = loadSystem(snapPath); });
+    std::filesystem::remove(snapPath);
+
+    auto sameBodies = [](const std::vector<CelestialBody>& a, const std::vector<CelestialBody>& b) {
+        if (a.size() != b.size()) return false;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (a[i].name != b[i].name || a[i].mass != b[i].mass ||
+                a[i].position.x() != b[i].position.x() ||
+                a[i].position.y() != b[i].position.y() ||
+                a[i].position.z() != b[i].position.z() ||
+                a[i].velocity.x() != b[i].velocity.x() ||
+                a[i].velocity.y() != b[i].velocity.y() ||
+                a[i].velocity.z() != b[i].velocity.z()) {
+                return false;
+            }
+        }
+        return true;
+    };
+    const bool match = sax.size() == n && sameBodies(sax, dom) && sameBodies(sax, snap);
+
+    const double mb = static_cast<double>(bytes) / (1024.0 * 1024.0);
+    std::cout << "loadSystemFromJSON (" << n << " bodies, " << mb << " MiB, best of " << reps << ")\n"
+              << " - streaming: " << tSax * 1e3 << " ms, " << mb / tSax << " MiB/s\n"
+              << " - DOM:       " << tDom * 1e3 << " ms, " << mb / tDom << " MiB/s\n"
+              << " - speedup: " << tDom / tSax << "x\n"
+              << " - snapshot map only:      " << tMap * 1e3 << " ms\n"
+              << " - snapshot map + bodies:  " << tSnap * 1e3 << " ms\n";
+
+    if (!match) {
+        std::cerr << "❌ Streaming/DOM/snapshot loader results differ\n";
+        return false;
+    }
+    std::cout << "✅ Streaming, DOM and snapshot loaders agree\n";
+    return true;
+}
+
+/********************
+ * writeSyntheticTrajectory
+ * @brief: Writes a trajectory CSV in runSimulation's layout (step, x/y/z
+ *         per body, 14 conservation columns) of about `mb` MiB.
+ * @return file size in bytes (0 on failure)
+ *********************/
+static std::uintmax_t writeSyntheticTrajectory(const std::string& path, std::size_t mb,
+                                               std::size_t nBodies) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return 0;
+
+    out << "step,";
+    for (std::size_t b = 0; b < nBodies; ++b) {
+        out << "x_B" << b << ",y_B" << b << ",z_B" << b << ",";
+    }
+    out << "E_total,KE,PE,Lx,Ly,Lz,Lmag,Px,Py,Pz,Pmag,dE_rel,dL_rel,dP_rel\n";
+
+    const std::uintmax_t target = std::uintmax_t(mb) << 20;
+    std::uintmax_t written = 0;
+    std::string row;
+    char field[40];
+    for (long step = 0; written < target; ++step) {
+        row = std::to_string(step);
+        for (std::size_t b = 0; b < nBodies; ++b) {
+            const double r  = 5.0e10 * static_cast<double>(b + 1);
+            const double th = 1e-3 * static_cast<double>(step) / static_cast<double>(b + 1);
+            for (double v : {r * std::cos(th), r * std::sin(th), 1e-3 * r * std::sin(3.0 * th)}) {
+                std::snprintf(field, sizeof(field), ",%.9g", v);
+                row += field;
+            }
+        }
+        for (int c = 0; c < 14; ++c) {
+            std::snprintf(field, sizeof(field), ",%.9g", -1.0e33 + c * 1.0e-7 * static_cast<double>(step));
+            row += field;
+        }
+        row += '\n';
+        out << row;
+        written += row.size();
+    }
+    out.close();
+    return out ? std::filesystem::file_size(path) : 0;
+}
+
+/********************
+ * loadTrajectoryLegacy
+ * @brief: The viewer's original per-row parser (getline + stringstream +
+ *         stod per field, fresh vectors per row), for reference. Stops
+ *         after maxBytes of rows.
+ * @return rows parsed
+ *********************/
+static std::size_t loadTrajectoryLegacy(const std::string& path, std::uintmax_t maxBytes,
+                                        std::vector<std::vector<double>>& positions) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+
+    std::stringstream header(line);
+    std::vector<std::string> columns;
+    std::string col;
+    std::vector<std::size_t> xCols;
+    while (std::getline(header, col, ',')) {
+        if (col.rfind("x_", 0) == 0) xCols.push_back(columns.size());
+        columns.push_back(col);
+    }
+    positions.assign(xCols.size(), {});
+
+    std::uintmax_t bytes = 0;
+    std::size_t rows = 0;
+    while (bytes < maxBytes && std::getline(file, line)) {
+        bytes += line.size() + 1;
+        if (line.empty()) continue;
+        std::stringstream ss(line);
+        std::vector<double> rowValues;
+        std::string v;
+        while (std::getline(ss, v, ',')) {
+            try {
+                rowValues.push_back(std::stod(v));
+            } catch (...) {
+                rowValues.push_back(0.0);
+            }
+        }
+        if (rowValues.size() < columns.size()) continue;
+
+        for (std::size_t b = 0; b < xCols.size(); ++b) {
+            for (int a = 0; a < 3; ++a) positions[b].push_back(rowValues[xCols[b] + a]);
+        }
+        ++rows;
+    }
+    return rows;
+}
+
+/********************
+ * benchTrajectoryCSV
+ * @brief: Loads a ~mb MiB synthetic trajectory CSV with the streaming
+ *         reader, the legacy viewer parser (first 64 MiB only, it is
+ *         slow) and loadTrajectoryCSV on 1 and all threads, and checks the
+ *         parallel result against the streaming reader value for value.
+ * @return true if the loaders agree
+ *********************/
+static bool benchTrajectoryCSV(std::size_t mb, int reps) {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "orbit_bench_trajectory.csv").string();
+    const std::size_t nBodies = 11;
+
+    std::cout << "Trajectory CSV loaders (writing " << mb << " MiB to " << path << ")\n";
+    const std::uintmax_t bytes = writeSyntheticTrajectory(path, mb, nBodies);
+    if (bytes == 0) {
+        std::cerr << "❌ Could not write " << path << "\n";
+        return false;
+    }
+    const double fileMb = static_cast<double>(bytes) / (1024.0 * 1024.0);
+
+    // Streaming reader, one pass (also the reference values)
+    std::vector<std::vector<vec3>> seq(nBodies);
+    const double tSeq = bestOf(1, [&] {
+        TrajectoryCSVReader reader(path);
+        TrajectoryCSVRow row;
+        while (reader.next(row)) {
+            for (std::size_t b = 0; b < nBodies; ++b) seq[b].push_back(row.positions[b]);
+        }
+    });
+
+    // Legacy viewer path on a prefix
+    const std::uintmax_t legacyBytes = std::min<std::uintmax_t>(bytes, 64u << 20);
+    std::vector<std::vector<double>> legacy;
+    std::size_t legacyRows = 0;
+    const double tLegacy = bestOf(1, [&] { legacyRows = loadTrajectoryLegacy(path, legacyBytes, legacy); });
+
+    TrajectoryCSVData one, all;
+    const double tOne = bestOf(reps, [&] { one = loadTrajectoryCSV(path, 1); });
+    const double tAll = bestOf(reps, [&] { all = loadTrajectoryCSV(path); });
+    std::filesystem::remove(path);
+
+    bool match = all.names.size() == nBodies && all.frames() == seq[0].size()
+                 && one.frames() == seq[0].size();
+    for (std::size_t b = 0; match && b < nBodies; ++b) {
+        for (std::size_t f = 0; f < seq[b].size(); ++f) {
+            const vec3& s = seq[b][f];
+            const vec3& p = all.positions[b][f];
+            const vec3& q = one.positions[b][f];
+            if (s.x() != p.x() || s.y() != p.y() || s.z() != p.z() ||
+                s.x() != q.x() || s.y() != q.y() || s.z() != q.z()) {
+                match = false;
+                break;
+            }
+        }
+    }
+    for (std::size_t b = 0; match && b < nBodies; ++b) {
+        for (std::size_t f = 0; f < legacyRows; ++f) {
+            if (legacy[b][3 * f] != seq[b][f].x()) { match = false; break; }
+        }
+    }
+
+    const double legacyMb = static_cast<double>(legacyBytes) / (1024.0 * 1024.0);
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << " - " << seq[0].size() << " frames x " << nBodies << " bodies, "
+              << fileMb << " MiB\n"
+              << " - legacy stringstream/stod: " << legacyMb / tLegacy << " MiB/s (first "
+              << legacyMb << " MiB)\n"
+              << " - streaming reader:         " << tSeq * 1e3 << " ms, " << fileMb / tSeq << " MiB/s\n"
+              << " - parallel, 1 thread:       " << tOne * 1e3 << " ms, " << fileMb / tOne << " MiB/s\n"
+              << " - parallel, " << hw << " threads:" << std::string(hw < 10 ? 6 : 5, ' ')
+              << tAll * 1e3 << " ms, " << fileMb / tAll << " MiB/s\n"
+              << " - speedup vs legacy: " << (fileMb / tAll) / (legacyMb / tLegacy) << "x\n";
+
+    if (!match) {
+        std::cerr << "❌ Trajectory CSV loaders disagree\n";
+        return false;
+    }
+    std::cout << "✅ Parallel, streaming and legacy loaders agree\n";
+    return true;
+}
+
+/********************
+ * makeHorizonsVectors
+ * @brief: Renders n records in the HORIZONS VECTORS layout (KM-S,
+ *         VEC_TABLE 3) for an Earth-like circular orbit.
+ *********************/
+static std::string makeHorizonsVectors(std::size_t n) {
+    std::string text =
+        "  GM, km^3/s^2             = 398600.435436   Mass ratio (Sun/Earth)  = 332946.0487\n"
+        "Target body name: Earth (399)                     {source: DE441}\n"
+        "Center body name: Solar System Barycenter (0)     {source: DE441}\n"
+        "Output units    : KM-S\n"
+        "$$SOE\n";
+    text.reserve(text.size() + n * 260);
+
+    char line[128];
+    for (std::size_t i = 0; i < n; ++i) {
+        const double th = 2.0 * M_PI * static_cast<double>(i) / 8766.0;   // hourly, 1 yr period
+        const double r  = 1.496e8, v = 29.78;                              // km, km/s
+
+        std::snprintf(line, sizeof(line), "%.9f = A.D. 2025-Jan-01 00:00:00.0000 TDB \n",
+                      2460676.5 + static_cast<double>(i) / 24.0);
+        text += line;
+        std::snprintf(line, sizeof(line), " X =%22.15E Y =%22.15E Z =%22.15E\n",
+                      r * std::cos(th), r * std::sin(th), 0.0);
+        text += line;
+        std::snprintf(line, sizeof(line), " VX=%22.15E VY=%22.15E VZ=%22.15E\n",
+                      -v * std::sin(th), v * std::cos(th), 0.0);
+        text += line;
+        text += " LT= 4.990047837524802E+02 RG= 1.496000000000000E+08 RR= 0.000000000000000E+00\n";
+    }
+    text += "$$EOE\n";
+    return text;
+}
+
+/********************
+ * benchHorizons
+ * @brief: Measures VECTORS parse throughput and checks the unit
+ *         conversion on the first and last records.
+ * @return true if the parsed values are as expected
+ *********************/
+static bool benchHorizons(std::size_t records, int reps) {
+    const std::string text = makeHorizonsVectors(records);
+
+    HorizonsEphemeris eph;
+    double t = bestOf(reps, [&] { eph = parseHorizonsVectors(text); });
+
+    const double thLast = 2.0 * M_PI * static_cast<double>(records - 1) / 8766.0;
+    const bool ok = eph.states.size() == records &&
+                    eph.targetName == "Earth" && eph.targetId == "399" &&
+                    std::fabs(eph.gm - 3.98600435436e14) < 1.0 &&
+                    std::fabs(eph.states.front().position.x() - 1.496e11) < 1.0e-3 &&
+                    std::fabs(eph.states.back().velocity.y() - 29780.0 * std::cos(thLast)) < 1.0e-9;
+
+    const double mb = static_cast<double>(text.size()) / (1024.0 * 1024.0);
+    std::cout << "parseHorizonsVectors (" << records << " records, " << mb << " MiB, best of " << reps << ")\n"
+              << " - " << t * 1e3 << " ms, " << mb / t << " MiB/s, "
+              << t * 1e9 / static_cast<double>(records) << " ns/record\n";
+
+    if (!ok) {
+        std::cerr << "❌ Parsed HORIZONS values differ from the generated table\n";
+        return false;
+    }
+    std::cout << "✅ HORIZONS parse (km, km/s → m, m/s) verified\n";
+    return true;
+}
+
+/********************
+ * makeEphemerisSystem
+ * @brief: Sun, Earth, Moon and four outer planets on circular orbits,
+ *         slightly inclined so every axis carries signal.
+ *********************/
+static std::vector<CelestialBody> makeEphemerisSystem() {
+    using namespace physics::constants;
+
+    std::vector<CelestialBody> bodies;
+    bodies.emplace_back("Sun", M_SUN, 0, 0, 0, 0, 0, 0);
+
+    struct Planet { const char* name; double mass, au; };
+    const Planet planets[] = {{"Earth", M_EARTH, 1.0},   {"Mars", 6.417e23, 1.524},
+                              {"Jupiter", 1.898e27, 5.203}, {"Saturn", 5.683e26, 9.537},
+                              {"Neptune", 1.024e26, 30.07}};
+    double phase = 0.0;
+    for (const Planet& p : planets) {
+        const double r = p.au * AU;
+        const double v = std::sqrt(G * M_SUN / r);
+        bodies.emplace_back(p.name, p.mass,
+                            r * std::cos(phase), r * std::sin(phase), 0.01 * r * std::sin(phase),
+                            -v * std::sin(phase), v * std::cos(phase), 0.0);
+        phase += 1.1;
+    }
+
+    const CelestialBody& earth = bodies[1];
+    const double rm = 3.844e8, vm = std::sqrt(G * M_EARTH / rm);
+    bodies.emplace_back("Moon", M_MOON,
+                        earth.position.x() + rm, earth.position.y(), earth.position.z(),
+                        earth.velocity.x(), earth.velocity.y() + vm * std::cos(MOON_INCLINATION),
+                        vm * std::sin(MOON_INCLINATION));
+    return bodies;
+}
+
+/********************
+ * checkEphemerisSplit
+ * @brief: Fits the first steps+1 integrated frames (so the last window
+ *         can be partial) and checks the reader at every one of them.
+ * @param frames - N x {x,y,z,vx,vy,vz} per frame, frame i at t = i * dt
+ * @return true if |dr| < 1 m and |dv| < 1 mm/s everywhere
+ *********************/
+static bool checkEphemerisSplit(const std::vector<double>& frames,
+                                const std::vector<std::string>& names,
+                                int steps, double dt, const std::string& path) {
+    const std::size_t n = names.size();
+    ChebyshevFitOptions fit;
+    ChebyshevEphemerisWriter writer;
+    if (!writer.open(path, names, dt, "", fit)) {
+        std::cerr << "❌ Could not write " << path << "\n";
+        return false;
+    }
+
+    TrajectoryFrame frame;
+    frame.positions.resize(n);
+    frame.velocities.resize(n);
+    for (int i = 0; i <= steps; ++i) {
+        frame.t = i * dt;
+        for (std::size_t b = 0; b < n; ++b) {
+            const double* f = &frames[(static_cast<std::size_t>(i) * n + b) * 6];
+            frame.positions[b]  = vec3(f[0], f[1], f[2]);
+            frame.velocities[b] = vec3(f[3], f[4], f[5]);
+        }
+        writer.add(frame);
+    }
+    if (!writer.finish()) {
+        std::cerr << "❌ " << steps << " steps: " << writer.error() << "\n";
+        return false;
+    }
+
+    double maxDr = 0.0, maxDv = 0.0;
+    {
+        ChebyshevEphemeris eph(path);
+        for (int i = 0; i <= steps; ++i) {
+            for (std::size_t b = 0; b < n; ++b) {
+                const double* f = &frames[(static_cast<std::size_t>(i) * n + b) * 6];
+                vec3 p, v;
+                eph.state(b, i * dt, p, v);
+                // NaN-safe: a broken window must fail the check
+                const double dr = (p - vec3(f[0], f[1], f[2])).length();
+                const double dv = (v - vec3(f[3], f[4], f[5])).length();
+                maxDr = std::isfinite(dr) ? std::max(maxDr, dr) : HUGE_VAL;
+                maxDv = std::isfinite(dv) ? std::max(maxDv, dv) : HUGE_VAL;
+            }
+        }
+    }
+    std::filesystem::remove(path);
+
+    const int rest = steps % fit.windowSteps;
+    std::cout << "   " << steps << " steps (last window " << (rest ? rest : fit.windowSteps)
+              << " of " << fit.windowSteps << "): max |dr| = " << maxDr
+              << " m, max |dv| = " << maxDv << " m/s\n";
+    return maxDr < 1.0 && maxDv < 1e-3;
+}
+
+/********************
+ * benchEphemeris
+ * @brief: Integrates one year (dt = 1 h), fits a Chebyshev ephemeris with
+ *         the default window/degree, checks it against every integrated
+ *         frame and times random state queries. Shorter prefixes whose
+ *         step count is, or is not, a multiple of the window check the
+ *         partial last window.
+ * @return true if the fit reproduces the frames to within 1 m / 1 mm/s
+ *********************/
+static bool benchEphemeris(std::size_t queries, int reps) {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "orbit_bench.oeph").string();
+
+    std::vector<CelestialBody> bodies = makeEphemerisSystem();
+    const std::size_t n = bodies.size();
+    const int steps = 8766;
+    const double dt = 3600.0;
+
+    std::vector<std::string> names;
+    for (const auto& b : bodies) names.push_back(b.name);
+
+    // Integrate once, keeping every frame as the reference
+    std::vector<double> frames;
+    frames.reserve(static_cast<std::size_t>(steps + 1) * n * 6);
+    auto keep = [&] {
+        for (const auto& b : bodies) {
+            frames.insert(frames.end(), {b.position.x(), b.position.y(), b.position.z(),
+                                         b.velocity.x(), b.velocity.y(), b.velocity.z()});
+        }
+    };
+
+    ChebyshevFitOptions fit;
+    ChebyshevEphemerisWriter writer;
+    if (!writer.open(path, names, dt, "", fit)) {
+        std::cerr << "❌ Could not write " << path << "\n";
+        return false;
+    }
+    writer.add(0.0, bodies);
+    keep();
+    for (int i = 0; i < steps; ++i) {
+        rk4Step(bodies, dt);
+        writer.add((i + 1) * dt, bodies);
+        keep();
+    }
+    if (!writer.finish()) {
+        std::cerr << "❌ Could not finalize " << path << "\n";
+        return false;
+    }
+
+    bool ok = true;
+    try {
+        ChebyshevEphemeris eph(path);
+
+        // Accuracy at every integrated frame
+        std::vector<double> maxDr(n, 0.0), maxDv(n, 0.0);
+        for (int i = 0; i <= steps; ++i) {
+            for (std::size_t b = 0; b < n; ++b) {
+                const double* f = &frames[(static_cast<std::size_t>(i) * n + b) * 6];
+                vec3 p, v;
+                eph.state(b, i * dt, p, v);
+                maxDr[b] = std::max(maxDr[b], (p - vec3(f[0], f[1], f[2])).length());
+                maxDv[b] = std::max(maxDv[b], (v - vec3(f[3], f[4], f[5])).length());
+            }
+        }
+
+        // Random queries across the span
+        std::mt19937_64 rng(42);
+        std::uniform_real_distribution<double> ut(eph.startTime(), eph.endTime());
+        std::vector<double> qt(queries);
+        std::vector<std::uint32_t> qb(queries);
+        for (std::size_t q = 0; q < queries; ++q) {
+            qt[q] = ut(rng);
+            qb[q] = static_cast<std::uint32_t>(rng() % n);
+        }
+
+        double sink = 0.0;
+        const double tState = bestOf(reps, [&] {
+            for (std::size_t q = 0; q < queries; ++q) {
+                vec3 p, v;
+                eph.state(qb[q], qt[q], p, v);
+                sink += p.x() + v.y();
+            }
+        });
+        const double tPos = bestOf(reps, [&] {
+            for (std::size_t q = 0; q < queries; ++q) sink += eph.position(qb[q], qt[q]).z();
+        });
+
+        const double rawBytes = static_cast<double>(frames.size() * sizeof(double));
+        const double ephBytes = static_cast<double>(std::filesystem::file_size(path));
+
+        std::cout << "ChebyshevEphemeris (" << n << " bodies, " << steps << " steps, "
+                  << eph.windows() << " windows x degree " << eph.degree() << ")\n"
+                  << " - size: " << ephBytes / 1024.0 << " KiB vs " << rawBytes / 1024.0
+                  << " KiB of raw frames (" << rawBytes / ephBytes << "x smaller)\n"
+                  << " - state():    " << tState * 1e9 / static_cast<double>(queries) << " ns/query\n"
+                  << " - position(): " << tPos * 1e9 / static_cast<double>(queries) << " ns/query"
+                  << (sink == 0.0 ? " " : "") << "\n";
+        for (std::size_t b = 0; b < n; ++b) {
+            std::cout << "   " << names[b] << ": max |dr| = " << maxDr[b] << " m, max |dv| = "
+                      << maxDv[b] << " m/s\n";
+            if (!(maxDr[b] <= 1.0 && maxDv[b] <= 1e-3)) ok = false;
+        }
+
+        // Even split, then 1 and 2 steps past it
+        for (int split : {2048, 2049, 2050}) {
+            ok = checkEphemerisSplit(frames, names, split, dt, path) && ok;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "❌ " << e.what() << "\n";
+        ok = false;
+    }
+    std::filesystem::remove(path);
+
+    if (!ok) {
+        std::cerr << "❌ Ephemeris does not reproduce the integrated frames\n";
+        return false;
+    }
+    std::cout << "✅ Ephemeris reproduces every frame (|dr| < 1 m, |dv| < 1 mm/s)\n";
+    return true;
+}
+
+// ============================================================
+//  Physics kernels and full runs (N x steps matrix)
+// ============================================================
+
+/********************
+ * struct Stats
+ * @brief: Summary of repeated timings, in seconds per call.
+ *********************/
+struct Stats {
+    double min = 0.0, median = 0.0, mean = 0.0, stddev = 0.0;
+    int    samples = 0;
+    long   callsPerSample = 1;
+};
+
+/********************
+ * measure
+ * @brief: Times fn() over `reps` samples. Each sample batches enough
+ *         calls to last at least minSeconds so that fast kernels are not
+ *         dominated by clock resolution.
+ * @param reps - number of samples
+ * @param minSeconds - target duration of one sample
+ * @param fn - one call of the kernel
+ * @return per-call statistics
+ *********************/
+template <typename Fn>
+static Stats measure(int reps, double minSeconds, Fn&& fn) {
+    // Calibrate: double the batch until one batch takes long enough
+    long calls = 1;
+    for (;;) {
+        const auto t0 = Clock::now();
+        for (long c = 0; c < calls; ++c) fn();
+        const double s = std::chrono::duration<double>(Clock::now() - t0).count();
+        if (s >= minSeconds || calls >= (1L << 30)) break;
+        calls = s <= 0.0 ? calls * 16
+                         : std::max(calls * 2, static_cast<long>(calls * minSeconds / s * 1.2));
+    }
+
+    std::vector<double> t(static_cast<std::size_t>(reps));
+    for (double& x : t) {
+        const auto t0 = Clock::now();
+        for (long c = 0; c < calls; ++c) fn();
+        x = std::chrono::duration<double>(Clock::now() - t0).count() / static_cast<double>(calls);
+    }
+
+    Stats st;
+    st.samples = reps;
+    st.callsPerSample = calls;
+    std::sort(t.begin(), t.end());
+    st.min = t.front();
+    st.median = (t.size() % 2) ? t[t.size() / 2] : 0.5 * (t[t.size() / 2 - 1] + t[t.size() / 2]);
+    for (double x : t) st.mean += x;
+    st.mean /= static_cast<double>(t.size());
+    for (double x : t) st.stddev += (x - st.mean) * (x - st.mean);
+    st.stddev = t.size() > 1 ? std::sqrt(st.stddev / static_cast<double>(t.size() - 1)) : 0.0;
+    return st;
+}
+
+/********************
+ * statsJson
+ * @brief: Stats as a JSON object in nanoseconds per call.
+ *********************/
+static nlohmann::json statsJson(const Stats& s) {
+    return {{"min_ns", s.min * 1e9},       {"median_ns", s.median * 1e9},
+            {"mean_ns", s.mean * 1e9},     {"stddev_ns", s.stddev * 1e9},
+            {"samples", s.samples},        {"calls_per_sample", s.callsPerSample}};
+}
+
+/********************
+ * makeNBodySystem
+ * @brief: A central star with n-1 light planets on circular orbits between
+ *         0.4 and 40 AU (random phases, small inclinations). Stable over
+ *         the benchmark horizons, so timings do not depend on close
+ *         encounters. Names avoid Sun/Earth/Moon so eclipse logging stays off.
+ * @param n - total number of bodies (>= 2)
+ *********************/
+static std::vector<CelestialBody> makeNBodySystem(std::size_t n) {
+    using namespace physics::constants;
+
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> logR(std::log(0.4), std::log(40.0));
+    std::uniform_real_distribution<double> angle(0.0, 2.0 * M_PI);
+    std::uniform_real_distribution<double> tilt(-0.02, 0.02);
+
+    std::vector<CelestialBody> bodies;
+    bodies.reserve(n);
+    bodies.emplace_back("Star", M_SUN, 0, 0, 0, 0, 0, 0);
+    for (std::size_t i = 1; i < n; ++i) {
+        const double r = std::exp(logR(rng)) * AU;
+        const double v = std::sqrt(G * M_SUN / r);
+        const double a = angle(rng), inc = tilt(rng);
+        bodies.emplace_back("P" + std::to_string(i), 1e-6 * M_SUN,
+                            r * std::cos(a), r * std::sin(a), r * std::sin(a) * inc,
+                            -v * std::sin(a), v * std::cos(a), 0.0);
+    }
+    return bodies;
+}
+
+/********************
+ * QuietStdout
+ * @brief: Discards std::cout for its lifetime (runSimulation's summary).
+ *********************/
+struct QuietStdout {
+    struct NullBuf : std::streambuf {
+        int overflow(int c) override { return c; }
+    } sink;
+    std::streambuf* saved = std::cout.rdbuf(&sink);
+    ~QuietStdout() { std::cout.rdbuf(saved); }
+};
+
+/********************
+ * benchKernels
+ * @brief: Times updateAccelerations, rk4Step and physics::compute for each
+ *         N, plus computeSolarEclipse once (it is N-independent).
+ *         Reports ns per call, ns per pair interaction and RK4 steps/s.
+ * @param ns - body counts
+ * @param reps - samples per kernel
+ * @param out - JSON array that receives one record per (kernel, N)
+ *********************/
+static bool benchKernels(const std::vector<std::size_t>& ns, int reps, nlohmann::json& out) {
+    const double dt = 3600.0;
+    double sink = 0.0;
+
+    auto record = [&](const char* kernel, std::size_t n, const Stats& s, double pairs) {
+        nlohmann::json r = {{"kernel", kernel}, {"n", n}, {"time", statsJson(s)}};
+        if (pairs > 0.0) r["ns_per_pair"] = s.median * 1e9 / pairs;
+        out.push_back(std::move(r));
+    };
+
+    std::cout << "Physics kernels (median of " << reps << " samples, +- stddev, backend "
+              << kernels::describe() << ")\n"
+              << "      N  kernel                  ns/call    +-%   ns/pair      steps/s\n";
+    auto row = [&](std::size_t n, const char* kernel, const Stats& s, double pairs, double stepsPerSec) {
+        char perPair[32] = "-", rate[32] = "-", line[160];
+        if (pairs > 0.0) std::snprintf(perPair, sizeof(perPair), "%.3f", s.median * 1e9 / pairs);
+        if (stepsPerSec > 0.0) std::snprintf(rate, sizeof(rate), "%.0f", stepsPerSec);
+        std::snprintf(line, sizeof(line), "%7zu  %-20s %11.1f %6.1f %9s %12s\n",
+                      n, kernel, s.median * 1e9, 100.0 * s.stddev / s.mean, perPair, rate);
+        std::cout << line;
+    };
+
+    for (std::size_t n : ns) {
+        std::vector<CelestialBody> bodies = makeNBodySystem(n);
+        const double pairs = 0.5 * static_cast<double>(n) * static_cast<double>(n - 1);
+
+        const Stats acc = measure(reps, 0.02, [&] { updateAccelerations(bodies); });
+        sink += bodies.back().acceleration.x();
+        row(n, "updateAccelerations", acc, pairs, 0.0);
+        record("updateAccelerations", n, acc, pairs);
+
+        // rk4Step advances the state; the orbits are stable so that is harmless
+        const Stats rk4 = measure(reps, 0.02, [&] { rk4Step(bodies, dt); });
+        row(n, "rk4Step", rk4, 4.0 * pairs, 1.0 / rk4.median);
+        record("rk4Step", n, rk4, 4.0 * pairs);
+        out.back()["steps_per_sec"] = 1.0 / rk4.median;
+
+        const Stats cons = measure(reps, 0.02, [&] { sink += physics::compute(bodies).total_energy; });
+        row(n, "physics::compute", cons, pairs, 0.0);
+        record("physics::compute", n, cons, pairs);
+    }
+
+    const EclipseSamples s = makeEclipseSamples(1024);
+    std::size_t i = 0;
+    const Stats ecl = measure(reps, 0.02, [&] {
+        sink += computeSolarEclipse(vec3(s.sx[i], s.sy[i], s.sz[i]), vec3(s.ex[i], s.ey[i], s.ez[i]),
+                                    vec3(s.mx[i], s.my[i], s.mz[i])).umbraRadius;
+        i = (i + 1) & 1023;
+    });
+    row(3, "computeSolarEclipse", ecl, 0.0, 0.0);
+    record("computeSolarEclipse", 3, ecl, 0.0);
+
+    if (!std::isfinite(sink)) {
+        std::cerr << "❌ Kernel results are not finite\n";
+        return false;
+    }
+    return true;
+}
+
+/********************
+ * benchFixed
+ * @brief: rk4Step (specialized on N) vs. rk4StepGeneric for every N with
+ *         a fixed-N stepper, and a check that both trajectories agree
+ *         after 1000 steps.
+ * @param reps - samples per kernel
+ * @param out - JSON array that receives one record per N
+ * @return true if every N agrees to 1e-9 relative position error
+ *********************/
+static bool benchFixed(int reps, nlohmann::json& out) {
+    const double dt = 3600.0;
+    bool ok = true;
+
+    std::cout << "Fixed-N RK4 steppers (median of " << reps << " samples, backend "
+              << kernels::active().name << ")\n"
+              << "      N   generic ns/step     fixed ns/step   speedup   max |dr|/|r|\n";
+    for (std::size_t n = kernels::FIXED_MIN_N; n <= kernels::FIXED_MAX_N; ++n) {
+        std::vector<CelestialBody> a = makeNBodySystem(n), b = a;
+
+        const Stats generic = measure(reps, 0.02, [&] { rk4StepGeneric(a, dt); });
+        const Stats fixed   = measure(reps, 0.02, [&] { rk4Step(b, dt); });
+
+        // Same start, 1000 steps each way
+        a = b = makeNBodySystem(n);
+        for (int i = 0; i < 1000; ++i) {
+            rk4StepGeneric(a, dt);
+            rk4Step(b, dt);
+        }
+        double maxRel = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const double r = std::max(a[i].position.length(), 1.0);
+            maxRel = std::max(maxRel, (a[i].position - b[i].position).length() / r);
+        }
+        ok = ok && maxRel < 1e-9;
+
+        const double speedup = generic.median / fixed.median;
+        char line[160];
+        std::snprintf(line, sizeof(line), "%7zu %17.1f %17.1f %8.2fx %14.2e\n", n,
+                      generic.median * 1e9, fixed.median * 1e9, speedup, maxRel);
+        std::cout << line;
+
+        out.push_back({{"kernel", "rk4Step_fixed"}, {"n", n}, {"time", statsJson(fixed)},
+                       {"generic_time", statsJson(generic)}, {"speedup", speedup},
+                       {"max_rel_position_diff", maxRel}});
+    }
+
+    if (!ok) {
+        std::cerr << "❌ Fixed-N and generic steppers disagree\n";
+        return false;
+    }
+    std::cout << "✅ Fixed-N steppers match the generic path\n";
+    return true;
+}
+
+/********************
+ * benchRun
+ * @brief: Times full runSimulation calls (CSV output to a temp file,
+ *         conservation checks included) over an N x steps matrix.
+ * @param ns - body counts
+ * @param stepsList - step counts
+ * @param reps - runs per cell
+ * @param out - JSON array that receives one record per cell
+ *********************/
+static bool benchRun(const std::vector<std::size_t>& ns, const std::vector<int>& stepsList,
+                     int reps, nlohmann::json& out) {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "orbit_bench_run.csv").string();
+    const double dt = 3600.0;
+
+    std::cout << "runSimulation (median of " << reps << " runs, CSV to " << path << ")\n"
+              << "      N    steps       ms/run    +-%      steps/s   ns/pair/step\n";
+    for (std::size_t n : ns) {
+        const std::vector<CelestialBody> initial = makeNBodySystem(n);
+        const double pairs = 0.5 * static_cast<double>(n) * static_cast<double>(n - 1);
+
+        for (int steps : stepsList) {
+            const Stats s = measure(reps, 0.0, [&] {
+                std::vector<CelestialBody> bodies = initial;
+                QuietStdout quiet;
+                runSimulation(bodies, steps, dt, path);
+            });
+            const double stepsPerSec = steps / s.median;
+            const double nsPerPair = s.median * 1e9 / (static_cast<double>(steps) * 4.0 * pairs);
+
+            char line[160];
+            std::snprintf(line, sizeof(line), "%7zu %8d %12.3f %6.1f %12.0f %14.3f\n", n, steps,
+                          s.median * 1e3, 100.0 * s.stddev / s.mean, stepsPerSec, nsPerPair);
+            std::cout << line;
+
+            out.push_back({{"kernel", "runSimulation"}, {"n", n}, {"steps", steps},
+                           {"time", statsJson(s)}, {"steps_per_sec", stepsPerSec},
+                           {"ns_per_pair", nsPerPair}});
+        }
+    }
+    std::filesystem::remove(path);
+    return true;
+}
+
+/********************
+ * parseList
+ * @brief: Parses a comma-separated list of positive integers ("2,8,32").
+ *********************/
+template <typename T>
+static std::vector<T> parseList(const std::string& s) {
+    std::vector<T> v;
+    std::size_t pos = 0;
+    while (pos < s.size()) {
+        std::size_t end = s.find(',', pos);
+        if (end == std::string::npos) end = s.size();
+        const long long x = std::stoll(s.substr(pos, end - pos));
+        if (x <= 0) throw std::invalid_argument("list entries must be positive");
+        v.push_back(static_cast<T>(x));
+        pos = end + 1;
+    }
+    return v;
+}
+
+/********************
+ * main
+ * @brief: Parses benchmark options and runs all benchmarks.
+ *********************/
+int main(int argc, char** argv) {
+    std::size_t samples = 1u << 22;
+    std::size_t bodies  = 200000;
+    std::size_t csvMb   = 1024;
+    int reps = 5;
+    std::string only, jsonPath;
+    std::vector<std::size_t> ns = {2, 3, 8, 32, 128, 512};
+    std::vector<std::size_t> runNs = {3, 32, 128};
+    std::vector<int> stepsList = {100, 1000};
+
+    const char* usage =
+        "Usage: orbit-bench [--samples N] [--bodies N] [--reps R]"
+        " [--only eclipse|loader|csv|horizons|ephemeris|kernels|fixed|run]\n"
+        "                   [--n 2,8,32] [--steps 100,1000] [--csv-mb MB] [--json FILE]\n";
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string a = argv[i];
+            if (a == "--samples" && i + 1 < argc) {
+                samples = std::stoull(argv[++i]);
+            }
+            else if (a == "--bodies" && i + 1 < argc) {
+                bodies = std::stoull(argv[++i]);
+            }
+            else if (a == "--reps" && i + 1 < argc) {
+                reps = std::max(1, std::stoi(argv[++i]));
+            }
+            else if (a == "--only" && i + 1 < argc) {
+                only = argv[++i];
+            }
+            else if (a == "--n" && i + 1 < argc) {
+                ns = runNs = parseList<std::size_t>(argv[++i]);
+            }
+            else if (a == "--steps" && i + 1 < argc) {
+                stepsList = parseList<int>(argv[++i]);
+            }
+            else if (a == "--csv-mb" && i + 1 < argc) {
+                csvMb = std::max<std::size_t>(1, std::stoull(argv[++i]));
+            }
+            else if (a == "--json" && i + 1 < argc) {
+                jsonPath = argv[++i];
+            }
+            else {
+                std::cerr << "Unknown option: " << a << "\n" << usage;
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception&) {
+        std::cerr << "❌ Invalid option value\n" << usage;
+        return 1;
+    }
+
+    nlohmann::json results = nlohmann::json::array();
+
+    bool ok = true;
+    if (only.empty() || only == "eclipse")   ok = benchEclipse(samples, reps) && ok;
+    if (only.empty() || only == "loader")    ok = benchLoader(bodies, reps) && ok;
+    if (only.empty() || only == "csv")       ok = benchTrajectoryCSV(csvMb, reps) && ok;
+    if (only.empty() || only == "horizons")  ok = benchHorizons(bodies, reps) && ok;
+    if (only.empty() || only == "ephemeris") ok = benchEphemeris(samples, reps) && ok;
+    if (only.empty() || only == "kernels")   ok = benchKernels(ns, reps, results) && ok;
+    if (only.empty() || only == "fixed")     ok = benchFixed(reps, results) && ok;
+    if (only.empty() || only == "run")       ok = benchRun(runNs, stepsList, reps, results) && ok;
+
+    if (!jsonPath.empty()) {
+        nlohmann::json doc = {
+            {"schema", "orbit-bench/1"},
+            {"timestamp", static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+                              std::chrono::system_clock::now().time_since_epoch()).count())},
+#if defined(__VERSION__)
+            {"compiler", __VERSION__},
+#endif
+#ifdef NDEBUG
+            {"build", "release"},
+#else
+            {"build", "debug"},
+#endif
+            {"kernel_backend", kernels::active().name},
+            {"results", results}};
+        std::ofstream f(jsonPath);
+        f << doc.dump(2) << "\n";
+        if (!f) {
+            std::cerr << "❌ Could not write " << jsonPath << "\n";
+            return 1;
+        }
+        std::cout << "✅ Results written to " << jsonPath << "\n";
+    }
+    return ok ? 0 : 1;
+}
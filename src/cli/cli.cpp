@@ -62,9 +62,102 @@ CLIOptions parseCLI(int argc, char** argv) {
         else if (a == "--dt" && i + 1 < argc) {
             opt.dt = std::stod(argv[++i]);
         }
+        else if (a == "--recenter-every" && i + 1 < argc) {
+            opt.recenterEvery = std::stoi(argv[++i]);
+        }
         else if (a == "--output" && i + 1 < argc) {
             opt.output = argv[++i];
         }
+        else if (a == "--trajectory" && i + 1 < argc) {
+            opt.trajectory = argv[++i];
+        }
+        else if (a == "--ephemeris" && i + 1 < argc) {
+            opt.ephemeris = argv[++i];
+        }
+        else if (a == "--ephem-window" && i + 1 < argc) {
+            opt.ephemWindow = std::stoi(argv[++i]);
+        }
+        else if (a == "--ephem-degree" && i + 1 < argc) {
+            opt.ephemDegree = std::stoi(argv[++i]);
+        }
+        else if (a == "--ephem-tolerance" && i + 1 < argc) {
+            opt.ephemTolerance = std::stod(argv[++i]);
+        }
+        else if (a == "--profile") {
+            opt.profile = true;
+        }
+        else if (a == "--progress") {
+            opt.progress = 1;
+        }
+        else if (a == "--no-progress") {
+            opt.progress = 0;
+        }
+        else if (a == "--progress-interval" && i + 1 < argc) {
+            opt.progressInterval = std::stod(argv[++i]);
+        }
+        else if (a == "--status-file" && i + 1 < argc) {
+            opt.statusFile = argv[++i];
+        }
+        else if (a == "--profile-trace" && i + 1 < argc) {
+            opt.profileTrace = argv[++i];
+            opt.profile = true;
+        }
+
+        // ----- SHADOW Options -----
+        else if (a == "--input" && i + 1 < argc) {
+            opt.input = argv[++i];
+        }
+        else if (a == "--format" && i + 1 < argc) {
+            opt.format = argv[++i];
+        }
+        else if (a == "--width" && i + 1 < argc) {
+            opt.width = std::stoi(argv[++i]);
+        }
+        else if (a == "--height" && i + 1 < argc) {
+            opt.height = std::stoi(argv[++i]);
+        }
+        else if (a == "--every" && i + 1 < argc) {
+            opt.every = std::stoi(argv[++i]);
+        }
+        else if (a == "--threads" && i + 1 < argc) {
+            opt.threads = std::stoi(argv[++i]);
+        }
+
+        // ----- CONVERT Options -----
+        else if (a == "--to" && i + 1 < argc) {
+            opt.convertTo = argv[++i];
+        }
+
+        // ----- COMPARE Options -----
+        else if (a == "--reference" && i + 1 < argc) {
+            opt.reference = argv[++i];
+        }
+        else if (a == "--epoch" && i + 1 < argc) {
+            opt.epoch = argv[++i];
+        }
+
+        // ----- SERVE / QUERY / LOADTEST Options -----
+        else if (a == "--socket" && i + 1 < argc) {
+            opt.socketPath = argv[++i];
+        }
+        else if (a == "--op" && i + 1 < argc) {
+            opt.queryOp = argv[++i];
+        }
+        else if (a == "--time" && i + 1 < argc) {
+            opt.queryTime = std::stod(argv[++i]);
+        }
+        else if (a == "--connections" && i + 1 < argc) {
+            opt.connections = std::stoi(argv[++i]);
+        }
+        else if (a == "--batch" && i + 1 < argc) {
+            opt.batch = std::stoi(argv[++i]);
+        }
+        else if (a == "--pipeline" && i + 1 < argc) {
+            opt.pipeline = std::stoi(argv[++i]);
+        }
+        else if (a == "--seconds" && i + 1 < argc) {
+            opt.seconds = std::stod(argv[++i]);
+        }
 
         // ----- FETCH Options -----
         else if (a == "--body" && i + 1 < argc) {
@@ -82,11 +175,29 @@ CLIOptions parseCLI(int argc, char** argv) {
         else if (a == "--step" && i + 1 < argc) {
             opt.fetchStep = argv[++i];
         }
+        else if (a == "--bodies" && i + 1 < argc) {
+            opt.fetchBodies = argv[++i];
+        }
+        else if (a == "--cache" && i + 1 < argc) {
+            opt.cacheDir = argv[++i];
+        }
+        else if (a == "--no-cache") {
+            opt.noCache = true;
+        }
+        else if (a == "--horizons-url" && i + 1 < argc) {
+            opt.horizonsUrl = argv[++i];
+        }
+        else if (a == "--parallel" && i + 1 < argc) {
+            opt.parallel = std::stoi(argv[++i]);
+        }
         else if (a == "--verbose") {
             opt.verbose = true;
         } else if (a == "--post") {
             opt.usePost = true;
         }
+        else if (a == "--emit-system") {
+            opt.emitSystem = true;
+        }
         else if (a == "--normalize") {
             opt.normalize = true;
         }
@@ -109,10 +220,22 @@ void printGlobalHelp() {
               << "  help                     Show this help message\n"
               << "  list                     List available system JSON files\n"
               << "  info     --system FILE   Show information about a system\n"
-              << "  validate --system FILE   Validate a system JSON file\n"
+              << "  validate --system FILE   Validate a system file (JSON or snapshot)\n"
               << "  run      --system FILE --steps N --dt T\n"
               << "                           Run a simulation\n"
-              << "  fetch    [options]       Fetch ephemeris from NASA Horizons\n\n"
+              << "  fetch    [options]       Fetch ephemeris from NASA Horizons\n"
+              << "  shadow   --input FILE --output DIR\n"
+              << "                           Render eclipse shadow maps from a trajectory\n"
+              << "  convert  --system FILE --to snapshot|json --output FILE\n"
+              << "                           Convert between JSON and binary snapshots\n"
+              << "           (or --trajectory FILE --to ephemeris)\n"
+              << "  compare  --reference FILES --trajectory FILE\n"
+              << "                           Measure trajectory error against HORIZONS\n"
+              << "  serve    --input FILE [--socket PATH]\n"
+              << "                           Answer position/velocity/eclipse queries\n"
+              << "  query    --body NAME --time T [--socket PATH]\n"
+              << "                           Ask a running server for one state\n"
+              << "  loadtest [--socket PATH] Benchmark a running server\n\n"
               << "For command-specific help:\n"
               << "  orbit-sim <command> --help\n\n";
 }
@@ -121,10 +244,24 @@ void printCommandHelp(const std::string& cmd) {
     if (cmd == "run") {
         std::cout << "orbit-sim run — Execute a simulation\n\n"
                   << "Options:\n"
-                  << "  --system FILE    Path to system JSON\n"
+                  << "  --system FILE    Path to system JSON or binary snapshot\n"
                   << "  --steps N        Number of integration steps\n"
                   << "  --dt T           Timestep in seconds\n\n"
-                  << "  --normalize       Shift system so COM=0 and net momentum=0\n\n"
+                  << "  --normalize       Shift system so COM=0 and net momentum=0\n"
+                  << "  --recenter-every K Remove barycenter drift every K steps\n"
+                  << "  --trajectory FILE Also write a binary trajectory (positions +\n"
+                  << "                    velocities, full precision) for `compare`\n"
+                  << "  --ephemeris FILE  Also write a Chebyshev-compressed ephemeris\n"
+                  << "  --ephem-window K  Steps per Chebyshev window (default 64)\n"
+                  << "  --ephem-degree N  Chebyshev degree per window (default 12)\n"
+                  << "  --ephem-tolerance M  Fail if the fit misses a step by more than\n"
+                  << "                    M meters (default 1)\n"
+                  << "  --progress        Always report progress on stderr (default: only\n"
+                  << "                    when stderr is a terminal; --no-progress disables)\n"
+                  << "  --progress-interval S  Seconds between reports (default 2)\n"
+                  << "  --status-file F   Write JSON Lines status (steps/s, ETA, dE_rel)\n"
+                  << "  --profile         Print a per-phase timing breakdown\n"
+                  << "  --profile-trace F Also write Chrome trace-event JSON (Perfetto)\n\n"
                   << "Example:\n"
                   << "  orbit-sim run --system systems/earth_moon.json --steps 8766 --dt 3600\n";
         return;
@@ -162,7 +299,101 @@ void printCommandHelp(const std::string& cmd) {
                   << "  --start YYYY-MM-DD\n"
                   << "  --stop  YYYY-MM-DD\n"
                   << "  --step \"6 h\"       Step size\n"
-                  << "  --output FILE      Where to save results\n\n";
+                  << "  --output FILE      Where to save results\n\n"
+                  << "Several bodies (concurrent, cached):\n"
+                  << "  --bodies A,B,...   NAIF IDs, e.g. 10,199,299,399,301; --output is a directory\n"
+                  << "                     receiving <ID>.txt per body\n"
+                  << "  --parallel N       Max simultaneous connections (default 4)\n"
+                  << "  --cache DIR        Cache directory (default ~/.cache/orbit-sim/horizons)\n"
+                  << "  --no-cache         Always hit the network\n"
+                  << "  --horizons-url URL Endpoint override (e.g. a local stub server)\n\n"
+                  << "System mode:\n"
+                  << "  --emit-system      Write a system JSON from the first VECTORS row of each body\n"
+                  << "  --bodies A,B,...   Bodies to fetch (NAIF IDs), e.g. 10,399,301\n"
+                  << "  --start DATE       Epoch of the initial conditions\n"
+                  << "  --stop  DATE       Any later date (default step: 1 interval)\n"
+                  << "  --input F1,F2,...  Offline: parse saved HORIZONS replies instead of fetching\n"
+                  << "                     (text from 'fetch' or raw API JSON)\n\n"
+                  << "Positions/velocities are converted from km, km/s to m, m/s; masses come from\n"
+                  << "the header GM, or a built-in table for planet barycenters.\n\n"
+                  << "Example:\n"
+                  << "  orbit-sim fetch --emit-system --bodies 10,399,301 --start 2025-01-01 --stop 2025-01-02 \\\n"
+                  << "                  --output systems/sem_2025.json\n";
+        return;
+    }
+
+    if (cmd == "shadow") {
+        std::cout << "orbit-sim shadow — Ray-trace the Moon's shadow on Earth\n\n"
+                  << "Options:\n"
+                  << "  --input FILE       Trajectory from 'orbit-sim run' (Sun, Earth, Moon): the\n"
+                  << "                     .otraj (--trajectory, preferred) or a full-precision CSV\n"
+                  << "  --output DIR       Directory for the image sequence\n"
+                  << "  --format FMT       ppm (shaded RGB, default), pgm (8-bit obscuration),\n"
+                  << "                     pfm (float obscuration)\n"
+                  << "  --width W          Map width  in pixels (default 1920)\n"
+                  << "  --height H         Map height in pixels (default 1080)\n"
+                  << "  --every N          Render every N-th trajectory row (default 1)\n"
+                  << "  --threads T        Worker threads (default: all cores)\n\n"
+                  << "Example:\n"
+                  << "  orbit-sim shadow --input build/orbit_three_body.otraj --output build/shadow --every 10\n";
+        return;
+    }
+
+    if (cmd == "convert") {
+        std::cout << "orbit-sim convert — Convert a system file\n\n"
+                  << "Options:\n"
+                  << "  --system FILE      Input system (JSON or snapshot, detected by content)\n"
+                  << "  --to FORMAT        snapshot (binary, mmap-able), json or ephemeris\n"
+                  << "  --output FILE      Destination file\n\n"
+                  << "Snapshots load without parsing; run, info and validate accept\n"
+                  << "either format.\n\n"
+                  << "--to ephemeris fits a Chebyshev ephemeris to a binary trajectory\n"
+                  << "instead (--trajectory FILE, optional --ephem-window/--ephem-degree/--ephem-tolerance).\n\n"
+                  << "Example:\n"
+                  << "  orbit-sim convert --system systems/solar_system.json --to snapshot --output build/solar_system.osnap\n";
+        return;
+    }
+
+    if (cmd == "compare") {
+        std::cout << "orbit-sim compare — Measure trajectory error against HORIZONS\n\n"
+                  << "Options:\n"
+                  << "  --reference LIST   Comma-separated HORIZONS VECTORS files; prefix\n"
+                  << "                     with Body= to match a file to a body by hand\n"
+                  << "  --trajectory FILE  Binary trajectory (run --trajectory) or CSV\n"
+                  << "  --dt T             Step size of a CSV trajectory (seconds)\n"
+                  << "  --epoch DATE       Epoch of t = 0 (YYYY-MM-DD[ hh:mm:ss] or JD);\n"
+                  << "                     defaults to the epoch stored in the trajectory\n"
+                  << "  --output FILE      Also write per-epoch errors as CSV\n\n"
+                  << "The simulation is interpolated to each reference epoch (cubic\n"
+                  << "Hermite) while streaming the trajectory. References must use the\n"
+                  << "same center as the initial conditions (do not --normalize).\n\n"
+                  << "Example:\n"
+                  << "  orbit-sim run --system build/inner.json --steps 720 --dt 3600 --trajectory build/inner.otraj\n"
+                  << "  orbit-sim compare --reference build/hz/399.txt,build/hz/301.txt --trajectory build/inner.otraj\n";
+        return;
+    }
+
+    if (cmd == "serve" || cmd == "query" || cmd == "loadtest") {
+        std::cout << "orbit-sim serve — Local query daemon over a precomputed ephemeris\n\n"
+                  << "serve options:\n"
+                  << "  --input FILE       Chebyshev ephemeris (run --ephemeris) or binary\n"
+                  << "                     trajectory (fitted at startup)\n"
+                  << "  --socket PATH      Unix socket (default /tmp/orbit-sim.sock)\n"
+                  << "  --threads N        Worker threads (default: all cores)\n\n"
+                  << "query options:\n"
+                  << "  --body NAME        Body to look up\n"
+                  << "  --time T           Seconds since the ephemeris epoch\n"
+                  << "  --op OP            state (default), position or eclipse\n\n"
+                  << "loadtest options:\n"
+                  << "  --connections N    Concurrent connections (default 4)\n"
+                  << "  --batch N          Queries per request (default 256)\n"
+                  << "  --pipeline N       Requests in flight per connection (default 4)\n"
+                  << "  --seconds S        Duration (default 5)\n"
+                  << "  --op OP            state (default), position or eclipse\n\n"
+                  << "Example:\n"
+                  << "  orbit-sim serve --input build/solar_10y.oeph &\n"
+                  << "  orbit-sim query --body Moon --time 86400\n"
+                  << "  orbit-sim loadtest --connections 8 --batch 512\n";
         return;
     }
 
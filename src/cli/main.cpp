@@ -5,10 +5,16 @@
  * Purpose:
  *    Entry point for orbit-sim CLI application.
  *    Supports:
- *      - Running N-body simulations from JSON system files
+ *      - Running N-body simulations from JSON system files or snapshots
+ *      - Converting system files to/from binary snapshots
  *      - Printing basic system info
  *      - Listing available system definitions
  *      - Fetching raw ephemeris from NASA HORIZONS
+ *      - Building system JSON from HORIZONS VECTORS tables
+ *      - Rendering eclipse shadow maps from trajectory output
+ *      - Comparing trajectories against HORIZONS reference ephemerides
+ *      - Fitting Chebyshev ephemerides to binary trajectories
+ *      - Serving ephemeris queries over a Unix socket (serve/query/loadtest)
  *********************/
 
 
@@ -16,12 +22,16 @@
 
 /********************
  * printSystemInfo
- * @brief: Prints details of bodies loaded from JSON
+ * @brief: Prints details of bodies loaded from JSON or a snapshot
  *********************/
 void printSystemInfo(const std::string& path) {
     try {
-        auto bodies = loadSystemFromJSON(path);
-        std::cout << "System file: " << path << "\n";
+        SystemMetadata meta;
+        auto bodies = loadSystem(path, &meta);
+        std::cout << "System file: " << path
+                  << (isSystemSnapshot(path) ? " (binary snapshot)" : "") << "\n";
+        if (!meta.name.empty())  std::cout << "Name:  " << meta.name  << "\n";
+        if (!meta.epoch.empty()) std::cout << "Epoch: " << meta.epoch << "\n";
         std::cout << "Bodies:\n";
 
         for (const auto& b : bodies) {
@@ -38,7 +48,7 @@ void printSystemInfo(const std::string& path) {
 
 /********************
  * listSystems
- * @brief: Lists JSON files inside the "systems" directory.
+ * @brief: Lists JSON files and snapshots inside the "systems" directory.
  *********************/
 void listSystems(const std::string& dir = "systems") {
     std::cout << "Available systems in \"" << dir << "\":\n";
@@ -49,12 +59,137 @@ void listSystems(const std::string& dir = "systems") {
     }
 
     for (const auto& entry : std::filesystem::directory_iterator(dir)) {
-        if (entry.path().extension() == ".json") {
+        const auto ext = entry.path().extension();
+        if (ext == ".json" || ext == ".osnap") {
             std::cout << " - " << entry.path().string() << "\n";
         }
     }
 }
 
+/********************
+ * splitList
+ * @brief: Splits "a,b,c" into {"a","b","c"} (empty items dropped).
+ *********************/
+static std::vector<std::string> splitList(const std::string& s) {
+    std::vector<std::string> items;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+/********************
+ * fetchBodiesBatch
+ * @brief: Fetches one VECTORS ephemeris per body ID concurrently, using
+ *         the on-disk cache unless --no-cache is given.
+ * @param defaultStep - step size when --step is not given
+ * @return true if every body was fetched
+ *********************/
+static bool fetchBodiesBatch(const CLIOptions& opt,
+                             const std::vector<std::string>& ids,
+                             const std::string& defaultStep,
+                             std::vector<std::string>& texts)
+{
+    std::vector<HorizonsFetchOptions> requests;
+    for (const std::string& id : ids) {
+        HorizonsFetchOptions hopt;
+        hopt.command    = id;
+        hopt.center     = opt.fetchCenter.empty() ? "@0" : opt.fetchCenter;
+        hopt.start_time = opt.fetchStart;
+        hopt.stop_time  = opt.fetchStop;
+        hopt.step_size  = opt.fetchStep.empty() ? defaultStep : opt.fetchStep;
+        requests.push_back(hopt);
+    }
+
+    CurlTransportOptions topt;
+    topt.endpoint = opt.horizonsUrl;
+    topt.usePost  = opt.usePost;
+    topt.verbose  = opt.verbose;
+    if (opt.parallel > 0) topt.maxConnections = opt.parallel;
+    CurlMultiTransport transport(topt);
+
+    HorizonsCache cache(opt.cacheDir.empty() ? HorizonsCache::defaultDirectory() : opt.cacheDir);
+
+    std::cout << "Fetching " << ids.size() << " bodies from HORIZONS ("
+              << topt.maxConnections << " connections"
+              << (opt.noCache ? ", no cache" : ", cache: " + cache.directory()) << ")\n";
+
+    return fetchHorizonsBatch(requests, transport, opt.noCache ? nullptr : &cache, texts);
+}
+
+/********************
+ * emitHorizonsSystem
+ * @brief: Builds a system JSON from HORIZONS VECTORS ephemerides, either
+ *         fetched (one request per --body entry) or read from saved
+ *         replies (--input).
+ * @return process exit code
+ *********************/
+static int emitHorizonsSystem(const CLIOptions& opt) {
+    if (opt.output.empty()) {
+        std::cerr << "❌ Must specify --output <system.json>\n";
+        return 1;
+    }
+
+    try {
+        std::vector<HorizonsEphemeris> ephems;
+
+        if (!opt.input.empty()) {
+            // ---- offline: saved replies ----
+            for (const std::string& path : splitList(opt.input)) {
+                std::ifstream in(path, std::ios::binary);
+                if (!in) {
+                    std::cerr << "❌ Could not open HORIZONS file: " << path << "\n";
+                    return 1;
+                }
+                std::ostringstream buf;
+                buf << in.rdbuf();
+                ephems.push_back(parseHorizonsVectors(extractHorizonsResult(buf.str())));
+                std::cout << " - " << path << ": " << ephems.back().targetName << "\n";
+            }
+        }
+        else {
+            // ---- online: all bodies in one concurrent batch ----
+            const std::vector<std::string> ids =
+                splitList(opt.fetchBodies.empty() ? opt.fetchBody : opt.fetchBodies);
+            if (ids.empty()) {
+                std::cerr << "❌ Must specify --bodies <ID,ID,...> or --input <file,...>\n";
+                return 1;
+            }
+            if (opt.fetchStart.empty() || opt.fetchStop.empty()) {
+                std::cerr << "❌ Must specify --start <date> and --stop <date>\n";
+                return 1;
+            }
+
+            std::vector<std::string> texts;
+            if (!fetchBodiesBatch(opt, ids, "1", texts)) {
+                return 1;
+            }
+            for (std::size_t i = 0; i < ids.size(); ++i) {
+                ephems.push_back(parseHorizonsVectors(texts[i]));
+                std::cout << " - " << ids[i] << ": " << ephems.back().targetName << "\n";
+            }
+        }
+
+        SystemMetadata meta;
+        auto bodies = assembleHorizonsSystem(ephems, meta);
+
+        if (!writeSystemJSON(opt.output, bodies, meta)) {
+            std::cerr << "❌ Could not write " << opt.output << "\n";
+            return 1;
+        }
+
+        std::cout << "✅ System with " << bodies.size() << " bodies at "
+                  << meta.epoch << " saved to: " << opt.output << "\n";
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "❌ Could not build system: " << e.what() << "\n";
+        return 1;
+    }
+}
+
 /********************
  * main
  * @brief: Parses CLI arguments and performs actions.
@@ -102,6 +237,40 @@ int main(int argc, char** argv) {
     // ----- FETCH (NASA HORIZONS) -----
     if (opt.command == "fetch") {
 
+        if (opt.emitSystem) {
+            return emitHorizonsSystem(opt);
+        }
+
+        // ----- several bodies: concurrent, cached, one file per body -----
+        if (!opt.fetchBodies.empty()) {
+            if (opt.fetchStart.empty() || opt.fetchStop.empty()) {
+                std::cerr << "❌ Must specify --start <date> and --stop <date>\n";
+                return 1;
+            }
+            if (opt.output.empty()) {
+                std::cerr << "❌ Must specify --output <directory>\n";
+                return 1;
+            }
+
+            const std::vector<std::string> ids = splitList(opt.fetchBodies);
+            std::vector<std::string> texts;
+            if (!fetchBodiesBatch(opt, ids, "1 d", texts)) {
+                return 1;
+            }
+
+            std::filesystem::create_directories(opt.output);
+            for (std::size_t i = 0; i < ids.size(); ++i) {
+                const std::string path = (std::filesystem::path(opt.output) / (ids[i] + ".txt")).string();
+                std::ofstream out(path);
+                if (!(out << texts[i])) {
+                    std::cerr << "❌ Could not write " << path << "\n";
+                    return 1;
+                }
+            }
+            std::cout << "✅ " << ids.size() << " HORIZONS ephemerides saved to: " << opt.output << "\n";
+            return 0;
+        }
+
         if (opt.fetchBody.empty()) {
             std::cerr << "❌ Must specify --body <ID or NAME>\n";
             return 1;
@@ -141,6 +310,223 @@ int main(int argc, char** argv) {
         return ok ? 0 : 1;
     }
 
+    // ----- SHADOW MAPS -----
+    if (opt.command == "shadow") {
+        if (opt.input.empty()) {
+            std::cerr << "❌ Must specify --input <trajectory.csv>\n";
+            return 1;
+        }
+        if (opt.output.empty()) {
+            std::cerr << "❌ Must specify --output <directory>\n";
+            return 1;
+        }
+
+        ShadowExportOptions sopt;
+        sopt.inputPath = opt.input;
+        sopt.outputDir = opt.output;
+        if (!opt.format.empty()) sopt.format = opt.format;
+        if (opt.every   > 0) sopt.every         = opt.every;
+        if (opt.width   > 0) sopt.map.width     = opt.width;
+        if (opt.height  > 0) sopt.map.height    = opt.height;
+        if (opt.threads > 0) sopt.map.threads   = static_cast<unsigned>(opt.threads);
+
+        std::cout << "Rendering eclipse shadow maps:\n"
+                  << " - Input:  " << sopt.inputPath << "\n"
+                  << " - Output: " << sopt.outputDir << "\n"
+                  << " - Size:   " << sopt.map.width << "x" << sopt.map.height << "\n"
+                  << " - Format: " << sopt.format << "\n";
+
+        bool ok = exportShadowMaps(sopt);
+        return ok ? 0 : 1;
+    }
+
+    // ----- CONVERT -----
+    if (opt.command == "convert" && opt.convertTo == "ephemeris") {
+        if (opt.trajectory.empty() || opt.output.empty()) {
+            std::cerr << "❌ Must specify --trajectory <file.otraj> --output <file>\n";
+            return 1;
+        }
+
+        try {
+            TrajectoryBinaryReader reader(opt.trajectory);
+            ChebyshevFitOptions fit;
+            if (opt.ephemWindow > 0)  fit.windowSteps = opt.ephemWindow;
+            if (opt.ephemDegree >= 0) fit.degree      = opt.ephemDegree;
+            if (opt.ephemTolerance > 0) fit.tolerance = opt.ephemTolerance;
+
+            ChebyshevEphemerisWriter writer;
+            if (!writer.open(opt.output, reader.bodyNames(), reader.dt(), reader.epoch(), fit)) {
+                std::cerr << "❌ Could not write " << opt.output
+                          << " (or invalid --ephem-window/--ephem-degree)\n";
+                return 1;
+            }
+
+            TrajectoryFrame frame;
+            while (reader.next(frame)) writer.add(frame);
+            if (!writer.finish()) {
+                std::cerr << "❌ Ephemeris " << opt.output << ": " << writer.error() << "\n";
+                return 1;
+            }
+
+            std::cout << "✅ Wrote ephemeris " << opt.output << " (" << writer.windows()
+                      << " windows, degree " << fit.degree << ", max fit error "
+                      << writer.maxError() << " m)\n";
+        }
+        catch (const std::exception& e) {
+            std::cerr << "❌ Conversion failed: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    if (opt.command == "convert") {
+        if (opt.systemFile.empty()) {
+            std::cerr << "❌ Must specify --system <file>\n";
+            return 1;
+        }
+        if (opt.output.empty()) {
+            std::cerr << "❌ Must specify --output <file>\n";
+            return 1;
+        }
+        if (opt.convertTo != "snapshot" && opt.convertTo != "json") {
+            std::cerr << "❌ Must specify --to snapshot|json|ephemeris\n";
+            return 1;
+        }
+
+        try {
+            SystemMetadata meta;
+            auto bodies = loadSystem(opt.systemFile, &meta);
+
+            bool ok = (opt.convertTo == "snapshot")
+                      ? writeSystemSnapshot(opt.output, bodies, meta)
+                      : writeSystemJSON(opt.output, bodies, meta);
+            if (!ok) {
+                std::cerr << "❌ Could not write " << opt.output << "\n";
+                return 1;
+            }
+
+            std::cout << "✅ Wrote " << opt.convertTo << " " << opt.output
+                      << " (" << bodies.size() << " bodies)\n";
+        }
+        catch (const std::exception& e) {
+            std::cerr << "❌ Conversion failed: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // ----- COMPARE -----
+    if (opt.command == "compare") {
+        if (opt.reference.empty()) {
+            std::cerr << "❌ Must specify --reference <file[,file...]>\n";
+            return 1;
+        }
+        if (opt.trajectory.empty()) {
+            std::cerr << "❌ Must specify --trajectory <file>\n";
+            return 1;
+        }
+
+        CompareOptions copt;
+        copt.referencePaths = splitList(opt.reference);
+        copt.trajectoryPath = opt.trajectory;
+        copt.dt             = opt.dt;
+        copt.epoch          = opt.epoch;
+        copt.outputPath     = opt.output;
+
+        std::cout << "Comparing trajectory:\n"
+                  << " - Trajectory: " << copt.trajectoryPath << "\n"
+                  << " - References: " << copt.referencePaths.size() << " file(s)\n";
+
+        bool ok = compareTrajectory(copt);
+        return ok ? 0 : 1;
+    }
+
+    // ----- SERVE / QUERY / LOADTEST -----
+    if (opt.command == "serve") {
+        if (opt.input.empty()) {
+            std::cerr << "❌ Must specify --input <ephemeris.oeph|trajectory.otraj>\n";
+            return 1;
+        }
+
+        ServeOptions sopt;
+        sopt.inputPath = opt.input;
+        if (!opt.socketPath.empty()) sopt.socketPath = opt.socketPath;
+        if (opt.threads > 0)         sopt.threads    = static_cast<unsigned>(opt.threads);
+        if (opt.ephemWindow > 0)     sopt.fit.windowSteps = opt.ephemWindow;
+        if (opt.ephemDegree >= 0)    sopt.fit.degree      = opt.ephemDegree;
+        if (opt.ephemTolerance > 0)  sopt.fit.tolerance   = opt.ephemTolerance;
+
+        std::cout << "Starting query server:\n"
+                  << " - Input:   " << sopt.inputPath << "\n";
+
+        bool ok = runEphemerisServer(sopt);
+        return ok ? 0 : 1;
+    }
+
+    if (opt.command == "query" || opt.command == "loadtest") {
+        protocol::Op op = protocol::OP_STATE;
+        if (opt.queryOp == "position")     op = protocol::OP_POSITION;
+        else if (opt.queryOp == "eclipse") op = protocol::OP_ECLIPSE;
+        else if (!opt.queryOp.empty() && opt.queryOp != "state") {
+            std::cerr << "❌ Unknown --op: " << opt.queryOp << " (expected state, position or eclipse)\n";
+            return 1;
+        }
+        const std::string socketPath = opt.socketPath.empty() ? "/tmp/orbit-sim.sock" : opt.socketPath;
+
+        if (opt.command == "loadtest") {
+            LoadTestOptions lopt;
+            lopt.socketPath = socketPath;
+            lopt.op         = op;
+            if (opt.connections > 0) lopt.connections = opt.connections;
+            if (opt.batch > 0)       lopt.batch       = opt.batch;
+            if (opt.pipeline > 0)    lopt.pipeline    = opt.pipeline;
+            if (opt.seconds > 0)     lopt.seconds     = opt.seconds;
+
+            bool ok = runLoadTest(lopt);
+            return ok ? 0 : 1;
+        }
+
+        try {
+            EphemerisClient client(socketPath);
+            const EphemerisInfo info = client.info();
+
+            if (op == protocol::OP_ECLIPSE) {
+                std::vector<protocol::EclipseRecord> e;
+                client.eclipses({opt.queryTime}, e);
+                static const char* types[] = {"none", "total", "annular", "partial"};
+                std::cout << "t = " << opt.queryTime << " s: eclipse "
+                          << types[std::clamp(e[0].eclipseType, 0, 3)]
+                          << ", shadow center (" << e[0].shadow[0] << ", " << e[0].shadow[1]
+                          << ", " << e[0].shadow[2] << ") m\n";
+                return 0;
+            }
+
+            const int body = info.bodyIndex(opt.fetchBody);
+            if (body < 0) {
+                std::cerr << "❌ Unknown body: " << opt.fetchBody << " (server has";
+                for (const auto& b : info.bodies) std::cerr << " " << b;
+                std::cerr << ")\n";
+                return 1;
+            }
+
+            std::vector<double> s;
+            const std::vector<protocol::QueryRecord> q{{static_cast<std::uint32_t>(body), 0, opt.queryTime}};
+            if (op == protocol::OP_STATE) client.states(q, s);
+            else                          client.positions(q, s);
+
+            std::cout << opt.fetchBody << " at t = " << opt.queryTime << " s\n"
+                      << " - position: (" << s[0] << ", " << s[1] << ", " << s[2] << ") m\n";
+            if (op == protocol::OP_STATE) {
+                std::cout << " - velocity: (" << s[3] << ", " << s[4] << ", " << s[5] << ") m/s\n";
+            }
+        }
+        catch (const std::exception& e) {
+            std::cerr << "❌ Query failed: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
     // ----- RUN SIMULATION -----
     if (opt.command == "run") {
         if (opt.systemFile.empty()) {
@@ -149,9 +535,10 @@ int main(int argc, char** argv) {
         }
 
         try {
-            // Load system from JSON
-            auto bodies = loadSystemFromJSON(opt.systemFile);
-            
+            // Load system from JSON or binary snapshot
+            SystemMetadata meta;
+            auto bodies = loadSystem(opt.systemFile, &meta);
+
             // NEW: normalize to barycenter if requested
             if (opt.normalize) {
                 std::cout << " - Normalizing to barycenter frame...\n";
@@ -171,9 +558,46 @@ int main(int argc, char** argv) {
                       << " - System: " << opt.systemFile << "\n"
                       << " - Steps:  " << steps << "\n"
                       << " - dt:     " << dt << " seconds\n"
-                      << " - Output: " << outPath << "\n";
+                      << " - Output: " << outPath << "\n"
+                      << " - Kernels: " << kernels::describe() << "\n";
+
+            SimulationOptions simOpt;
+            simOpt.recenterEvery = opt.recenterEvery;
+            simOpt.trajectoryPath = opt.trajectory;
+            simOpt.epoch          = meta.epoch;
+            simOpt.ephemerisPath  = opt.ephemeris;
+            if (opt.ephemWindow > 0)  simOpt.ephemerisFit.windowSteps = opt.ephemWindow;
+            if (opt.ephemDegree >= 0) simOpt.ephemerisFit.degree      = opt.ephemDegree;
+            if (opt.ephemTolerance > 0) simOpt.ephemerisFit.tolerance = opt.ephemTolerance;
+            simOpt.progress.console = opt.progress < 0  ? ProgressOptions::Console::Auto
+                                    : opt.progress == 0 ? ProgressOptions::Console::Off
+                                                        : ProgressOptions::Console::On;
+            if (opt.progressInterval > 0) simOpt.progress.intervalSeconds = opt.progressInterval;
+            simOpt.progress.statusPath = opt.statusFile;
+            if (simOpt.recenterEvery > 0) {
+                std::cout << " - Re-centering on barycenter every "
+                          << simOpt.recenterEvery << " steps\n";
+            }
 
-            runSimulation(bodies, steps, dt, outPath);
+            const bool profile = opt.profile && profiling::compiledIn();
+            if (opt.profile && !profile) {
+                std::cerr << "⚠️ --profile ignored: built with ORBIT_ENABLE_PROFILING=OFF\n";
+            }
+            if (profile) profiling::start(!opt.profileTrace.empty());
+
+            runSimulation(bodies, steps, dt, outPath, simOpt);
+
+            if (profile) {
+                profiling::stop();
+                profiling::report(std::cout);
+                if (!opt.profileTrace.empty()) {
+                    if (profiling::writeChromeTrace(opt.profileTrace)) {
+                        std::cout << "✅ Trace written: " << opt.profileTrace << "\n";
+                    } else {
+                        std::cerr << "❌ Could not write trace: " << opt.profileTrace << "\n";
+                    }
+                }
+            }
         }
         catch (const std::exception& e) {
             std::cerr << "❌ Simulation failed: " << e.what() << "\n";
@@ -191,7 +615,13 @@ int main(int argc, char** argv) {
               << "  orbit-sim info     --system <file.json>\n"
               << "  orbit-sim validate --system <file.json>\n"
               << "  orbit-sim run      --system <file.json> --steps N --dt T\n"
-              << "  orbit-sim fetch    --body <ID> --start <date> --stop <date> --output <file>\n";
+              << "  orbit-sim fetch    --body <ID> --start <date> --stop <date> --output <file>\n"
+              << "  orbit-sim shadow   --input <trajectory.csv> --output <dir>\n"
+              << "  orbit-sim convert  --system <file> --to snapshot|json --output <file>\n"
+              << "  orbit-sim compare  --reference <files> --trajectory <file>\n"
+              << "  orbit-sim serve    --input <ephemeris.oeph> [--socket <path>]\n"
+              << "  orbit-sim query    --body <name> --time <s> [--socket <path>]\n"
+              << "  orbit-sim loadtest [--socket <path>] [--connections N] [--batch N]\n";
 
     return 1;
 }
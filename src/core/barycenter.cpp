@@ -2,7 +2,7 @@
  * barycenter.cpp
  * Author: Sinan Demir
  * Date: 11/20/2025
- * Purpose: Implements barycenter normalization function
+ * Purpose: Implements barycenter normalization, tracking and re-centering
  ***************/
 
 
@@ -11,32 +11,84 @@
 
 namespace physics {
 
-void normalizeToBarycenter(std::vector<CelestialBody>& bodies) {
-    double totalMass = 0.0;
-
-    // Compute total mass
-    for (const auto& b : bodies)
-        totalMass += b.mass;
-
-    if (totalMass == 0.0) return;
+/***********************
+ * computeBarycenter
+ * @brief: Mass-weighted mean position and velocity in one pass.
+ ***********************/
+Barycenter computeBarycenter(const std::vector<CelestialBody>& bodies) {
+    Barycenter B;
 
-    // Compute COM position & velocity
-    vec3 R_cm{0,0,0};
-    vec3 V_cm{0,0,0};
+    double sx = 0.0, sy = 0.0, sz = 0.0;
+    double svx = 0.0, svy = 0.0, svz = 0.0;
 
     for (const auto& b : bodies) {
-        R_cm += b.position * b.mass;
-        V_cm += b.velocity * b.mass;
+        B.totalMass += b.mass;
+        sx  += b.mass * b.position.e[0];
+        sy  += b.mass * b.position.e[1];
+        sz  += b.mass * b.position.e[2];
+        svx += b.mass * b.velocity.e[0];
+        svy += b.mass * b.velocity.e[1];
+        svz += b.mass * b.velocity.e[2];
     }
 
-    R_cm /= totalMass;
-    V_cm /= totalMass;
+    if (B.totalMass == 0.0) return B;
 
-    // Shift all bodies
+    const double invM = 1.0 / B.totalMass;
+    B.position = vec3(sx * invM, sy * invM, sz * invM);
+    B.velocity = vec3(svx * invM, svy * invM, svz * invM);
+    return B;
+}
+
+/***********************
+ * shiftBodies
+ * @brief: Translates the whole system in phase space.
+ ***********************/
+void shiftBodies(std::vector<CelestialBody>& bodies, const vec3& dr, const vec3& dv) {
     for (auto& b : bodies) {
-        b.position = b.position - R_cm;
-        b.velocity = b.velocity - V_cm;
+        b.position += dr;
+        b.velocity += dv;
     }
 }
 
+void normalizeToBarycenter(std::vector<CelestialBody>& bodies) {
+    Barycenter B = computeBarycenter(bodies);
+    if (B.totalMass == 0.0) return;
+
+    // Shift all bodies
+    shiftBodies(bodies, -B.position, -B.velocity);
+}
+
+// ============================================================
+//  BarycenterTracker
+// ============================================================
+
+void BarycenterTracker::reset(const std::vector<CelestialBody>& bodies) {
+    reference       = computeBarycenter(bodies);
+    current         = reference;
+    elapsed         = 0.0;
+    maxDrift        = 0.0;
+    correctionCount = 0;
+}
+
+void BarycenterTracker::update(const std::vector<CelestialBody>& bodies, double dt) {
+    elapsed += dt;
+    current  = computeBarycenter(bodies);
+
+    const double drift = positionDrift().length();
+    if (drift > maxDrift) maxDrift = drift;
+}
+
+void BarycenterTracker::recenter(std::vector<CelestialBody>& bodies) {
+    if (current.totalMass == 0.0) return;
+
+    const vec3 dr = expectedPosition() - current.position;
+    const vec3 dv = reference.velocity - current.velocity;
+
+    shiftBodies(bodies, dr, dv);
+
+    current.position = expectedPosition();
+    current.velocity = reference.velocity;
+    ++correctionCount;
+}
+
 }
@@ -0,0 +1,523 @@
+/****************
+ * Author: Sinan Demir
+ * File: chebyshev_ephemeris.cpp
+ * Date: 10/16/2026
+ * Purpose: Implementation of the Chebyshev ephemeris writer/reader.
+ *****************/
+
+#include "chebyshev_ephemeris.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ORBIT_EPHEMERIS_MMAP 1
+#endif
+
+namespace {
+
+constexpr char          EPH_MAGIC[8] = {'O', 'R', 'B', 'E', 'P', 'H', '\0', '\0'};
+constexpr std::uint32_t ORDER_TAG    = 0x01020304u;
+
+/***********************
+ * struct EphemerisHeader
+ * @brief: Fixed 72-byte file header (see chebyshev_ephemeris.h).
+ ***********************/
+struct EphemerisHeader {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t count;
+    std::uint32_t coeffCount;
+    std::uint64_t windowCount;
+    double        tStart;
+    double        windowLength;
+    double        tEnd;
+    std::uint64_t coeffOffset;
+    std::uint64_t fileSize;
+};
+static_assert(sizeof(EphemerisHeader) == 72, "ephemeris header must be packed");
+
+inline std::uint64_t align8(std::uint64_t n) { return (n + 7u) & ~std::uint64_t(7u); }
+
+void writeString(std::ofstream& out, std::string_view s) {
+    const std::uint64_t len = s.size();
+    out.write(reinterpret_cast<const char*>(&len), sizeof(len));
+    out.write(s.data(), static_cast<std::streamsize>(len));
+}
+
+[[noreturn]] void corrupt(const std::string& path, const char* what) {
+    throw std::runtime_error("Invalid ephemeris " + path + ": " + what);
+}
+
+/***********************
+ * chebyshevBasis
+ * @brief: T_k(x) and dT_k/dx for k < n.
+ ***********************/
+void chebyshevBasis(double x, int n, double* T, double* dT) {
+    T[0] = 1.0;  dT[0] = 0.0;
+    if (n > 1) { T[1] = x; dT[1] = 1.0; }
+    for (int k = 2; k < n; ++k) {
+        T[k]  = 2.0 * x * T[k - 1] - T[k - 2];
+        dT[k] = 2.0 * T[k - 1] + 2.0 * x * dT[k - 1] - dT[k - 2];
+    }
+}
+
+/***********************
+ * householderQR
+ * @brief: Factors the rows x n design matrix A (row-major, rows >= n) in
+ *         place: R in the upper triangle, the Householder vectors below
+ *         it (unit leading entry implied, as in LAPACK's dgeqrf).
+ * @param tau - receives the n reflector scales
+ ***********************/
+void householderQR(std::vector<double>& A, int rows, int n, std::vector<double>& tau) {
+    tau.assign(n, 0.0);
+    for (int k = 0; k < n; ++k) {
+        double norm2 = 0.0;
+        for (int i = k; i < rows; ++i) norm2 += A[i * n + k] * A[i * n + k];
+        if (norm2 == 0.0) continue;
+
+        const double x0   = A[k * n + k];
+        const double beta = x0 >= 0.0 ? -std::sqrt(norm2) : std::sqrt(norm2);
+        tau[k] = (beta - x0) / beta;
+        const double scale = 1.0 / (x0 - beta);
+        for (int i = k + 1; i < rows; ++i) A[i * n + k] *= scale;
+        A[k * n + k] = beta;
+
+        for (int c = k + 1; c < n; ++c) {
+            double w = A[k * n + c];
+            for (int i = k + 1; i < rows; ++i) w += A[i * n + k] * A[i * n + c];
+            w *= tau[k];
+            A[k * n + c] -= w;
+            for (int i = k + 1; i < rows; ++i) A[i * n + c] -= w * A[i * n + k];
+        }
+    }
+}
+
+/***********************
+ * qrSolve
+ * @brief: Least-squares solution of A c = y from householderQR's factors.
+ *         y (rows entries) is overwritten; c receives n coefficients.
+ *         Columns whose pivot vanishes (rank deficient fit) get 0.
+ ***********************/
+void qrSolve(const std::vector<double>& A, const std::vector<double>& tau,
+             int rows, int n, double* y, double* c) {
+    for (int k = 0; k < n; ++k) {
+        if (tau[k] == 0.0) continue;
+        double w = y[k];
+        for (int i = k + 1; i < rows; ++i) w += A[i * n + k] * y[i];
+        w *= tau[k];
+        y[k] -= w;
+        for (int i = k + 1; i < rows; ++i) y[i] -= w * A[i * n + k];
+    }
+
+    const double tiny = 1e-13 * std::fabs(A[0]);
+    for (int i = n - 1; i >= 0; --i) {
+        const double d = A[i * n + i];
+        if (!(std::fabs(d) > tiny)) {
+            c[i] = 0.0;
+            continue;
+        }
+        double s = y[i];
+        for (int k = i + 1; k < n; ++k) s -= A[i * n + k] * c[k];
+        c[i] = s / d;
+    }
+}
+
+} // namespace
+
+// ============================================================
+//  Writer
+// ============================================================
+
+bool ChebyshevEphemerisWriter::open(const std::string& path,
+                                    const std::vector<std::string>& names,
+                                    double dt,
+                                    const std::string& epoch,
+                                    const ChebyshevFitOptions& fit)
+{
+    if (dt <= 0.0 || fit.windowSteps < 1 || fit.degree < 0 ||
+        fit.degree + 1 > 2 * (fit.windowSteps + 1)) {
+        return false;
+    }
+
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    filePath     = path;
+    tolerance    = fit.tolerance;
+    fitError     = 0.0;
+    failure.clear();
+    bodyCount    = names.size();
+    windowSteps  = fit.windowSteps;
+    coeffCount   = fit.degree + 1;
+    windowLength = fit.windowSteps * dt;
+    windowCount  = 0;
+    started      = false;
+    times.clear();
+    states.clear();
+    record.assign(bodyCount * 3 * static_cast<std::size_t>(coeffCount), 0.0);
+
+    // Provisional header; counts and size are patched by finish()
+    EphemerisHeader h{};
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+    std::uint64_t pos = sizeof(h);
+    writeString(out, epoch);
+    pos += sizeof(std::uint64_t) + epoch.size();
+    for (const auto& n : names) {
+        writeString(out, n);
+        pos += sizeof(std::uint64_t) + n.size();
+    }
+    static const char zeros[8] = {};
+    out.write(zeros, static_cast<std::streamsize>(align8(pos) - pos));
+    coeffOffset = align8(pos);
+
+    return static_cast<bool>(out);
+}
+
+void ChebyshevEphemerisWriter::add(double t, const std::vector<CelestialBody>& bodies) {
+    if (!started) { tStart = t; started = true; }
+    times.push_back(t);
+    for (const auto& b : bodies) {
+        states.insert(states.end(), {b.position.x(), b.position.y(), b.position.z(),
+                                     b.velocity.x(), b.velocity.y(), b.velocity.z()});
+    }
+    if (times.size() == static_cast<std::size_t>(windowSteps) + 1) fitPending();
+}
+
+void ChebyshevEphemerisWriter::add(const TrajectoryFrame& frame) {
+    if (!started) { tStart = frame.t; started = true; }
+    times.push_back(frame.t);
+    for (std::size_t b = 0; b < frame.positions.size(); ++b) {
+        const vec3& p = frame.positions[b];
+        const vec3  v = frame.velocities.empty() ? vec3(0, 0, 0) : frame.velocities[b];
+        states.insert(states.end(), {p.x(), p.y(), p.z(), v.x(), v.y(), v.z()});
+    }
+    if (times.size() == static_cast<std::size_t>(windowSteps) + 1) fitPending();
+}
+
+/***********************
+ * fitPending
+ * @brief: Least-squares fit of the pending frames (positions and
+ *         velocities) for every body and axis, then writes the record.
+ * @note: All series in a window share the same sample times, so the
+ *        design matrix [T; D] is QR-factored once (Householder, no normal
+ *        equations) and reused for the 3N right-hand sides. A trailing
+ *        partial window is mapped over its real span [ws, last sample],
+ *        which the reader recovers from the header's end of coverage.
+ *        Every sample is re-evaluated from the fitted series and the
+ *        largest position error kept for finish(). The last frame stays
+ *        pending as the first sample of the next window, keeping
+ *        neighbouring fits consistent at the boundary.
+ ***********************/
+void ChebyshevEphemerisWriter::fitPending() {
+    const std::size_t m = times.size();
+    if (m < 2) return;
+
+    // A short trailing window cannot support the full degree
+    const int n    = std::min<int>(coeffCount, static_cast<int>(2 * m));
+    const int rows = static_cast<int>(2 * m);
+    const double ws   = tStart + static_cast<double>(windowCount) * windowLength;
+    const bool   full = m == static_cast<std::size_t>(windowSteps) + 1;
+    const double half = 0.5 * (full ? windowLength : times.back() - ws);
+
+    // Design matrix: position rows T, then velocity rows D (velocities are
+    // scaled by half the span so both rows are in position units)
+    std::vector<double> A(static_cast<std::size_t>(rows) * n);
+    double* T = A.data();
+    double* D = A.data() + m * n;
+    for (std::size_t j = 0; j < m; ++j) {
+        const double x = (times[j] - ws) / half - 1.0;
+        chebyshevBasis(x, n, &T[j * n], &D[j * n]);
+    }
+    const std::vector<double> basis(A.begin(), A.begin() + static_cast<std::ptrdiff_t>(m * n));
+
+    std::vector<double> tau;
+    householderQR(A, rows, n, tau);
+
+    std::fill(record.begin(), record.end(), 0.0);
+    std::vector<double> y(rows), err2(m);
+    for (std::size_t b = 0; b < bodyCount; ++b) {
+        std::fill(err2.begin(), err2.end(), 0.0);
+        for (int axis = 0; axis < 3; ++axis) {
+            double* c = &record[(b * 3 + axis) * coeffCount];
+            for (std::size_t j = 0; j < m; ++j) {
+                const double* s = &states[(j * bodyCount + b) * 6];
+                y[j]     = s[axis];
+                y[m + j] = s[3 + axis] * half;
+            }
+            qrSolve(A, tau, rows, n, y.data(), c);
+
+            for (std::size_t j = 0; j < m; ++j) {
+                double p = 0.0;
+                for (int k = 0; k < n; ++k) p += c[k] * basis[j * n + k];
+                const double d = p - states[(j * bodyCount + b) * 6 + axis];
+                err2[j] += d * d;
+            }
+        }
+        for (double e2 : err2) {
+            const double e = std::isfinite(e2) ? std::sqrt(e2) : HUGE_VAL;
+            fitError = std::max(fitError, e);
+        }
+    }
+
+    out.write(reinterpret_cast<const char*>(record.data()),
+              static_cast<std::streamsize>(record.size() * sizeof(double)));
+    ++windowCount;
+    tEnd = times.back();
+
+    // Keep the boundary frame for the next window
+    times.erase(times.begin(), times.end() - 1);
+    states.erase(states.begin(), states.end() - static_cast<std::ptrdiff_t>(6 * bodyCount));
+}
+
+/***********************
+ * finish
+ * @brief: Fits the trailing window, patches the header and checks the
+ *         largest fit error against the tolerance; a file that fails the
+ *         check is removed so nothing serves it.
+ ***********************/
+bool ChebyshevEphemerisWriter::finish() {
+    fitPending();
+
+    EphemerisHeader h{};
+    std::memcpy(h.magic, EPH_MAGIC, sizeof(EPH_MAGIC));
+    h.version      = EPHEMERIS_VERSION;
+    h.byteOrder    = ORDER_TAG;
+    h.count        = static_cast<std::uint32_t>(bodyCount);
+    h.coeffCount   = static_cast<std::uint32_t>(coeffCount);
+    h.windowCount  = windowCount;
+    h.tStart       = tStart;
+    h.windowLength = windowLength;
+    h.tEnd         = tEnd;
+    h.coeffOffset  = coeffOffset;
+    h.fileSize     = coeffOffset + windowCount * record.size() * sizeof(double);
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.close();
+    if (out.fail()) {
+        failure = "could not write " + filePath;
+        return false;
+    }
+
+    if (!(fitError <= tolerance)) {
+        std::ostringstream msg;
+        msg << "Chebyshev fit misses a sample by " << fitError << " m (tolerance "
+            << tolerance << " m); use a shorter window or a higher degree";
+        failure = msg.str();
+        std::remove(filePath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ============================================================
+//  Reader
+// ============================================================
+
+/***********************
+ * ChebyshevEphemeris (constructor)
+ * @brief: Maps the file and validates the header against its size.
+ ***********************/
+ChebyshevEphemeris::ChebyshevEphemeris(const std::string& path)
+{
+    const unsigned char* base = nullptr;
+
+#ifdef ORBIT_EPHEMERIS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open ephemeris: " + path);
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(EphemerisHeader))) {
+        ::close(fd);
+        corrupt(path, "file too small");
+    }
+    mapSize = static_cast<std::size_t>(st.st_size);
+    void* m = ::mmap(nullptr, mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (m == MAP_FAILED) {
+        throw std::runtime_error("Could not map ephemeris: " + path);
+    }
+    mapping = m;
+    base    = static_cast<const unsigned char*>(m);
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Could not open ephemeris: " + path);
+    }
+    fallback.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    mapSize = fallback.size();
+    if (mapSize < sizeof(EphemerisHeader)) corrupt(path, "file too small");
+    base = fallback.data();
+#endif
+
+    try {
+        EphemerisHeader h;
+        std::memcpy(&h, base, sizeof(h));
+
+        if (std::memcmp(h.magic, EPH_MAGIC, sizeof(EPH_MAGIC)) != 0) corrupt(path, "bad magic");
+        if (h.byteOrder != ORDER_TAG)                              corrupt(path, "foreign byte order");
+        if (h.version != EPHEMERIS_VERSION) {
+            throw std::runtime_error("Unsupported ephemeris version "
+                                     + std::to_string(h.version) + " in " + path
+                                     + " (expected " + std::to_string(EPHEMERIS_VERSION) + ")");
+        }
+        if (h.fileSize != mapSize)  corrupt(path, "truncated or unfinished file");
+        if (h.windowCount == 0)     corrupt(path, "no fitted windows");
+        if (h.coeffCount == 0 || !(h.windowLength > 0.0)) corrupt(path, "bad fit parameters");
+
+        const std::uint64_t recordBytes = std::uint64_t(h.count) * 3 * h.coeffCount * sizeof(double);
+        if (h.coeffOffset % 8 != 0 || h.coeffOffset > mapSize ||
+            (mapSize - h.coeffOffset) / h.windowCount != recordBytes) {
+            corrupt(path, "bad coefficient layout");
+        }
+
+        // Epoch and names: length-prefixed strings before the coefficients
+        std::uint64_t pos = sizeof(EphemerisHeader);
+        auto readString = [&](std::string_view& s) {
+            std::uint64_t len = 0;
+            if (pos + sizeof(len) > h.coeffOffset) corrupt(path, "bad name table");
+            std::memcpy(&len, base + pos, sizeof(len));
+            pos += sizeof(len);
+            if (len > h.coeffOffset - pos) corrupt(path, "bad name table");
+            s = std::string_view(reinterpret_cast<const char*>(base + pos), static_cast<std::size_t>(len));
+            pos += len;
+        };
+        readString(epochText);
+        names.resize(h.count);
+        for (auto& n : names) readString(n);
+
+        // The last window runs from its start to the end of coverage
+        const double lastStart = h.tStart + static_cast<double>(h.windowCount - 1) * h.windowLength;
+        if (!(h.tEnd > lastStart) || h.tEnd - lastStart > h.windowLength * (1.0 + 1e-9)) {
+            corrupt(path, "bad coverage");
+        }
+
+        count       = h.count;
+        coeffCount  = static_cast<int>(h.coeffCount);
+        windowCount = static_cast<std::size_t>(h.windowCount);
+        tStart      = h.tStart;
+        tEnd        = h.tEnd;
+        window      = h.windowLength;
+        invWindow   = 1.0 / h.windowLength;
+        lastWindowStart = lastStart;
+        invLastSpan     = 1.0 / (h.tEnd - lastStart);
+        coeffs      = reinterpret_cast<const double*>(base + h.coeffOffset);
+    }
+    catch (...) {
+#ifdef ORBIT_EPHEMERIS_MMAP
+        ::munmap(mapping, mapSize);
+#endif
+        mapping = nullptr;
+        throw;
+    }
+}
+
+ChebyshevEphemeris::~ChebyshevEphemeris() {
+#ifdef ORBIT_EPHEMERIS_MMAP
+    if (mapping) ::munmap(mapping, mapSize);
+#endif
+}
+
+int ChebyshevEphemeris::bodyIndex(std::string_view name) const {
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+/***********************
+ * windowFor
+ * @brief: Direct window lookup: index = floor((t - start) / length),
+ *         clamped to the fitted range. The last window may be shorter
+ *         and is mapped over [its start, end of coverage].
+ * @param x     - receives t mapped to [-1, 1] within the window
+ * @param scale - receives dx/dt
+ * @return pointer to the body's 3 x C coefficients in that window
+ ***********************/
+const double* ChebyshevEphemeris::windowFor(std::size_t body, double t, double& x, double& scale) const {
+    const double u = (t - tStart) * invWindow;
+    double w = std::floor(u);
+    w = std::min(std::max(w, 0.0), static_cast<double>(windowCount - 1));
+
+    const std::size_t i = static_cast<std::size_t>(w);
+    if (i + 1 == windowCount) {
+        x     = 2.0 * (t - lastWindowStart) * invLastSpan - 1.0;
+        scale = 2.0 * invLastSpan;
+    } else {
+        x     = 2.0 * (u - w) - 1.0;
+        scale = 2.0 * invWindow;
+    }
+    return coeffs + (i * count + body) * 3 * static_cast<std::size_t>(coeffCount);
+}
+
+/***********************
+ * state
+ * @brief: Clenshaw recurrence for the series and its derivative. The
+ *         three axes run in the same loop so their independent dependency
+ *         chains overlap instead of executing back to back.
+ ***********************/
+void ChebyshevEphemeris::state(std::size_t body, double t, vec3& position, vec3& velocity) const {
+    double x, scale;
+    const double* cx = windowFor(body, t, x, scale);
+    const int n = coeffCount;
+    const double* cy = cx + n;
+    const double* cz = cy + n;
+    const double twoX = 2.0 * x;
+
+    double bx1 = 0, bx2 = 0, by1 = 0, by2 = 0, bz1 = 0, bz2 = 0;   // b_{k+1}, b_{k+2}
+    double dx1 = 0, dx2 = 0, dy1 = 0, dy2 = 0, dz1 = 0, dz2 = 0;   // their x-derivatives
+    for (int k = n - 1; k >= 1; --k) {
+        const double dx0 = 2.0 * bx1 + twoX * dx1 - dx2;
+        const double dy0 = 2.0 * by1 + twoX * dy1 - dy2;
+        const double dz0 = 2.0 * bz1 + twoX * dz1 - dz2;
+        const double bx0 = cx[k] + twoX * bx1 - bx2;
+        const double by0 = cy[k] + twoX * by1 - by2;
+        const double bz0 = cz[k] + twoX * bz1 - bz2;
+        bx2 = bx1;  bx1 = bx0;  dx2 = dx1;  dx1 = dx0;
+        by2 = by1;  by1 = by0;  dy2 = dy1;  dy1 = dy0;
+        bz2 = bz1;  bz1 = bz0;  dz2 = dz1;  dz1 = dz0;
+    }
+
+    position = vec3(cx[0] + x * bx1 - bx2, cy[0] + x * by1 - by2, cz[0] + x * bz1 - bz2);
+    velocity = vec3((bx1 + x * dx1 - dx2) * scale,
+                    (by1 + x * dy1 - dy2) * scale,
+                    (bz1 + x * dz1 - dz2) * scale);
+}
+
+vec3 ChebyshevEphemeris::position(std::size_t body, double t) const {
+    double x, scale;
+    const double* cx = windowFor(body, t, x, scale);
+    const int n = coeffCount;
+    const double* cy = cx + n;
+    const double* cz = cy + n;
+    const double twoX = 2.0 * x;
+
+    double bx1 = 0, bx2 = 0, by1 = 0, by2 = 0, bz1 = 0, bz2 = 0;
+    for (int k = n - 1; k >= 1; --k) {
+        const double bx0 = cx[k] + twoX * bx1 - bx2;
+        const double by0 = cy[k] + twoX * by1 - by2;
+        const double bz0 = cz[k] + twoX * bz1 - bz2;
+        bx2 = bx1;  bx1 = bx0;
+        by2 = by1;  by1 = by0;
+        bz2 = bz1;  bz1 = bz0;
+    }
+    return vec3(cx[0] + x * bx1 - bx2, cy[0] + x * by1 - by2, cz[0] + x * bz1 - bz2);
+}
+
+bool isChebyshevEphemeris(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(EPH_MAGIC)] = {};
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, EPH_MAGIC, sizeof(magic)) == 0;
+}
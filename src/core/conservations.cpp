@@ -6,6 +6,7 @@
  *********************/
 
 #include "conservations.h"
+#include "kernels.h"
 
 namespace physics {
 
@@ -118,6 +119,8 @@ Conservations compute(const CelestialBody& sun,
  *  - Potential energy: - sum_{i<j} G m_i m_j / r_ij
  *  - Linear momentum : sum_i m_i v_i
  *  - Angular momentum: sum_i r_i × (m_i v_i)
+ *
+ * @note: The sums run in the active kernel backend (kernels.h).
  ***********************/
 Conservations compute(const std::vector<CelestialBody>& bodies) {
     Conservations C;
@@ -126,43 +129,16 @@ Conservations compute(const std::vector<CelestialBody>& bodies) {
         return C;
     }
 
-    // ---- Kinetic energy and linear momentum ---- //
-    for (const auto& b : bodies) {
-        const double v2 = b.velocity.length_squared();
-
-        // 1/2 m v^2
-        C.kinetic_energy += 0.5 * b.mass * v2;
-
-        // p = m v
-        vec3 p = b.mass * b.velocity;
-        C.P[0] += p.x();
-        C.P[1] += p.y();
-        C.P[2] += p.z();
-    }
-
-    // ---- Potential energy (pairwise: i < j) ---- //
-    for (std::size_t i = 0; i < bodies.size(); ++i) {
-        for (std::size_t j = i + 1; j < bodies.size(); ++j) {
-            const auto& a = bodies[i];
-            const auto& b = bodies[j];
+    thread_local std::vector<double> state, mass;
+    kernels::packState(bodies, state, mass);
 
-            double r = distance(a, b);
-            if (r == 0.0) continue; // avoid singularity
+    const kernels::ConservationSums s =
+        kernels::active().conservation(state.data(), mass.data(), bodies.size());
 
-            C.potential_energy -= constants::G * a.mass * b.mass / r;
-        }
-    }
-
-    // ---- Angular momentum ---- //
-    for (const auto& b : bodies) {
-        // r × (m v)
-        vec3 p  = b.mass * b.velocity;
-        vec3 Lv = cross(b.position, p);
-
-        C.L[0] += Lv.x();
-        C.L[1] += Lv.y();
-        C.L[2] += Lv.z();
-    }
+    C.kinetic_energy   = s.kinetic;
+    C.potential_energy = s.potential;
+    C.P = {s.P[0], s.P[1], s.P[2]};
+    C.L = {s.L[0], s.L[1], s.L[2]};
 
     // ---- Total energy ---- //
     C.total_energy = C.kinetic_energy + C.potential_energy;
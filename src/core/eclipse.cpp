@@ -81,3 +81,119 @@ EclipseResult computeSolarEclipse(const vec3& S, const vec3& E, const vec3& M) {
 
     return { shadowCenter, umbraRadius, penumbraRadius, eclipseType };
 }
+
+
+/****************
+ * eclipseBatchKernel
+ * @brief: Inner loop of computeSolarEclipseBatch on raw SoA pointers.
+ * @note: Kept as a separate function so the __restrict qualifiers sit on
+ *        parameters, which is where GCC/Clang use them to drop the runtime
+ *        alias checks that otherwise block vectorization.
+ *****************/
+static void eclipseBatchKernel(const double* __restrict Sx,
+                               const double* __restrict Sy,
+                               const double* __restrict Sz,
+                               const double* __restrict Ex,
+                               const double* __restrict Ey,
+                               const double* __restrict Ez,
+                               const double* __restrict Mx,
+                               const double* __restrict My,
+                               const double* __restrict Mz,
+                               std::size_t n,
+                               double* __restrict oX,
+                               double* __restrict oY,
+                               double* __restrict oZ,
+                               double* __restrict oU,
+                               double* __restrict oP,
+                               int*    __restrict oT) {
+
+    const double R_SUN   = physics::constants::R_SUN;
+    const double R_EARTH = physics::constants::R_EARTH;
+    const double R_MOON  = physics::constants::R_MOON;
+
+    // Cone denominators are sample-independent
+    const double umbraDen    = R_SUN - R_MOON;
+    const double penumbraDen = R_SUN + R_MOON;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const double ex = Ex[i], ey = Ey[i], ez = Ez[i];
+        const double mx = Mx[i], my = My[i], mz = Mz[i];
+
+        // Moon -> Earth, Sun -> Moon
+        const double mex = ex - mx;
+        const double mey = ey - my;
+        const double mez = ez - mz;
+        const double smx = mx - Sx[i];
+        const double smy = my - Sy[i];
+        const double smz = mz - Sz[i];
+
+        const double d_em = std::sqrt(mex*mex + mey*mey + mez*mez);
+        const double d_sm = std::sqrt(smx*smx + smy*smy + smz*smz);
+
+        // Same predicate as the scalar early return (NaN stays "valid")
+        const bool valid = !(d_em <= 0.0) & !(d_sm <= 0.0);
+
+        // Umbra & penumbra lengths and radii at Earth
+        const double L_u = (R_MOON * d_sm) / umbraDen;
+        const double L_p = (R_MOON * d_sm) / penumbraDen;
+
+        const double umbraRadius    = R_MOON * (1.0 - d_em / L_u);
+        const double penumbraRadius = R_MOON * (1.0 + d_em / L_p);
+
+        // Shadow center: E - unit_vector(ME) * R_EARTH
+        const double inv = 1.0 / d_em;
+        const double cx = ex - R_EARTH * (inv * mex);
+        const double cy = ey - R_EARTH * (inv * mey);
+        const double cz = ez - R_EARTH * (inv * mez);
+
+        // Branch-free classification (same precedence as the scalar chain).
+        // Kept in double lanes so the whole body vectorizes as V2DF/V4DF.
+        const double total   = umbraRadius > R_EARTH ? 1.0 : 0.0;
+        const double annular = (umbraRadius < 0.0) & (penumbraRadius > R_EARTH)
+                             ? 1.0 - total : 0.0;
+        const double partial = penumbraRadius > 0.0
+                             ? 1.0 - total - annular : 0.0;
+        const double type    = total + 2.0 * annular + 3.0 * partial;
+
+        const double rx = valid ? cx : ex;
+        const double ry = valid ? cy : ey;
+        const double rz = valid ? cz : ez;
+        const double ru = valid ? umbraRadius    : 0.0;
+        const double rp = valid ? penumbraRadius : 0.0;
+        const double rt = valid ? type           : 0.0;
+
+        oX[i] = rx;
+        oY[i] = ry;
+        oZ[i] = rz;
+        oU[i] = ru;
+        oP[i] = rp;
+        oT[i] = static_cast<int>(rt);
+    }
+}
+
+/****************
+ * computeSolarEclipseBatch
+ * @brief: SoA batch version of computeSolarEclipse for eclipse catalogs.
+ * @param: S, E, M - Sun/Earth/Moon positions for n samples
+ * @param: n       - number of samples
+ * @param: out     - SoA destination arrays
+ * @exception none
+ * @return: none
+ * @note: Mirrors the scalar arithmetic operation-for-operation (including the
+ *        1/|ME| scaling done by unit_vector) so both paths agree bit-for-bit.
+ *        The degenerate-distance early return and the eclipse classification
+ *        are expressed as masks/selects to keep the loop branch-free.
+ *****************/
+void computeSolarEclipseBatch(const Vec3SoA& S,
+                              const Vec3SoA& E,
+                              const Vec3SoA& M,
+                              std::size_t n,
+                              const EclipseBatchOutput& out) {
+    eclipseBatchKernel(S.x, S.y, S.z,
+                       E.x, E.y, E.z,
+                       M.x, M.y, M.z,
+                       n,
+                       out.shadowX, out.shadowY, out.shadowZ,
+                       out.umbraRadius, out.penumbraRadius,
+                       out.eclipseType);
+}
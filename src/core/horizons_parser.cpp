@@ -0,0 +1,459 @@
+/********************
+ * Author: Sinan Demir
+ * File: horizons_parser.cpp
+ * Date: 10/16/2026
+ * Purpose:
+ *    Implementation of the HORIZONS VECTORS parser and system assembly.
+ *********************/
+
+#include "horizons_parser.h"
+#include "utils.h"
+
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+namespace {
+
+using sv = std::string_view;
+
+inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+inline bool isUpper(char c) { return c >= 'A' && c <= 'Z'; }
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+sv trim(sv s) {
+    while (!s.empty() && isSpace(s.front())) s.remove_prefix(1);
+    while (!s.empty() && isSpace(s.back()))  s.remove_suffix(1);
+    return s;
+}
+
+// Pops the next line (without '\n') off the front of `text`
+sv nextLine(sv& text) {
+    const std::size_t nl = text.find('\n');
+    sv line = text.substr(0, nl);
+    text.remove_prefix(nl == sv::npos ? text.size() : nl + 1);
+    return line;
+}
+
+/********************
+ * parseNumber
+ * @brief: Reads a double at the front of `s` (leading blanks and '+'
+ *         allowed), advancing `s` past it.
+ * @return false if no number is present
+ *********************/
+bool parseNumber(sv& s, double& out) {
+    while (!s.empty() && isSpace(s.front())) s.remove_prefix(1);
+    if (!s.empty() && s.front() == '+') s.remove_prefix(1);
+
+    const char* first = s.data();
+    const char* last  = s.data() + s.size();
+    auto [ptr, ec] = std::from_chars(first, last, out);
+    if (ec != std::errc() || ptr == first) return false;
+
+    s.remove_prefix(static_cast<std::size_t>(ptr - first));
+    return true;
+}
+
+/********************
+ * splitNameId
+ * @brief: "Earth (399)   {source: DE441}" → name "Earth", id "399".
+ *********************/
+void splitNameId(sv value, std::string& name, std::string& id) {
+    const std::size_t brace = value.find('{');
+    value = trim(value.substr(0, brace));
+
+    const std::size_t open  = value.rfind('(');
+    const std::size_t close = value.rfind(')');
+    if (open != sv::npos && close != sv::npos && close > open) {
+        id   = std::string(trim(value.substr(open + 1, close - open - 1)));
+        name = std::string(trim(value.substr(0, open)));
+    } else {
+        id.clear();
+        name = std::string(value);
+    }
+}
+
+/********************
+ * findGM
+ * @brief: Extracts GM (km^3/s^2) from a header line. Accepts the spellings
+ *         HORIZONS uses ("GM, km^3/s^2 = ...", "GM (km^3/s^2)= ...",
+ *         "GM= ...") and ignores uncertainty entries ("GM 1-sigma").
+ * @return true if a value was found
+ *********************/
+bool findGM(sv line, double& gmKm3) {
+    for (std::size_t p = line.find("GM"); p != sv::npos; p = line.find("GM", p + 2)) {
+        const bool startOk = (p == 0) || isSpace(line[p - 1]);
+        const char after   = (p + 2 < line.size()) ? line[p + 2] : '\0';
+        if (!startOk || !(after == ',' || after == ' ' || after == '(' || after == '=')) {
+            continue;
+        }
+
+        const std::size_t eq = line.find('=', p);
+        if (eq == sv::npos || eq - p > 32) continue;
+
+        const sv key = line.substr(p, eq - p);
+        if (key.find("sigma") != sv::npos || key.find("1-s") != sv::npos) continue;
+
+        sv rest = line.substr(eq + 1);
+        double v = 0.0;
+        if (parseNumber(rest, v) && v > 0.0) {
+            gmKm3 = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+/********************
+ * struct RecordBuilder
+ * @brief: Accumulates the fields of one VECTORS record.
+ *********************/
+struct RecordBuilder {
+    HorizonsState state;
+    double v[6] = {0, 0, 0, 0, 0, 0};   // X Y Z VX VY VZ
+    unsigned seen = 0;                  // bit i set when v[i] was read
+    bool open = false;
+
+    bool complete() const { return seen == 0x3Fu; }
+};
+
+} // namespace
+
+/********************
+ * extractHorizonsResult
+ *********************/
+std::string extractHorizonsResult(const std::string& reply, bool requireJson) {
+    sv t = trim(reply);
+    while (!t.empty() && t.front() == '\n') t.remove_prefix(1);
+    if (t.empty() || t.front() != '{') {
+        if (requireJson) {
+            throw std::runtime_error("HORIZONS reply is not JSON");
+        }
+        return reply;
+    }
+
+    json j = json::parse(reply);
+    if (j.contains("error")) {
+        throw std::runtime_error("HORIZONS API returned error: " + j["error"].get<std::string>());
+    }
+    if (!j.contains("result")) {
+        throw std::runtime_error("HORIZONS JSON missing 'result' field");
+    }
+    return j["result"].get<std::string>();
+}
+
+/********************
+ * hasVectorsTable
+ *********************/
+bool hasVectorsTable(std::string_view text) {
+    const std::size_t soe = text.find("$$SOE");
+    return soe != sv::npos && text.find("$$EOE", soe) != sv::npos;
+}
+
+/********************
+ * parseHorizonsVectors
+ *********************/
+HorizonsEphemeris parseHorizonsVectors(std::string_view text) {
+    HorizonsEphemeris eph;
+
+    // ---- header (everything before $$SOE) ----
+    const std::size_t soe = text.find("$$SOE");
+    if (soe == sv::npos) {
+        throw std::runtime_error("HORIZONS text has no $$SOE marker (not a VECTORS ephemeris?)");
+    }
+    const std::size_t eoe = text.find("$$EOE", soe);
+    if (eoe == sv::npos) {
+        throw std::runtime_error("HORIZONS text has no $$EOE marker (truncated reply?)");
+    }
+
+    double posScale = 1000.0;   // KM → m
+    double velScale = 1000.0;   // KM/S → m/s
+    double gmKm3    = 0.0;
+
+    sv header = text.substr(0, soe);
+    while (!header.empty()) {
+        const sv line = nextLine(header);
+        const sv t    = trim(line);
+
+        if (t.rfind("Target body name:", 0) == 0) {
+            splitNameId(t.substr(17), eph.targetName, eph.targetId);
+        }
+        else if (t.rfind("Center body name:", 0) == 0) {
+            splitNameId(t.substr(17), eph.centerName, eph.centerId);
+        }
+        else if (t.rfind("Output units", 0) == 0) {
+            const sv units = trim(t.substr(t.find(':') + 1));
+            if (units.rfind("KM-S", 0) == 0)      { posScale = 1000.0; velScale = 1000.0; }
+            else if (units.rfind("KM-D", 0) == 0) { posScale = 1000.0; velScale = 1000.0 / 86400.0; }
+            else if (units.rfind("AU-D", 0) == 0) {
+                posScale = physics::constants::AU;
+                velScale = physics::constants::AU / 86400.0;
+            }
+            else {
+                throw std::runtime_error("Unsupported HORIZONS output units: " + std::string(units));
+            }
+        }
+        else if (gmKm3 == 0.0) {
+            findGM(line, gmKm3);
+        }
+    }
+    eph.gm = gmKm3 * 1.0e9;   // km^3/s^2 → m^3/s^2
+
+    // ---- table ----
+    RecordBuilder rec;
+    auto flush = [&] {
+        if (!rec.open) return;
+        if (!rec.complete()) {
+            throw std::runtime_error("Incomplete HORIZONS record at JD " + std::to_string(rec.state.jdTDB)
+                                     + " (need X, Y, Z, VX, VY, VZ; use VEC_TABLE 2 or 3)");
+        }
+        rec.state.position = vec3(rec.v[0], rec.v[1], rec.v[2]) * posScale;
+        rec.state.velocity = vec3(rec.v[3], rec.v[4], rec.v[5]) * velScale;
+        eph.states.push_back(std::move(rec.state));
+        rec = RecordBuilder{};
+    };
+
+    sv table = text.substr(soe + 5, eoe - soe - 5);
+    while (!table.empty()) {
+        sv line = trim(nextLine(table));
+        if (line.empty()) continue;
+
+        // New record: "<JD> = A.D. <date> TDB" or "<JD>, A.D. <date>, X, Y, ..."
+        if (isDigit(line.front())) {
+            flush();
+            rec.open = true;
+            if (!parseNumber(line, rec.state.jdTDB)) {
+                throw std::runtime_error("Malformed HORIZONS record line: " + std::string(line));
+            }
+            line = trim(line);
+            const bool csv = !line.empty() && line.front() == ',';   // CSV_FORMAT=YES
+            if (!line.empty() && (line.front() == '=' || line.front() == ',')) line.remove_prefix(1);
+            line = trim(line);
+            if (line.rfind("A.D.", 0) == 0) line.remove_prefix(4);   // keep "B.C."
+
+            if (!csv) {
+                rec.state.calendar = std::string(trim(line));
+                continue;
+            }
+
+            // CSV: calendar, X, Y, Z, VX, VY, VZ, ...
+            const std::size_t comma = line.find(',');
+            rec.state.calendar = std::string(trim(line.substr(0, comma))) + " TDB";   // JDTDB table
+            line.remove_prefix(comma == sv::npos ? line.size() : comma + 1);
+            for (int i = 0; i < 6; ++i) {
+                if (!parseNumber(line, rec.v[i])) break;
+                rec.seen |= 1u << i;
+                line = trim(line);
+                if (!line.empty() && line.front() == ',') line.remove_prefix(1);
+            }
+            continue;
+        }
+
+        // Labelled fields: " X =-2.6E+07 Y = 1.4E+08 Z = 5.7E+04"
+        while (!line.empty()) {
+            if (!isUpper(line.front())) { line.remove_prefix(1); continue; }
+
+            std::size_t n = 0;
+            while (n < line.size() && isUpper(line[n])) ++n;
+            const sv label = line.substr(0, n);
+            line.remove_prefix(n);
+            line = trim(line);
+            if (line.empty() || line.front() != '=') continue;
+            line.remove_prefix(1);
+
+            double value = 0.0;
+            if (!parseNumber(line, value)) continue;
+
+            int slot = -1;
+            if      (label == "X")  slot = 0;
+            else if (label == "Y")  slot = 1;
+            else if (label == "Z")  slot = 2;
+            else if (label == "VX") slot = 3;
+            else if (label == "VY") slot = 4;
+            else if (label == "VZ") slot = 5;
+            if (slot >= 0 && rec.open) {
+                rec.v[slot] = value;
+                rec.seen |= 1u << slot;
+            }
+        }
+    }
+    flush();
+
+    if (eph.states.empty()) {
+        throw std::runtime_error("HORIZONS ephemeris contains no records between $$SOE and $$EOE");
+    }
+    return eph;
+}
+
+/********************
+ * naifFallbackMass
+ * @note: Values match systems/solar_system.json; planet barycenters (1–9)
+ *        include their moons.
+ *********************/
+double naifFallbackMass(const std::string& naifId) {
+    struct Entry { const char* id; double mass; };
+    static const Entry table[] = {
+        {"10",  1.98847e30},                        // Sun
+        {"1",   3.3011e23},   {"199", 3.3011e23},   // Mercury
+        {"2",   4.8675e24},   {"299", 4.8675e24},   // Venus
+        {"3",   6.0456e24},   {"399", 5.9722e24},   // Earth-Moon barycenter, Earth
+        {"301", 7.342e22},                          // Moon
+        {"4",   6.4171e23},   {"499", 6.4171e23},   // Mars
+        {"5",   1.89858e27},  {"599", 1.8982e27},   // Jupiter
+        {"6",   5.68477e26},  {"699", 5.6834e26},   // Saturn
+        {"7",   8.6816e25},   {"799", 8.681e25},    // Uranus
+        {"8",   1.024355e26}, {"899", 1.02413e26},  // Neptune
+        {"9",   1.4631e22},   {"999", 1.303e22},    // Pluto
+    };
+
+    for (const Entry& e : table) {
+        if (naifId == e.id) return e.mass;
+    }
+    return 0.0;
+}
+
+/********************
+ * assembleHorizonsSystem
+ *********************/
+std::vector<CelestialBody> assembleHorizonsSystem(const std::vector<HorizonsEphemeris>& ephems,
+                                                  SystemMetadata& meta)
+{
+    if (ephems.empty()) {
+        throw std::runtime_error("No HORIZONS ephemerides to assemble");
+    }
+
+    const HorizonsEphemeris& ref = ephems.front();
+    const double epochJD = ref.states.front().jdTDB;
+
+    std::vector<CelestialBody> bodies;
+    bodies.reserve(ephems.size());
+
+    for (const HorizonsEphemeris& e : ephems) {
+        const HorizonsState& s = e.states.front();
+
+        if (std::fabs(s.jdTDB - epochJD) > 1.0e-9) {
+            throw std::runtime_error("Epoch mismatch: " + e.targetName + " starts at JD "
+                                     + std::to_string(s.jdTDB) + ", expected "
+                                     + std::to_string(epochJD));
+        }
+        if (e.centerId != ref.centerId || e.centerName != ref.centerName) {
+            throw std::runtime_error("Center mismatch: " + e.targetName + " is relative to '"
+                                     + e.centerName + "', expected '" + ref.centerName + "'");
+        }
+
+        double mass = (e.gm > 0.0) ? e.gm / physics::constants::G
+                                   : naifFallbackMass(e.targetId);
+        if (mass <= 0.0) {
+            throw std::runtime_error("No GM in HORIZONS header and no fallback mass for "
+                                     + e.targetName + " (" + e.targetId + ")");
+        }
+
+        bodies.emplace_back(e.targetName, mass,
+                            s.position.x(), s.position.y(), s.position.z(),
+                            s.velocity.x(), s.velocity.y(), s.velocity.z(),
+                            0.0, 0.0, 0.0);
+    }
+
+    meta.epoch = ref.states.front().calendar;
+    meta.name  = "HORIZONS vectors relative to " + ref.centerName;
+    return bodies;
+}
+
+// ============================================================
+//  Calendar → Julian date
+// ============================================================
+
+namespace {
+
+/********************
+ * parseMonth
+ * @brief: "01".."12" or "Jan".."Dec" (any case) → 1..12, 0 on failure.
+ *********************/
+int parseMonth(sv s) {
+    static const char* names[] = {"jan", "feb", "mar", "apr", "may", "jun",
+                                  "jul", "aug", "sep", "oct", "nov", "dec"};
+    if (s.size() == 3 && !isDigit(s[0])) {
+        for (int m = 0; m < 12; ++m) {
+            bool same = true;
+            for (int k = 0; k < 3; ++k) {
+                if ((s[k] | 0x20) != names[m][k]) { same = false; break; }
+            }
+            if (same) return m + 1;
+        }
+        return 0;
+    }
+    int m = 0;
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), m);
+    return (ec == std::errc() && ptr == s.data() + s.size() && m >= 1 && m <= 12) ? m : 0;
+}
+
+} // namespace
+
+bool calendarToJD(std::string_view text, double& jd) {
+    sv s = trim(text);
+    if (s.substr(0, 5) == "A.D. ") s = trim(s.substr(5));
+    if (s.substr(0, 2) == "JD")    s = trim(s.substr(2));
+
+    // Plain Julian date: a number not followed by a date separator
+    {
+        sv probe = s;
+        double value = 0.0;
+        if (parseNumber(probe, value) && (probe.empty() || probe.front() != '-')) {
+            if (!trim(probe).empty() && trim(probe) != "TDB") return false;
+            jd = value;
+            return true;
+        }
+    }
+
+    // YYYY-MM-DD or YYYY-Mon-DD
+    const std::size_t d1 = s.find('-');
+    const std::size_t d2 = (d1 == sv::npos) ? sv::npos : s.find('-', d1 + 1);
+    if (d1 == sv::npos || d2 == sv::npos) return false;
+
+    int year = 0, day = 0;
+    auto [py, ey] = std::from_chars(s.data(), s.data() + d1, year);
+    if (ey != std::errc() || py != s.data() + d1) return false;
+
+    const int month = parseMonth(s.substr(d1 + 1, d2 - d1 - 1));
+    if (month == 0) return false;
+
+    sv rest = s.substr(d2 + 1);
+    auto [pd, ed] = std::from_chars(rest.data(), rest.data() + rest.size(), day);
+    if (ed != std::errc() || day < 1 || day > 31) return false;
+    rest.remove_prefix(static_cast<std::size_t>(pd - rest.data()));
+
+    // Optional [ T]hh:mm[:ss[.fff]]
+    double seconds = 0.0;
+    if (!rest.empty() && (rest.front() == 'T' || isSpace(rest.front()))) {
+        rest = trim(rest.substr(1));
+        double hh = 0.0, mm = 0.0, ss = 0.0;
+        if (!rest.empty() && isDigit(rest.front())) {
+            if (!parseNumber(rest, hh)) return false;
+            if (!rest.empty() && rest.front() == ':') {
+                rest.remove_prefix(1);
+                if (!parseNumber(rest, mm)) return false;
+                if (!rest.empty() && rest.front() == ':') {
+                    rest.remove_prefix(1);
+                    if (!parseNumber(rest, ss)) return false;
+                }
+            }
+        }
+        seconds = hh * 3600.0 + mm * 60.0 + ss;
+    }
+    rest = trim(rest);
+    if (!rest.empty() && rest != "TDB" && rest != "TT" && rest != "UTC" && rest != "UT") {
+        return false;
+    }
+
+    // Meeus, Astronomical Algorithms ch. 7 (Gregorian calendar)
+    int y = year, m = month;
+    if (m <= 2) { y -= 1; m += 12; }
+    const int a = y / 100;
+    const int b = 2 - a + a / 4;
+    jd = std::floor(365.25 * (y + 4716)) + std::floor(30.6001 * (m + 1))
+       + day + b - 1524.5 + seconds / 86400.0;
+    return true;
+}
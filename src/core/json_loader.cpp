@@ -3,60 +3,355 @@
  * File: json_loader.cpp
  * Date: 11/18/2025
  * Purpose: Implementation of JSON loader for N-body systems.
+ *
+ * Notes:
+ *  - Uses nlohmann::json's SAX interface: bodies are built directly from
+ *    parse events, so no DOM is ever materialized (large catalogs load in
+ *    a single pass with memory ~ file size + body vector).
+ *  - Error messages match the previous DOM-based loader (which used
+ *    json::at() / get<>()), so scripts grepping them keep working.
+ *    A non-array "bodies" is now an error: the DOM loader silently
+ *    iterated an object's values (or a scalar) as bodies.
  ******************/
 
 #include "json_loader.h"
 
+#include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
 #include <stdexcept>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
-std::vector<CelestialBody> loadSystemFromJSON(const std::string& path) {
+namespace {
+
+/***********************
+ * struct FieldValue
+ * @brief: One scalar seen for a body field (or array element).
+ ***********************/
+struct FieldValue {
+    const char* type = nullptr;   ///< nlohmann type name; nullptr = missing
+    double      number = 0.0;
+};
+
+/***********************
+ * struct VectorField
+ * @brief: "position"/"velocity" as seen in the stream.
+ ***********************/
+struct VectorField {
+    const char* type = nullptr;   ///< "array" when well-formed
+    FieldValue  elems[3];
+    std::size_t count = 0;        ///< number of elements in the array
+};
+
+/***********************
+ * class BodySaxHandler
+ * @brief: SAX consumer that turns {"bodies":[{...},...]} into CelestialBody.
+ *
+ * Every value event is routed by the depth of the container it lives in:
+ *   0: document root        (must be an object to yield bodies)
+ *   1: root object          ("bodies" is entered, other keys are skipped)
+ *   2: bodies array         (each element must be an object)
+ *   3: body object          (name, mass, position, velocity; rest skipped)
+ *   4: position / velocity  (first three elements are kept)
+ * Containers that are not entered are skipped wholesale via skipDepth.
+ ***********************/
+class BodySaxHandler : public json::json_sax_t {
+public:
+    BodySaxHandler(std::vector<CelestialBody>& out, SystemMetadata* metaOut)
+        : bodies(out), meta(metaOut) {}
+
+    // ---- scalars ----
+    bool null() override                               { value("null", 0.0); return true; }
+    bool boolean(bool) override                        { value("boolean", 0.0); return true; }
+    bool number_integer(number_integer_t v) override   { value("number", static_cast<double>(v)); return true; }
+    bool number_unsigned(number_unsigned_t v) override { value("number", static_cast<double>(v)); return true; }
+    bool number_float(number_float_t v, const string_t&) override { value("number", v); return true; }
+    bool binary(binary_t&) override                    { value("binary", 0.0); return true; }
+
+    bool string(string_t& s) override {
+        if (!skipDepth && depth == 3 && field == Field::Name) {
+            nameValue = std::move(s);
+        }
+        else if (!skipDepth && depth == 1 && meta) {
+            if      (rootKey == "name")  meta->name  = s;
+            else if (rootKey == "epoch") meta->epoch = s;
+        }
+        value("string", 0.0);
+        return true;
+    }
+
+    // ---- containers ----
+    bool start_object(std::size_t) override {
+        const bool enter = value("object", 0.0);
+        ++depth;
+        if (!enter && !skipDepth) skipDepth = depth;
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        const bool enter = value("array", 0.0);
+        ++depth;
+        if (!enter && !skipDepth) skipDepth = depth;
+        return true;
+    }
+
+    bool end_object() override {
+        if (skipDepth == depth)                skipDepth = 0;
+        else if (!skipDepth && depth == 3)     finishBody();
+        --depth;
+        return true;
+    }
+
+    bool end_array() override {
+        if (skipDepth == depth) skipDepth = 0;
+        --depth;
+        return true;
+    }
+
+    bool key(string_t& k) override {
+        if (skipDepth) return true;
+        if (depth == 1) {
+            rootKey = k;
+        } else if (depth == 3) {
+            if      (k == "name")     field = Field::Name;
+            else if (k == "mass")     field = Field::Mass;
+            else if (k == "position") field = Field::Position;
+            else if (k == "velocity") field = Field::Velocity;
+            else                      field = Field::Other;
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        // Same exception type (and what()) the DOM parser would have
+        // thrown: `ex` arrives as the base class, so restore the
+        // subclass from the id range, as nlohmann's own DOM parser does
+        switch ((ex.id / 100) % 100) {
+            case 1:  throw *static_cast<const json::parse_error*>(&ex);
+            case 2:  throw *static_cast<const json::invalid_iterator*>(&ex);
+            case 3:  throw *static_cast<const json::type_error*>(&ex);
+            case 4:  throw *static_cast<const json::out_of_range*>(&ex);
+            default: throw *static_cast<const json::other_error*>(&ex);
+        }
+    }
+
+private:
+    enum class Field { None, Name, Mass, Position, Velocity, Other };
+
+    VectorField& vectorField() { return field == Field::Position ? position : velocity; }
+
+    /*****************
+     * value
+     * @brief: Handles one value (scalar or container start) in the
+     *         container at the current depth.
+     * @return: true if a container value should be entered
+     *****************/
+    bool value(const char* type, double v) {
+        if (skipDepth) return false;
+
+        const bool isArray  = std::strcmp(type, "array")  == 0;
+        const bool isObject = std::strcmp(type, "object") == 0;
+
+        switch (depth) {
+            case 0:     // document root (null reads as an empty system)
+                if (!isObject && std::strcmp(type, "null") != 0) {
+                    throw std::runtime_error(std::string("[json.exception.type_error.305] cannot use "
+                                                         "operator[] with a string argument with ")
+                                             + type);
+                }
+                return isObject;
+
+            case 1:     // member of root object
+                if (rootKey != "bodies") return false;
+                if (!isArray && std::strcmp(type, "null") != 0) {
+                    // An object would iterate its values as bodies; reject it
+                    throw std::runtime_error(std::string("[json.exception.type_error.302] type must be "
+                                                         "array, but is ")
+                                             + type);
+                }
+                return isArray;
+
+            case 2:     // element of "bodies"
+                if (!isObject) {
+                    throw std::runtime_error(std::string("[json.exception.type_error.304] cannot use at() with ")
+                                             + type);
+                }
+                beginBody();
+                return true;
+
+            case 3:     // body field
+                switch (field) {
+                    case Field::Name: name = {type, v}; break;
+                    case Field::Mass: mass = {type, v}; break;
+                    case Field::Position:
+                    case Field::Velocity:
+                        vectorField().type  = type;
+                        vectorField().count = 0;
+                        return isArray;
+                    default: break;
+                }
+                return false;
+
+            case 4: {   // element of position / velocity
+                VectorField& f = vectorField();
+                if (f.count < 3) f.elems[f.count] = {type, v};
+                ++f.count;
+                return false;
+            }
+
+            default:
+                return false;
+        }
+    }
+
+    void beginBody() {
+        field     = Field::None;
+        name      = {};
+        mass      = {};
+        position  = {};
+        velocity  = {};
+        nameValue.clear();
+    }
+
+    // Mirrors the checks (and messages) of b.at(key).get<T>()
+    static void requireKey(const char* type, const char* key) {
+        if (!type) {
+            throw std::runtime_error(std::string("[json.exception.out_of_range.403] key '")
+                                     + key + "' not found");
+        }
+    }
+    static void requireType(const char* type, const char* expected) {
+        if (std::strcmp(type, expected) != 0) {
+            throw std::runtime_error(std::string("[json.exception.type_error.302] type must be ")
+                                     + expected + ", but is " + type);
+        }
+    }
+    static double component(const VectorField& f, std::size_t i) {
+        if (std::strcmp(f.type, "array") != 0) {
+            throw std::runtime_error(std::string("[json.exception.type_error.304] cannot use at() with ")
+                                     + f.type);
+        }
+        if (i >= f.count) {
+            throw std::runtime_error("[json.exception.out_of_range.401] array index "
+                                     + std::to_string(i) + " is out of range");
+        }
+        requireType(f.elems[i].type, "number");
+        return f.elems[i].number;
+    }
+
+    void finishBody() {
+        requireKey(name.type, "name");
+        requireType(name.type, "string");
+        requireKey(mass.type, "mass");
+        requireType(mass.type, "number");
+        requireKey(position.type, "position");
+        requireKey(velocity.type, "velocity");
+
+        double x  = component(position, 0);
+        double y  = component(position, 1);
+        double z  = component(position, 2);
+        double vx = component(velocity, 0);
+        double vy = component(velocity, 1);
+        double vz = component(velocity, 2);
+
+        bodies.emplace_back(
+            nameValue,
+            mass.number,
+            x,  y,  z,
+            vx, vy, vz,
+            0.0, 0.0, 0.0   // ax, ay, az
+        );
+    }
+
+    std::vector<CelestialBody>& bodies;
+    SystemMetadata*             meta;
+
+    std::size_t depth     = 0;
+    std::size_t skipDepth = 0;      ///< depth of the container being skipped (0 = none)
+    std::string rootKey;
+    Field       field     = Field::None;
+
+    FieldValue  name;
+    std::string nameValue;
+    FieldValue  mass;
+    VectorField position;
+    VectorField velocity;
+};
+
+} // namespace
+
+std::vector<CelestialBody> loadSystemFromJSON(const std::string& path,
+                                              SystemMetadata* meta) {
     /**********************
      * loadSystemFromJSON
      * @brief: Loads celestial bodies from a JSON file.
      * @param: path - file path to JSON configuration
+     * @param: meta - optional out-param for top-level "name"/"epoch"
      * @return: vector of CelestialBody instances
-     * @exception: throws runtime_error if file cannot be opened
+     * @exception: throws runtime_error if file cannot be opened,
+     *             json::parse_error on malformed JSON, and runtime_error
+     *             for a root that is not an object, a "bodies" that is
+     *             not an array, or missing/mistyped body fields
      * @note: Expects JSON structure with "bodies" array containing
-     *        name, mass, position [x,y,z], velocity [vx,vy,vz]
+     *        name, mass, position [x,y,z], velocity [vx,vy,vz].
+     *        Streams SAX events straight into the vector (no DOM).
      **********************/
-    std::ifstream file(path);
+    std::FILE* file = std::fopen(path.c_str(), "rb");
     if (!file) {
         throw std::runtime_error("Could not open JSON file: " + path);
     }
 
-    json j;
-    file >> j;
+    // Slurp raw bytes (one allocation, ~file size)
+    std::string text;
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    if (size > 0) {
+        text.resize(static_cast<std::size_t>(size));
+        text.resize(std::fread(&text[0], 1, text.size(), file));
+    }
+    std::fclose(file);
 
-    std::vector<CelestialBody> bodies;
+    if (meta) *meta = SystemMetadata{};
 
-    for (const auto& b : j["bodies"]) {
-        // Parse body attributes
-        std::string name = b.at("name").get<std::string>();
-        double mass      = b.at("mass").get<double>();
-        // position and velocity arrays
-        auto p = b.at("position");
-        auto v = b.at("velocity");
-        // Extract components
-        double x  = p.at(0).get<double>();
-        double y  = p.at(1).get<double>();
-        double z  = p.at(2).get<double>();
-        // velocity components
-        double vx = v.at(0).get<double>();
-        double vy = v.at(1).get<double>();
-        double vz = v.at(2).get<double>();
-        // Create CelestialBody and add to vector
-        bodies.emplace_back(
-            name,
-            mass,
-            x,  y,  z,
-            vx, vy, vz,
-            0.0, 0.0, 0.0   // ax, ay, az
-        );
-    }   // end for loop
+    std::vector<CelestialBody> bodies;
+    BodySaxHandler handler(bodies, meta);
+    json::sax_parse(text.begin(), text.end(), &handler);
 
     return bodies;
 } // end loadSystemFromJSON
+
+/**********************
+ * writeSystemJSON
+ * @brief: Serializes bodies back to a system JSON file.
+ * @note: nlohmann prints doubles with round-trip precision, so
+ *        JSON → snapshot → JSON is lossless.
+ **********************/
+bool writeSystemJSON(const std::string& path,
+                     const std::vector<CelestialBody>& bodies,
+                     const SystemMetadata& meta)
+{
+    // ordered_json keeps the hand-written key order (name, epoch, bodies)
+    nlohmann::ordered_json j = nlohmann::ordered_json::object();
+    if (!meta.name.empty())  j["name"]  = meta.name;
+    if (!meta.epoch.empty()) j["epoch"] = meta.epoch;
+
+    nlohmann::ordered_json list = nlohmann::ordered_json::array();
+    for (const auto& b : bodies) {
+        list.push_back({
+            {"name",     b.name},
+            {"mass",     b.mass},
+            {"position", {b.position.x(), b.position.y(), b.position.z()}},
+            {"velocity", {b.velocity.x(), b.velocity.y(), b.velocity.z()}}
+        });
+    }
+    j["bodies"] = std::move(list);
+
+    std::ofstream out(path);
+    if (!out) return false;
+    out << std::setw(2) << j << "\n";
+    return static_cast<bool>(out);
+} // end writeSystemJSON
@@ -0,0 +1,135 @@
+/********************
+ * Author: Sinan Demir
+ * File: kernels.cpp
+ * Date: 10/16/2026
+ * Purpose:
+ *    Startup selection of the kernel backend (cpuid + ORBIT_ISA) and the
+ *    CelestialBody -> flat state packing used by the callers.
+ *********************/
+
+#include "kernels.h"
+#include "body.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace kernels {
+namespace {
+
+/********************
+ * struct Candidate
+ * @brief: A compiled-in backend and whether this CPU can run it.
+ *********************/
+struct Candidate {
+    const Backend& (*get)();
+    const char*    name;
+    bool           supported;
+};
+
+/// Backends in preference order (best first); the baseline always runs.
+std::vector<Candidate> candidates() {
+    std::vector<Candidate> c;
+#if defined(ORBIT_KERNELS_X86)
+    __builtin_cpu_init();
+    c.push_back({detail::avx512Backend, "avx512",
+                 __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+                 __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx2") &&
+                 __builtin_cpu_supports("fma")});
+    c.push_back({detail::avx2Backend, "avx2",
+                 __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")});
+#endif
+    c.push_back({detail::baselineBackend, detail::baselineBackend().name, true});
+    return c;
+}
+
+struct Selection {
+    const Backend* backend;
+    const char*    best;       ///< best level the CPU supports
+    std::string    override;   ///< ORBIT_ISA as given ("" if unset/auto)
+};
+
+/********************
+ * select
+ * @brief: Picks the best supported backend, or the one named by ORBIT_ISA
+ *         if it is compiled in and supported. Bad overrides fall back to
+ *         the best backend with a warning.
+ *********************/
+Selection select() {
+    const std::vector<Candidate> all = candidates();
+
+    const Candidate* best = nullptr;
+    for (const Candidate& c : all) {
+        if (c.supported) { best = &c; break; }
+    }
+
+    Selection s{&best->get(), best->name, ""};
+
+    const char* env = std::getenv("ORBIT_ISA");
+    if (!env || !*env || std::string(env) == "auto") {
+        return s;
+    }
+
+    std::string want = env;
+    if (want == "generic" || want == "sse2" || want == "scalar") {
+        want = all.back().name;
+    }
+
+    for (const Candidate& c : all) {
+        if (want != c.name) continue;
+
+        if (!c.supported) {
+            std::cerr << "⚠️ ORBIT_ISA=" << env << " is not supported by this CPU; using "
+                      << best->name << "\n";
+            return s;
+        }
+        s.backend  = &c.get();
+        s.override = env;
+        return s;
+    }
+
+    std::cerr << "⚠️ ORBIT_ISA=" << env << " is not a known backend (";
+    for (const Candidate& c : all) {
+        std::cerr << c.name << (&c == &all.back() ? "" : ", ");
+    }
+    std::cerr << "); using " << best->name << "\n";
+    return s;
+}
+
+const Selection& selection() {
+    static const Selection s = select();
+    return s;
+}
+
+} // namespace
+
+const Backend& active() {
+    return *selection().backend;
+}
+
+std::string describe() {
+    const Selection& s = selection();
+    std::string d = s.backend->name;
+    d += std::string(" (cpu: ") + s.best;
+    if (!s.override.empty()) d += ", ORBIT_ISA=" + s.override;
+    d += ")";
+    return d;
+}
+
+void packState(const std::vector<CelestialBody>& bodies,
+               std::vector<double>& state,
+               std::vector<double>& mass) {
+    const std::size_t n = bodies.size();
+    state.resize(6 * n);
+    mass.resize(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const CelestialBody& b = bodies[i];
+        for (int c = 0; c < 3; ++c) {
+            state[c * n + i]       = b.position[c];
+            state[(3 + c) * n + i] = b.velocity[c];
+        }
+        mass[i] = b.mass;
+    }
+}
+
+} // namespace kernels
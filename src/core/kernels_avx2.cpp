@@ -0,0 +1,21 @@
+/********************
+ * Author: Sinan Demir
+ * File: kernels_avx2.cpp
+ * Date: 10/16/2026
+ * Purpose:
+ *    Kernel backend for AVX2 + FMA CPUs (compiled with -mavx2 -mfma,
+ *    see CMakeLists.txt). Only called after cpuid reports both.
+ *********************/
+
+#include "kernels_impl.h"
+
+namespace kernels {
+namespace detail {
+
+const Backend& avx2Backend() {
+    static const Backend backend = makeBackend("avx2");
+    return backend;
+}
+
+} // namespace detail
+} // namespace kernels
@@ -0,0 +1,22 @@
+/********************
+ * Author: Sinan Demir
+ * File: kernels_avx512.cpp
+ * Date: 10/16/2026
+ * Purpose:
+ *    Kernel backend for AVX-512 CPUs (compiled with -mavx512f -mavx512dq
+ *    -mavx512vl and 512-bit preferred vectors, see CMakeLists.txt). Only
+ *    called after cpuid reports AVX-512F.
+ *********************/
+
+#include "kernels_impl.h"
+
+namespace kernels {
+namespace detail {
+
+const Backend& avx512Backend() {
+    static const Backend backend = makeBackend("avx512");
+    return backend;
+}
+
+} // namespace detail
+} // namespace kernels
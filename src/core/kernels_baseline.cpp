@@ -0,0 +1,24 @@
+/********************
+ * Author: Sinan Demir
+ * File: kernels_baseline.cpp
+ * Date: 10/16/2026
+ * Purpose:
+ *    Kernel backend built with the target's default flags (SSE2 on x86-64).
+ *********************/
+
+#include "kernels_impl.h"
+
+namespace kernels {
+namespace detail {
+
+const Backend& baselineBackend() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    static const Backend backend = makeBackend("sse2");
+#else
+    static const Backend backend = makeBackend("generic");
+#endif
+    return backend;
+}
+
+} // namespace detail
+} // namespace kernels
@@ -0,0 +1,214 @@
+/********************
+ * Author: Sinan Demir
+ * File: profiler.cpp
+ * Date: 10/16/2026
+ * Purpose:
+ *    Zone registry, accumulation, breakdown table and Chrome trace export
+ *    for the scoped timers in profiler.h.
+ *********************/
+
+#include "profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace profiling {
+namespace detail {
+
+bool active = false;
+
+namespace {
+
+struct Zone {
+    const char*   name;
+    std::uint64_t calls = 0;
+    std::uint64_t total = 0;   ///< inclusive ticks
+    std::uint64_t self  = 0;   ///< total minus nested zones
+    int           depth = -1;  ///< nesting depth at first entry
+};
+
+struct Event {
+    int           zone;
+    std::uint64_t begin;
+    std::uint64_t duration;
+};
+
+constexpr std::size_t MAX_EVENTS = std::size_t(1) << 22;   // ~100 MB of trace
+
+std::mutex          registryMutex;
+std::vector<Zone>   zones;
+std::vector<Scope*> stack;
+std::vector<Event>  events;
+std::thread::id     owner;
+bool                tracing = false;
+std::uint64_t       dropped = 0;
+
+// Storage for openScope(); one slot per nesting level
+constexpr std::size_t OUTLINE_DEPTH = 16;
+alignas(Scope) unsigned char outlineScopes[OUTLINE_DEPTH][sizeof(Scope)];
+std::size_t outlineDepth = 0;
+
+// Tick <-> wall clock calibration, taken at start() and stop()
+std::uint64_t                         startTicks = 0, stopTicks = 0;
+std::chrono::steady_clock::time_point startWall, stopWall;
+
+double nsPerTick() {
+    const double ns = std::chrono::duration<double, std::nano>(stopWall - startWall).count();
+    const double t  = static_cast<double>(stopTicks - startTicks);
+    return (t > 0.0 && ns > 0.0) ? ns / t : 1.0;
+}
+
+} // namespace
+
+int registerZone(const char* name) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    // Call sites sharing a name (e.g. "forces" in every integrator and
+    // kernel translation unit) share one row
+    for (std::size_t i = 0; i < zones.size(); ++i) {
+        if (std::strcmp(zones[i].name, name) == 0) return static_cast<int>(i);
+    }
+    zones.push_back(Zone{name});
+    return static_cast<int>(zones.size() - 1);
+}
+
+bool enter(Scope* scope) {
+    if (std::this_thread::get_id() != owner) return false;
+
+    stack.push_back(scope);
+    return true;
+}
+
+void leave(int zone, std::uint64_t begin, std::uint64_t end, std::uint64_t children) {
+    stack.pop_back();
+    const std::uint64_t elapsed = end - begin;
+
+    Zone& z = zones[static_cast<std::size_t>(zone)];
+    if (z.depth < 0) z.depth = static_cast<int>(stack.size());
+    ++z.calls;
+    z.total += elapsed;
+    z.self  += elapsed > children ? elapsed - children : 0;
+
+    if (!stack.empty()) stack.back()->children += elapsed;
+
+    if (tracing) {
+        if (events.size() < MAX_EVENTS) events.push_back(Event{zone, begin, elapsed});
+        else ++dropped;
+    }
+}
+
+bool openScope(int zone) {
+    if (outlineDepth == OUTLINE_DEPTH || std::this_thread::get_id() != owner) return false;
+    new (outlineScopes[outlineDepth++]) Scope(zone);
+    return true;
+}
+
+void closeScope() {
+    std::launder(reinterpret_cast<Scope*>(outlineScopes[--outlineDepth]))->~Scope();
+}
+
+} // namespace detail
+
+using namespace detail;
+
+void start(bool recordTrace) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (Zone& z : zones) {
+        z.calls = z.total = z.self = 0;
+        z.depth = -1;
+    }
+    stack.clear();
+    events.clear();
+    dropped = 0;
+    tracing = recordTrace;
+    owner = std::this_thread::get_id();
+
+    startWall  = std::chrono::steady_clock::now();
+    startTicks = ticks();
+    stopTicks  = startTicks;
+    stopWall   = startWall;
+    active = true;
+}
+
+void stop() {
+    active = false;
+    stopTicks = ticks();
+    stopWall  = std::chrono::steady_clock::now();
+}
+
+void report(std::ostream& os) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    const double scale = nsPerTick();
+    std::uint64_t outer = 0;
+    std::size_t width = 4;
+    for (const Zone& z : zones) {
+        if (z.calls == 0) continue;
+        if (z.depth == 0) outer += z.total;
+        width = std::max(width, std::char_traits<char>::length(z.name) + 2 * z.depth);
+    }
+    if (outer == 0) {
+        os << "Profile: no zones recorded\n";
+        return;
+    }
+
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-*s %10s %12s %12s %7s %12s\n", static_cast<int>(width),
+                  "zone", "calls", "total ms", "self ms", "%", "ns/call");
+#ifdef ORBIT_PROFILE_RDTSC
+    os << "Profile (rdtsc, " << 1.0 / scale << " ticks/ns)\n" << line;
+#else
+    os << "Profile (steady_clock)\n" << line;
+#endif
+
+    for (const Zone& z : zones) {
+        if (z.calls == 0) continue;
+        const std::string name = std::string(2 * static_cast<std::size_t>(z.depth), ' ') + z.name;
+        std::snprintf(line, sizeof(line), "%-*s %10llu %12.3f %12.3f %7.2f %12.1f\n",
+                      static_cast<int>(width), name.c_str(),
+                      static_cast<unsigned long long>(z.calls),
+                      static_cast<double>(z.total) * scale * 1e-6,
+                      static_cast<double>(z.self) * scale * 1e-6,
+                      100.0 * static_cast<double>(z.total) / static_cast<double>(outer),
+                      static_cast<double>(z.total) * scale / static_cast<double>(z.calls));
+        os << line;
+    }
+    if (dropped > 0) {
+        os << "⚠️ Trace buffer full: " << dropped << " events dropped\n";
+    }
+}
+
+bool writeChromeTrace(const std::string& path) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (!tracing) return false;
+
+    std::ofstream out(path);
+    if (!out) return false;
+
+    // Trace-event "complete" events; timestamps are microseconds since start()
+    const double usPerTick = nsPerTick() * 1e-3;
+    char buf[256];
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+    for (const Event& e : events) {
+        std::snprintf(buf, sizeof(buf),
+                      "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                      first ? "" : ",\n", zones[static_cast<std::size_t>(e.zone)].name,
+                      static_cast<double>(e.begin - startTicks) * usPerTick,
+                      static_cast<double>(e.duration) * usPerTick);
+        out << buf;
+        first = false;
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+} // namespace profiling
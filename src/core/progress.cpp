@@ -0,0 +1,146 @@
+/********************
+ * Author: Sinan Demir
+ * File: progress.cpp
+ * Date: 10/16/2026
+ * Purpose:
+ *    Implementation of the runSimulation progress reporter.
+ *********************/
+
+#include "progress.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+/// Target wall time between two clock reads in the integration loop.
+constexpr double CHECK_SECONDS = 0.05;
+
+bool stderrIsTerminal() {
+#if defined(__unix__) || defined(__APPLE__)
+    return ::isatty(STDERR_FILENO) != 0;
+#else
+    return false;
+#endif
+}
+
+/// 1234567 -> "1.23M"
+std::string siCount(double x) {
+    const char* units[] = {"", "k", "M", "G"};
+    int u = 0;
+    while (x >= 1000.0 && u < 3) {
+        x /= 1000.0;
+        ++u;
+    }
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), u == 0 ? "%.0f" : "%.2f%s", x, units[u]);
+    return buf;
+}
+
+/// 3725 -> "1h02m05s"
+std::string duration(double s) {
+    if (!(s >= 0.0) || s > 1e9) return "?";
+    const long t = static_cast<long>(s + 0.5);
+    char buf[32];
+    if (t >= 3600)    std::snprintf(buf, sizeof(buf), "%ldh%02ldm%02lds", t / 3600, t / 60 % 60, t % 60);
+    else if (t >= 60) std::snprintf(buf, sizeof(buf), "%ldm%02lds", t / 60, t % 60);
+    else              std::snprintf(buf, sizeof(buf), "%lds", t);
+    return buf;
+}
+
+} // namespace
+
+bool ProgressReporter::begin(const ProgressOptions& options, int totalSteps, double stepDt)
+{
+    total    = totalSteps;
+    dt       = stepDt;
+    interval = std::max(0.0, options.intervalSeconds);
+    console  = options.console == ProgressOptions::Console::On ||
+               (options.console == ProgressOptions::Console::Auto && stderrIsTerminal());
+    rewrite  = console && stderrIsTerminal();
+
+    bool ok = true;
+    if (!options.statusPath.empty()) {
+        status.open(options.statusPath, std::ios::trunc);
+        ok = static_cast<bool>(status);
+    }
+    enabled = console || status.is_open();
+
+    start = lastReport = lastCheck = Clock::now();
+    checkEvery = nextCheck = 1;
+    lastStep = lastCheckStep = 0;
+    return ok;
+}
+
+void ProgressReporter::update(int step, double dE)
+{
+    const Clock::time_point now = Clock::now();
+
+    // Re-aim K so the next clock read lands ~CHECK_SECONDS from now
+    const double since = std::chrono::duration<double>(now - lastCheck).count();
+    if (since > 0.0 && step > lastCheckStep) {
+        const double perStep = since / (step - lastCheckStep);
+        checkEvery = static_cast<int>(std::clamp(CHECK_SECONDS / perStep, 1.0, 1048576.0));
+    }
+    lastCheck = now;
+    lastCheckStep = step;
+    nextCheck = step + checkEvery;
+
+    if (std::chrono::duration<double>(now - lastReport).count() >= interval) {
+        emit(step, dE, false);
+    }
+}
+
+void ProgressReporter::finish(int step, double dE)
+{
+    if (enabled) emit(step, dE, true);
+    enabled = false;
+    if (status.is_open()) status.close();
+}
+
+void ProgressReporter::emit(int step, double dE, bool done)
+{
+    const Clock::time_point now = Clock::now();
+    const double elapsed = std::chrono::duration<double>(now - start).count();
+    const double window  = std::chrono::duration<double>(now - lastReport).count();
+
+    // Recent rate for the display, whole-run average for the ETA
+    const double average = elapsed > 0.0 ? step / elapsed : 0.0;
+    const double rate    = (window > 0.0 && step > lastStep) ? (step - lastStep) / window : average;
+    const double eta     = average > 0.0 ? (total - step) / average : -1.0;
+    const double simWall = elapsed > 0.0 ? step * dt / elapsed : 0.0;
+    const double percent = total > 0 ? 100.0 * step / total : 100.0;
+
+    if (console) {
+        char line[256];
+        std::snprintf(line, sizeof(line),
+                      "%s %5.1f%%  %d/%d steps | %s steps/s | sim/wall %.3gx | %s %s | dE_rel %.2e",
+                      done ? "✅" : "⏳", percent, step, total, siCount(rate).c_str(), simWall,
+                      done ? "elapsed" : "ETA", duration(done ? elapsed : eta).c_str(), dE);
+        if (rewrite) std::cerr << "\r" << line << "\033[K" << (done ? "\n" : "") << std::flush;
+        else         std::cerr << line << "\n";
+    }
+
+    if (status.is_open()) {
+        char energy[32] = "null";   // JSON has no NaN (e.g. zero initial energy)
+        if (std::isfinite(dE)) std::snprintf(energy, sizeof(energy), "%.6e", dE);
+
+        char line[512];
+        std::snprintf(line, sizeof(line),
+                      "{\"state\":\"%s\",\"step\":%d,\"steps\":%d,\"fraction\":%.6f,"
+                      "\"elapsed_s\":%.3f,\"steps_per_sec\":%.6g,\"sim_time_s\":%.17g,"
+                      "\"sim_wall_ratio\":%.6g,\"eta_s\":%.3f,\"dE_rel\":%s}\n",
+                      done ? "done" : "running", step, total, percent / 100.0, elapsed, rate,
+                      step * dt, simWall, done ? 0.0 : std::max(eta, 0.0), energy);
+        status << line << std::flush;
+    }
+
+    lastReport = now;
+    lastStep = step;
+}
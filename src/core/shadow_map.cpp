@@ -0,0 +1,303 @@
+/****************
+ * File: shadow_map.cpp
+ * Author: Sinan Demir
+ * Date: 10/16/2026
+ *
+ * Purpose:
+ *    Implements the tile-based CPU shadow-map ray tracer:
+ *      - surface ray toward the Sun for each map pixel
+ *      - cheap penumbra-cone rejection
+ *      - analytic two-disk overlap integrated over limb-darkened annuli
+ *
+ * References:
+ *    Limb darkening: linear law I(mu) = 1 - u (1 - mu), u ≈ 0.6 in the
+ *    visible band (Cox, "Allen's Astrophysical Quantities", 4th ed.).
+ *****************/
+
+#include "shadow_map.h"
+#include "ray.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+// ---- helper: area of intersection of two circles ---- //
+static inline double circleOverlap(double r1, double r2, double d) {
+    /*****************
+     * Area shared by circles of radius r1 and r2 whose centers are d apart.
+     * @note: Planar formula; fine for the sub-degree disks involved here.
+     *****************/
+    if (r1 <= 0.0 || r2 <= 0.0) return 0.0;
+    if (d >= r1 + r2) return 0.0;
+    if (d <= std::fabs(r1 - r2)) {
+        const double r = std::min(r1, r2);
+        return M_PI * r * r;
+    }
+
+    const double c1 = std::clamp((d*d + r1*r1 - r2*r2) / (2.0 * d * r1), -1.0, 1.0);
+    const double c2 = std::clamp((d*d + r2*r2 - r1*r1) / (2.0 * d * r2), -1.0, 1.0);
+    const double k  = (-d + r1 + r2) * (d + r1 - r2) * (d - r1 + r2) * (d + r1 + r2);
+
+    return r1*r1 * std::acos(c1) + r2*r2 * std::acos(c2) - 0.5 * std::sqrt(std::max(0.0, k));
+}
+
+/****************
+ * ShadowMapRenderer (constructor)
+ * @brief: Precomputes per-row/per-column trig and limb-darkening weights.
+ *****************/
+ShadowMapRenderer::ShadowMapRenderer(const ShadowMapOptions& options)
+    : opt(options), pool(options.threads)
+{
+    opt.width     = std::max(1, opt.width);
+    opt.height    = std::max(1, opt.height);
+    opt.tileRows  = std::max(1, opt.tileRows);
+    opt.limbRings = std::max(1, opt.limbRings);
+
+    // Latitude per row: +90° (top) → -90° (bottom), pixel centers
+    sinLat.resize(opt.height);
+    cosLat.resize(opt.height);
+    for (int y = 0; y < opt.height; ++y) {
+        const double lat = 0.5 * M_PI - M_PI * (y + 0.5) / opt.height;
+        sinLat[y] = std::sin(lat);
+        cosLat[y] = std::cos(lat);
+    }
+
+    // Longitude per column: -180° → +180°
+    sinLon.resize(opt.width);
+    cosLon.resize(opt.width);
+    for (int x = 0; x < opt.width; ++x) {
+        const double lon = -M_PI + 2.0 * M_PI * (x + 0.5) / opt.width;
+        sinLon[x] = std::sin(lon);
+        cosLon[x] = std::cos(lon);
+    }
+
+    // Limb-darkened annuli: equal radial width, intensity at mid-radius.
+    // Weights are normalized so Σ weight_k * area_k = 1 for the full disk
+    // (areas in units of the disk radius squared).
+    const int K = opt.limbRings;
+    ringOuter.resize(K);
+    ringWeight.resize(K);
+
+    double flux = 0.0;
+    for (int k = 0; k < K; ++k) {
+        const double rIn  = static_cast<double>(k) / K;
+        const double rOut = static_cast<double>(k + 1) / K;
+        const double rMid = 0.5 * (rIn + rOut);
+        const double mu   = std::sqrt(std::max(0.0, 1.0 - rMid * rMid));
+        const double I    = 1.0 - opt.limbDarkening * (1.0 - mu);
+
+        ringOuter[k]  = rOut;
+        ringWeight[k] = I;
+        flux += I * M_PI * (rOut * rOut - rIn * rIn);
+    }
+    for (double& w : ringWeight) {
+        w /= flux;
+    }
+}
+
+/****************
+ * obscuredFraction
+ * @brief: Fraction of the limb-darkened solar flux hidden by the Moon.
+ * @param: sunRadius  - apparent solar radius (rad)
+ * @param: moonRadius - apparent lunar radius (rad)
+ * @param: separation - angle between disk centers (rad)
+ * @return: value in [0,1]
+ *****************/
+double ShadowMapRenderer::obscuredFraction(double sunRadius,
+                                           double moonRadius,
+                                           double separation) const {
+    const double invArea = 1.0 / (sunRadius * sunRadius);
+
+    double blocked   = 0.0;
+    double prevOverlap = 0.0;
+    for (std::size_t k = 0; k < ringOuter.size(); ++k) {
+        const double overlap = circleOverlap(ringOuter[k] * sunRadius, moonRadius, separation);
+        blocked    += ringWeight[k] * (overlap - prevOverlap) * invArea;
+        prevOverlap = overlap;
+    }
+    return std::clamp(blocked, 0.0, 1.0);
+}
+
+/****************
+ * renderRows
+ * @brief: Renders scanlines [y0, y1) of one frame.
+ * @param: shadowPossible - false when Earth is outside the penumbra cone;
+ *                          then only the day/night term is evaluated
+ *****************/
+void ShadowMapRenderer::renderRows(int y0, int y1,
+                                   const vec3& S, const vec3& E, const vec3& M,
+                                   bool shadowPossible, ShadowMap& out) const {
+    const double R_EARTH = physics::constants::R_EARTH;
+    const double R_SUN   = physics::constants::R_SUN;
+    const double R_MOON  = physics::constants::R_MOON;
+
+    for (int y = y0; y < y1; ++y) {
+        float* obsRow = out.obscuration.data() + static_cast<std::size_t>(y) * opt.width;
+        float* irrRow = out.irradiance.data()  + static_cast<std::size_t>(y) * opt.width;
+
+        for (int x = 0; x < opt.width; ++x) {
+            // Surface normal and point
+            const vec3  n(cosLat[y] * cosLon[x], cosLat[y] * sinLon[x], sinLat[y]);
+            const point3 P = E + R_EARTH * n;
+
+            // Ray toward the Sun's center
+            const vec3   toSun = S - P;
+            const double ds    = toSun.length();
+            const ray    r(P, toSun / ds);
+
+            const double cosZenith = dot(n, r.direction());
+            if (cosZenith <= 0.0) {
+                obsRow[x] = 0.0f;   // night side
+                irrRow[x] = 0.0f;
+                continue;
+            }
+
+            double blocked = 0.0;
+            if (shadowPossible) {
+                // Closest approach of the ray to the Moon's center
+                const vec3   toMoon = M - r.origin();
+                const double tM     = dot(toMoon, r.direction());
+
+                if (tM > 0.0) {
+                    const double dm2   = toMoon.length_squared();
+                    const double perp2 = std::max(0.0, dm2 - tM * tM);
+
+                    // Penumbra cone radius at the Moon (small-angle, padded)
+                    const double cone = R_MOON + tM * (R_SUN / ds);
+                    if (perp2 < cone * cone * 1.0001) {
+                        const double dm         = std::sqrt(dm2);
+                        const double separation = std::atan2(std::sqrt(perp2), tM);
+                        const double sunRadius  = std::asin(std::min(1.0, R_SUN  / ds));
+                        const double moonRadius = std::asin(std::min(1.0, R_MOON / dm));
+
+                        if (separation < sunRadius + moonRadius) {
+                            blocked = obscuredFraction(sunRadius, moonRadius, separation);
+                        }
+                    }
+                }
+            }
+
+            obsRow[x] = static_cast<float>(blocked);
+            irrRow[x] = static_cast<float>(cosZenith * (1.0 - blocked));
+        }
+    }
+}
+
+/****************
+ * render
+ * @brief: Renders one instant on the thread pool, one band of tileRows
+ *         scanlines per work item.
+ *****************/
+void ShadowMapRenderer::render(const vec3& S, const vec3& E, const vec3& M, ShadowMap& out) {
+    const std::size_t pixels = static_cast<std::size_t>(opt.width) * opt.height;
+    out.width  = opt.width;
+    out.height = opt.height;
+    out.obscuration.resize(pixels);
+    out.irradiance.resize(pixels);
+
+    // ---- Frame-level rejection: does Earth touch the penumbra cone? ----
+    // Penumbra cone: apex between Sun and Moon, half-angle (R_SUN + R_MOON)/d_sm.
+    const double R_EARTH = physics::constants::R_EARTH;
+    const double R_SUN   = physics::constants::R_SUN;
+    const double R_MOON  = physics::constants::R_MOON;
+
+    const vec3   SM    = M - S;
+    const double d_sm  = SM.length();
+    bool shadowPossible = false;
+    if (d_sm > 0.0) {
+        const vec3   axis  = SM / d_sm;
+        const double along = dot(E - M, axis);          // behind the Moon?
+        if (along > -R_EARTH) {
+            const vec3   off     = (E - M) - along * axis;
+            const double penumbra = R_MOON + std::max(0.0, along) * (R_SUN + R_MOON) / d_sm;
+            shadowPossible = off.length() < penumbra + R_EARTH;
+        }
+    }
+
+    const int bands = (opt.height + opt.tileRows - 1) / opt.tileRows;
+    pool.parallelFor(static_cast<std::size_t>(bands), [&](std::size_t b) {
+        const int y0 = static_cast<int>(b) * opt.tileRows;
+        const int y1 = std::min(opt.height, y0 + opt.tileRows);
+        renderRows(y0, y1, S, E, M, shadowPossible, out);
+    });
+}
+
+// ============================================================
+//  Image writers
+// ============================================================
+
+/****************
+ * writeShadowPPM
+ * @brief: Binary PPM (P6): night = deep navy, day = warm white scaled by
+ *         irradiance (gamma 2.2), so the shadow shows as a dark spot.
+ *****************/
+bool writeShadowPPM(const std::string& path, const ShadowMap& map) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+
+    out << "P6\n" << map.width << " " << map.height << "\n255\n";
+
+    std::vector<unsigned char> row(static_cast<std::size_t>(map.width) * 3);
+    for (int y = 0; y < map.height; ++y) {
+        for (int x = 0; x < map.width; ++x) {
+            const std::size_t i = static_cast<std::size_t>(y) * map.width + x;
+            const double l = std::pow(std::clamp<double>(map.irradiance[i], 0.0, 1.0), 1.0 / 2.2);
+
+            row[3*x + 0] = static_cast<unsigned char>(10.0 + 235.0 * l);
+            row[3*x + 1] = static_cast<unsigned char>(12.0 + 218.0 * l);
+            row[3*x + 2] = static_cast<unsigned char>(30.0 + 160.0 * l);
+        }
+        out.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
+    }
+    return static_cast<bool>(out);
+}
+
+/****************
+ * writeShadowPGM
+ * @brief: Binary PGM (P5) of obscuration.
+ *****************/
+bool writeShadowPGM(const std::string& path, const ShadowMap& map) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+
+    out << "P5\n" << map.width << " " << map.height << "\n255\n";
+
+    std::vector<unsigned char> row(static_cast<std::size_t>(map.width));
+    for (int y = 0; y < map.height; ++y) {
+        for (int x = 0; x < map.width; ++x) {
+            const std::size_t i = static_cast<std::size_t>(y) * map.width + x;
+            row[x] = static_cast<unsigned char>(std::lround(255.0 * std::clamp<double>(map.obscuration[i], 0.0, 1.0)));
+        }
+        out.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
+    }
+    return static_cast<bool>(out);
+}
+
+/****************
+ * writeShadowPFM
+ * @brief: Grayscale Portable Float Map ("Pf") in host byte order, rows
+ *         stored bottom-to-top as the format requires.
+ *****************/
+bool writeShadowPFM(const std::string& path, const ShadowMap& map) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+
+    // Scale sign gives the byte order of the samples: negative =
+    // little-endian, positive = big-endian
+    const std::uint16_t probe = 1;
+    unsigned char lowByte = 0;
+    std::memcpy(&lowByte, &probe, 1);
+    out << "Pf\n" << map.width << " " << map.height << "\n"
+        << (lowByte == 1 ? "-1.0" : "1.0") << "\n";
+
+    for (int y = map.height - 1; y >= 0; --y) {
+        const float* row = map.obscuration.data() + static_cast<std::size_t>(y) * map.width;
+        out.write(reinterpret_cast<const char*>(row),
+                  static_cast<std::streamsize>(sizeof(float) * map.width));
+    }
+    return static_cast<bool>(out);
+}
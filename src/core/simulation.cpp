@@ -8,16 +8,35 @@
 #include "simulation.h"
 #include "vec3.h"
 #include "eclipse.h"
+#include "profiler.h"
+#include "trajectory_binary.h"
+#include "kernels.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
 
 /****************
- * struct StateDerivative
- * Purpose: Captures instantaneous derivatives for position and velocity components.
+ * struct RK4Workspace
+ * Purpose: Per-thread flat buffers for rk4Step / updateAccelerations, reused
+ *          across steps so the integrator does not allocate. State blocks
+ *          follow kernels.h: [x | y | z | vx | vy | vz], each N long.
  *****************/
-struct StateDerivative {
-    vec3 dpos;  ///< Time derivative of position (velocity)
-    vec3 dvel;  ///< Time derivative of velocity (acceleration)
+struct RK4Workspace {
+    std::vector<double> mass;
+    std::vector<double> y, stage;      ///< base state, current stage state
+    std::vector<double> k1, k2, k3, k4;
+
+    void resize(std::size_t n) {
+        for (auto* v : {&stage, &k1, &k2, &k3, &k4}) v->resize(6 * n);
+    }
 };
 
+static RK4Workspace& workspace() {
+    thread_local RK4Workspace ws;
+    return ws;
+}
+
 /***********************
  * computeGravitationalForce
  * @brief: Computes mutual gravitational acceleration between two celestial bodies.
@@ -78,60 +97,107 @@ void resetAccelerations(std::vector<CelestialBody>& bodies) {
     }
 }
 
+/***********************
+ * scatterAccelerations
+ * @brief: Copies an [ax | ay | az] block back into the bodies.
+ ***********************/
+static void scatterAccelerations(const double* acc, std::vector<CelestialBody>& bodies) {
+    const std::size_t N = bodies.size();
+    for (std::size_t i = 0; i < N; ++i) {
+        bodies[i].acceleration = vec3(acc[i], acc[N + i], acc[2 * N + i]);
+    }
+}
+
 /***********************
  * updateAccelerations
  * @brief: Recomputes gravitational accelerations for the entire system.
- * @note: Uses computeGravitationalForce pairwise with i < j
- *        to ensure Newton's 3rd law and avoid double-counting.
+ * @note: Pairwise with i < j (Newton's 3rd law, no double-counting) in
+ *        the active kernel backend; see kernels.h.
  ***********************/
 void updateAccelerations(std::vector<CelestialBody>& bodies) {
-    resetAccelerations(bodies);
-
-    const std::size_t N = bodies.size();
-    for (std::size_t i = 0; i < N; ++i) {
-        for (std::size_t j = i + 1; j < N; ++j) {
-            computeGravitationalForce(bodies[i], bodies[j]);
-        }
+    ORBIT_PROFILE_SCOPE("forces");
+    RK4Workspace& ws = workspace();
+    kernels::packState(bodies, ws.y, ws.mass);
+    ws.resize(bodies.size());
+
+    const kernels::Backend& K = kernels::active();
+    if (!K.fixedAccelerations(ws.y.data(), ws.mass.data(), bodies.size(), ws.k1.data())) {
+        K.accelerations(ws.y.data(), ws.mass.data(), bodies.size(), ws.k1.data());
     }
+    scatterAccelerations(ws.k1.data(), bodies);
 }
 
 /***********************
  * evaluateDerivatives
- * @brief: Produces derivatives for RK4 from the current state.
- * @param: bodies - current state
- * @return: vector of StateDerivative (dpos, dvel) for each body
+ * @brief: RK4 derivative of a flat state: k = [v | a(x)].
+ * @param: K     - kernel backend
+ * @param: state - 6N state block
+ * @param: mass  - N masses
+ * @param: N     - number of bodies
+ * @param: k     - 6N output block
+ ***********************/
+static void evaluateDerivatives(const kernels::Backend& K,
+                                const double* state,
+                                const double* mass,
+                                std::size_t N,
+                                double* k) {
+    ORBIT_PROFILE_SCOPE("derivatives");
+    std::copy(state + 3 * N, state + 6 * N, k);
+
+    ORBIT_PROFILE_SCOPE("forces");
+    K.accelerations(state, mass, N, k + 3 * N);
+}
+
+/***********************
+ * buildIntermediateState
+ * @brief: RK4 stage state: out = y + scale * k.
+ * @param: scale - scaling factor (e.g. dt/2, dt)
  ***********************/
-std::vector<StateDerivative> evaluateDerivatives(std::vector<CelestialBody>& bodies) {
-    updateAccelerations(bodies);
-    std::vector<StateDerivative> d(bodies.size());
+static void buildIntermediateState(const kernels::Backend& K,
+                                   const double* y,
+                                   const double* k,
+                                   double scale,
+                                   std::size_t N,
+                                   double* out) {
+    ORBIT_PROFILE_SCOPE("stage state");
+    K.axpy(out, y, k, scale, 6 * N);
+}
 
-    for (std::size_t i = 0; i < bodies.size(); ++i) {
-        d[i].dpos = bodies[i].velocity;
-        d[i].dvel = bodies[i].acceleration;
+/***********************
+ * unpackState
+ * @brief: Copies a 6N state block back into positions and velocities.
+ ***********************/
+static void unpackState(const double* y, std::vector<CelestialBody>& bodies) {
+    const std::size_t N = bodies.size();
+    for (std::size_t i = 0; i < N; ++i) {
+        bodies[i].position = vec3(y[i], y[N + i], y[2 * N + i]);
+        bodies[i].velocity = vec3(y[3 * N + i], y[4 * N + i], y[5 * N + i]);
     }
-    return d;
 }
 
 /***********************
- * buildIntermediateState
- * @brief: Generates an intermediate RK4 state from base state and derivatives.
- * @param: bodies - base state
- * @param: d      - derivatives at this stage
- * @param: scale  - scaling factor (e.g. dt/2, dt)
- * @return: new vector<CelestialBody> representing intermediate state
+ * rk4StepFlat
+ * @brief: N-generic RK4 on the packed workspace (ws.y advanced in place,
+ *          ws.k1 holds the first-stage derivative).
  ***********************/
-std::vector<CelestialBody> buildIntermediateState(
-    const std::vector<CelestialBody>& bodies,
-    const std::vector<StateDerivative>& d,
-    double scale) {
+static void rk4StepFlat(const kernels::Backend& K, RK4Workspace& ws, std::size_t N, double dt) {
+    const double* y = ws.y.data();
+    const double* m = ws.mass.data();
+    double*       s = ws.stage.data();
 
-    std::vector<CelestialBody> next = bodies;
+    evaluateDerivatives(K, y, m, N, ws.k1.data());
+    buildIntermediateState(K, y, ws.k1.data(), dt * 0.5, N, s);
+    evaluateDerivatives(K, s, m, N, ws.k2.data());
 
-    for (std::size_t i = 0; i < bodies.size(); ++i) {
-        next[i].position += scale * d[i].dpos;
-        next[i].velocity += scale * d[i].dvel;
-    }
-    return next;
+    buildIntermediateState(K, y, ws.k2.data(), dt * 0.5, N, s);
+    evaluateDerivatives(K, s, m, N, ws.k3.data());
+
+    buildIntermediateState(K, y, ws.k3.data(), dt, N, s);
+    evaluateDerivatives(K, s, m, N, ws.k4.data());
+
+    ORBIT_PROFILE_SCOPE("combine");
+    K.rk4Combine(ws.y.data(), ws.k1.data(), ws.k2.data(), ws.k3.data(), ws.k4.data(),
+                 dt / 6.0, 6 * N);
 }
 
 /***********************
@@ -141,25 +207,48 @@ std::vector<CelestialBody> buildIntermediateState(
  * @param: dt     - time step
  * @exception: none
  * @return: none
+ * @note: Works on flat state blocks in the active kernel backend, using
+ *        the stepper specialized on N when 2 <= N <= 16 (same phase
+ *        zones). On return, accelerations hold a(t) from the first stage.
  ***********************/
 void rk4Step(std::vector<CelestialBody>& bodies, double dt) {
     if (bodies.empty()) return;
+    ORBIT_PROFILE_SCOPE("rk4Step");
 
-    auto k1 = evaluateDerivatives(bodies);
-    auto s2 = buildIntermediateState(bodies, k1, dt * 0.5);
-    auto k2 = evaluateDerivatives(s2);
+    const kernels::Backend& K = kernels::active();
+    const std::size_t N = bodies.size();
+    RK4Workspace& ws = workspace();
+    kernels::packState(bodies, ws.y, ws.mass);
+    ws.resize(N);
+
+    if (N >= kernels::FIXED_MIN_N && N <= kernels::FIXED_MAX_N) {
+        K.fixedRk4(ws.y.data(), ws.mass.data(), N, dt, ws.k1.data() + 3 * N);
+    } else {
+        rk4StepFlat(K, ws, N, dt);
+    }
+
+    unpackState(ws.y.data(), bodies);
+    scatterAccelerations(ws.k1.data() + 3 * N, bodies);
+}
+
+/***********************
+ * rk4StepGeneric
+ * @brief: rk4Step without the fixed-N specializations (benchmarks and
+ *         cross-checks).
+ ***********************/
+void rk4StepGeneric(std::vector<CelestialBody>& bodies, double dt) {
+    if (bodies.empty()) return;
 
-    auto s3 = buildIntermediateState(bodies, k2, dt * 0.5);
-    auto k3 = evaluateDerivatives(s3);
+    const kernels::Backend& K = kernels::active();
+    const std::size_t N = bodies.size();
+    RK4Workspace& ws = workspace();
+    kernels::packState(bodies, ws.y, ws.mass);
+    ws.resize(N);
 
-    auto s4 = buildIntermediateState(bodies, k3, dt);
-    auto k4 = evaluateDerivatives(s4);
+    rk4StepFlat(K, ws, N, dt);
 
-    const double sixth = dt / 6.0;
-    for (std::size_t i = 0; i < bodies.size(); ++i) {
-        bodies[i].position += sixth * (k1[i].dpos + 2.0*k2[i].dpos + 2.0*k3[i].dpos + k4[i].dpos);
-        bodies[i].velocity += sixth * (k1[i].dvel + 2.0*k2[i].dvel + 2.0*k3[i].dvel + k4[i].dvel);
-    }
+    unpackState(ws.y.data(), bodies);
+    scatterAccelerations(ws.k1.data() + 3 * N, bodies);
 }
 
 /********************
@@ -193,17 +282,20 @@ bool detectSEM(const std::vector<CelestialBody>& bodies,
  * @param steps      - number of steps to simulate
  * @param dt         - timestep in seconds
  * @param outputPath - CSV output file path
+ * @param options    - optional behaviour (barycenter re-centering, ...)
  * @return none
  *********************/
 void runSimulation(std::vector<CelestialBody>& bodies,
                    int steps,
                    double dt,
-                   const std::string& outputPath)
+                   const std::string& outputPath,
+                   const SimulationOptions& options)
 {
     if (bodies.empty()) {
         std::cerr << "❌ No bodies to simulate.\n";
         return;
     }
+    ORBIT_PROFILE_SCOPE("runSimulation");
 
     // ============================
     // Initial conservation checks
@@ -223,6 +315,12 @@ void runSimulation(std::vector<CelestialBody>& bodies,
         C0.P[2]*C0.P[2]
     );
 
+    // ---------------------------------------------
+    // Barycenter drift tracking (O(N) per step)
+    // ---------------------------------------------
+    physics::BarycenterTracker barycenter;
+    barycenter.reset(bodies);
+
     // ---------------------------------------------
     // Optional eclipse logging for Sun–Earth–Moon
     // ---------------------------------------------
@@ -256,6 +354,43 @@ void runSimulation(std::vector<CelestialBody>& bodies,
         return;
     }
 
+    // ============================
+    // Optional binary trajectory (t = 0 frame included)
+    // ============================
+    TrajectoryBinaryWriter trajectory;
+    bool writeTrajectory = !options.trajectoryPath.empty();
+    if (writeTrajectory) {
+        if (!trajectory.open(options.trajectoryPath, bodies, dt, options.epoch)) {
+            std::cerr << "⚠️ Could not open trajectory file: " << options.trajectoryPath << "\n";
+            writeTrajectory = false;
+        } else {
+            trajectory.write(0.0, bodies);
+        }
+    }
+
+    // ============================
+    // Optional Chebyshev ephemeris (fitted window by window)
+    // ============================
+    ChebyshevEphemerisWriter ephemeris;
+    bool writeEphemeris = !options.ephemerisPath.empty();
+    std::string ephemerisError;
+    if (writeEphemeris) {
+        std::vector<std::string> names;
+        for (const auto& b : bodies) names.push_back(b.name);
+
+        if (!ephemeris.open(options.ephemerisPath, names, dt, options.epoch, options.ephemerisFit)) {
+            std::cerr << "⚠️ Could not open ephemeris file (or invalid window/degree): "
+                      << options.ephemerisPath << "\n";
+            writeEphemeris = false;
+        } else {
+            ephemeris.add(0.0, bodies);
+        }
+    }
+
+    // Round-trip precision: at the default 6 digits positions near 1 AU
+    // are rounded to ~1000 km, too coarse for eclipse work on the CSV
+    file << std::setprecision(17);
+
     /**********************************************
      * CSV HEADER (Generic for any N bodies)
      **********************************************/
@@ -271,6 +406,15 @@ void runSimulation(std::vector<CelestialBody>& bodies,
          << "Px,Py,Pz,Pmag,"
          << "dE_rel,dL_rel,dP_rel\n";
 
+    // ============================
+    // Progress / ETA reporting
+    // ============================
+    ProgressReporter progress;
+    if (!progress.begin(options.progress, steps, dt)) {
+        std::cerr << "⚠️ Could not open status file: " << options.progress.statusPath << "\n";
+    }
+    double lastDE = 0.0;
+
     // ============================
     // Main Integration Loop
     // ============================
@@ -279,25 +423,40 @@ void runSimulation(std::vector<CelestialBody>& bodies,
         // --- RK4 integration step ---
         rk4Step(bodies, dt);
 
-        // --- Compute updated conservation values ---
-        physics::Conservations C = physics::compute(bodies);
-
-        double Lmag = std::sqrt(C.L[0]*C.L[0] +
-                                C.L[1]*C.L[1] +
-                                C.L[2]*C.L[2]);
-
-        double Pmag = std::sqrt(C.P[0]*C.P[0] +
-                                C.P[1]*C.P[1] +
-                                C.P[2]*C.P[2]);
+        // --- Barycenter tracking / periodic drift removal ---
+        {
+            ORBIT_PROFILE_SCOPE("barycenter");
+            barycenter.update(bodies, dt);
+            if (options.recenterEvery > 0 && (i + 1) % options.recenterEvery == 0) {
+                barycenter.recenter(bodies);
+            }
+        }
 
-        double dE = (C.total_energy - E0) / std::abs(E0);
-        double dL = (Lmag - L0) / L0;
-        double dP = (Pmag - P0mag) / (P0mag == 0 ? 1.0 : P0mag);
+        // --- Compute updated conservation values ---
+        physics::Conservations C;
+        double Lmag, Pmag, dE, dL, dP;
+        {
+            ORBIT_PROFILE_SCOPE("conservation");
+            C = physics::compute(bodies);
+
+            Lmag = std::sqrt(C.L[0]*C.L[0] +
+                             C.L[1]*C.L[1] +
+                             C.L[2]*C.L[2]);
+
+            Pmag = std::sqrt(C.P[0]*C.P[0] +
+                             C.P[1]*C.P[1] +
+                             C.P[2]*C.P[2]);
+
+            dE = (C.total_energy - E0) / std::abs(E0);
+            dL = (Lmag - L0) / L0;
+            dP = (Pmag - P0mag) / (P0mag == 0 ? 1.0 : P0mag);
+        }
 
         // ---------------------------------------------
         // Eclipse logging (Sun–Earth–Moon only)
         // ---------------------------------------------
         if (isSEM) {
+            ORBIT_PROFILE_SCOPE("eclipse log");
             const vec3& S = bodies[idxSun].position;
             const vec3& E = bodies[idxEarth].position;
             const vec3& M = bodies[idxMoon].position;
@@ -316,28 +475,77 @@ void runSimulation(std::vector<CelestialBody>& bodies,
         // ============================
         // CSV ROW (main orbit data)
         // ============================
-        file << i << ",";
+        {
+            ORBIT_PROFILE_SCOPE("csv row");
+            file << i << ",";
+
+            for (const auto& b : bodies) {
+                file << b.position.x() << ","
+                     << b.position.y() << ","
+                     << b.position.z() << ",";
+            }
+
+            file << C.total_energy << ","
+                 << C.kinetic_energy << ","
+                 << C.potential_energy << ","
+                 << C.L[0] << "," << C.L[1] << "," << C.L[2] << ","
+                 << Lmag << ","
+                 << C.P[0] << "," << C.P[1] << "," << C.P[2] << ","
+                 << Pmag << ","
+                 << dE << "," << dL << "," << dP << "\n";
+        }
 
-        for (const auto& b : bodies) {
-            file << b.position.x() << ","
-                 << b.position.y() << ","
-                 << b.position.z() << ",";
+        if (writeTrajectory) {
+            ORBIT_PROFILE_SCOPE("trajectory write");
+            trajectory.write((i + 1) * dt, bodies);
+        }
+        if (writeEphemeris) {
+            ORBIT_PROFILE_SCOPE("ephemeris fit");
+            ephemeris.add((i + 1) * dt, bodies);
         }
 
-        file << C.total_energy << ","
-             << C.kinetic_energy << ","
-             << C.potential_energy << ","
-             << C.L[0] << "," << C.L[1] << "," << C.L[2] << ","
-             << Lmag << ","
-             << C.P[0] << "," << C.P[1] << "," << C.P[2] << ","
-             << Pmag << ","
-             << dE << "," << dL << "," << dP << "\n";
+        lastDE = dE;
+        if (progress.due(i + 1)) {
+            progress.update(i + 1, dE);
+        }
     }
+    progress.finish(steps, lastDE);
 
-    file.close();
-    if (isSEM) {
-        eclipseFile.close();
+    {
+        ORBIT_PROFILE_SCOPE("finalize");
+        file.close();
+        if (writeTrajectory) {
+            trajectory.close();
+        }
+        if (writeEphemeris && !ephemeris.finish()) {
+            ephemerisError = ephemeris.error();
+            writeEphemeris = false;
+        }
+        if (isSEM) {
+            eclipseFile.close();
+        }
+    }
+
+    // A bad fit must not pass as a finished run (serve would use it)
+    if (!ephemerisError.empty()) {
+        throw std::runtime_error("Ephemeris " + options.ephemerisPath + ": " + ephemerisError);
     }
 
     std::cout << "✅ Simulation complete: " << outputPath << "\n";
+    if (writeTrajectory) {
+        std::cout << " - Trajectory: " << options.trajectoryPath
+                  << " (" << (steps + 1) << " frames)\n";
+    }
+    if (writeEphemeris) {
+        std::cout << " - Ephemeris:  " << options.ephemerisPath
+                  << " (" << ephemeris.windows() << " Chebyshev windows, degree "
+                  << options.ephemerisFit.degree << ", max fit error "
+                  << ephemeris.maxError() << " m)\n";
+    }
+    std::cout << " - Barycenter drift: max |dR| = " << barycenter.maxPositionDrift() << " m"
+              << ", final |dV| = " << barycenter.velocityDrift().length() << " m/s";
+    if (options.recenterEvery > 0) {
+        std::cout << " (" << barycenter.corrections() << " re-centerings)";
+    }
+    std::cout << "\n";
 }
\ No newline at end of file
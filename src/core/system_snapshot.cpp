@@ -0,0 +1,282 @@
+/****************
+ * Author: Sinan Demir
+ * File: system_snapshot.cpp
+ * Date: 10/16/2026
+ * Purpose: Implementation of the binary system snapshot writer/reader.
+ *****************/
+
+#include "system_snapshot.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ORBIT_SNAPSHOT_MMAP 1
+#endif
+
+namespace {
+
+constexpr char          MAGIC[8]  = {'O', 'R', 'B', 'S', 'N', 'A', 'P', '\0'};
+constexpr std::uint32_t ORDER_TAG = 0x01020304u;
+
+/***********************
+ * struct SnapshotHeader
+ * @brief: Fixed 72-byte file header (see system_snapshot.h for layout).
+ ***********************/
+struct SnapshotHeader {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint64_t count;
+    std::uint64_t massOffset;
+    std::uint64_t stateOffset;
+    std::uint64_t nameIndexOffset;
+    std::uint64_t nameBlobOffset;
+    std::uint64_t metaOffset;
+    std::uint64_t fileSize;
+};
+static_assert(sizeof(SnapshotHeader) == 72, "snapshot header must be packed");
+
+inline std::uint64_t align8(std::uint64_t n) { return (n + 7u) & ~std::uint64_t(7u); }
+
+// Writes raw bytes then zero-pads to the next 8-byte boundary
+void writePadded(std::ofstream& out, const void* data, std::uint64_t bytes) {
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    static const char zeros[8] = {};
+    out.write(zeros, static_cast<std::streamsize>(align8(bytes) - bytes));
+}
+
+[[noreturn]] void corrupt(const std::string& path, const char* what) {
+    throw std::runtime_error("Invalid system snapshot " + path + ": " + what);
+}
+
+} // namespace
+
+/***********************
+ * writeSystemSnapshot
+ * @brief: Lays out the header followed by aligned sections.
+ ***********************/
+bool writeSystemSnapshot(const std::string& path,
+                         const std::vector<CelestialBody>& bodies,
+                         const SystemMetadata& meta)
+{
+    const std::uint64_t n = bodies.size();
+
+    // ---- build sections in memory ----
+    std::vector<double> masses(n), states(6 * n);
+    std::vector<std::uint64_t> nameIndex(n + 1, 0);
+    std::string names;
+    for (std::uint64_t i = 0; i < n; ++i) {
+        const CelestialBody& b = bodies[i];
+        masses[i] = b.mass;
+
+        double* s = &states[6 * i];
+        s[0] = b.position.x();  s[1] = b.position.y();  s[2] = b.position.z();
+        s[3] = b.velocity.x();  s[4] = b.velocity.y();  s[5] = b.velocity.z();
+
+        names += b.name;
+        nameIndex[i + 1] = names.size();
+    }
+
+    std::string metaBlob;
+    for (const std::string* field : {&meta.name, &meta.epoch}) {
+        const std::uint64_t len = field->size();
+        metaBlob.append(reinterpret_cast<const char*>(&len), sizeof(len));
+        metaBlob += *field;
+    }
+
+    // ---- header ----
+    SnapshotHeader h{};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version         = SNAPSHOT_VERSION;
+    h.byteOrder       = ORDER_TAG;
+    h.count           = n;
+    h.massOffset      = align8(sizeof(SnapshotHeader));
+    h.stateOffset     = h.massOffset      + align8(masses.size()    * sizeof(double));
+    h.nameIndexOffset = h.stateOffset     + align8(states.size()    * sizeof(double));
+    h.nameBlobOffset  = h.nameIndexOffset + align8(nameIndex.size() * sizeof(std::uint64_t));
+    h.metaOffset      = h.nameBlobOffset  + align8(names.size());
+    h.fileSize        = h.metaOffset      + align8(metaBlob.size());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    writePadded(out, &h, sizeof(h));
+    writePadded(out, masses.data(),    masses.size()    * sizeof(double));
+    writePadded(out, states.data(),    states.size()    * sizeof(double));
+    writePadded(out, nameIndex.data(), nameIndex.size() * sizeof(std::uint64_t));
+    writePadded(out, names.data(),     names.size());
+    writePadded(out, metaBlob.data(),  metaBlob.size());
+
+    return static_cast<bool>(out);
+}
+
+/***********************
+ * SystemSnapshot (constructor)
+ * @brief: Maps the file and validates every section against its size.
+ ***********************/
+SystemSnapshot::SystemSnapshot(const std::string& path)
+{
+    const unsigned char* base = nullptr;
+
+#ifdef ORBIT_SNAPSHOT_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open system snapshot: " + path);
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(SnapshotHeader))) {
+        ::close(fd);
+        corrupt(path, "file too small");
+    }
+    mapSize = static_cast<std::size_t>(st.st_size);
+    void* m = ::mmap(nullptr, mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (m == MAP_FAILED) {
+        throw std::runtime_error("Could not map system snapshot: " + path);
+    }
+    mapping = m;
+    base    = static_cast<const unsigned char*>(m);
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Could not open system snapshot: " + path);
+    }
+    fallback.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    mapSize = fallback.size();
+    if (mapSize < sizeof(SnapshotHeader)) corrupt(path, "file too small");
+    base = fallback.data();
+#endif
+
+    try {
+        SnapshotHeader h;
+        std::memcpy(&h, base, sizeof(h));
+
+        if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) corrupt(path, "bad magic");
+        if (h.byteOrder != ORDER_TAG)                      corrupt(path, "foreign byte order");
+        if (h.version != SNAPSHOT_VERSION) {
+            throw std::runtime_error("Unsupported system snapshot version "
+                                     + std::to_string(h.version) + " in " + path
+                                     + " (expected " + std::to_string(SNAPSHOT_VERSION) + ")");
+        }
+        if (h.fileSize != mapSize) corrupt(path, "truncated or padded file");
+
+        // Sections must be ordered, aligned and large enough for N bodies
+        const std::uint64_t n = h.count;
+        if (n > mapSize / (7 * sizeof(double))) corrupt(path, "body count exceeds file size");
+
+        // Offsets are untrusted: compare each against mapSize before
+        // adding to it (n is bounded above, so the sizes cannot wrap)
+        auto fits = [&](std::uint64_t offset, std::uint64_t bytes) {
+            return offset <= mapSize && bytes <= mapSize - offset;
+        };
+        const std::uint64_t massBytes  = n * sizeof(double);
+        const std::uint64_t stateBytes = 6 * n * sizeof(double);
+        const std::uint64_t indexBytes = (n + 1) * sizeof(std::uint64_t);
+
+        const bool layoutOk =
+            h.massOffset      >= sizeof(SnapshotHeader) &&
+            fits(h.massOffset, massBytes) &&
+            fits(h.stateOffset, stateBytes) &&
+            fits(h.nameIndexOffset, indexBytes) &&
+            fits(h.nameBlobOffset, 0) &&
+            fits(h.metaOffset, 0) &&
+            h.stateOffset     >= h.massOffset      + massBytes &&
+            h.nameIndexOffset >= h.stateOffset     + stateBytes &&
+            h.nameBlobOffset  >= h.nameIndexOffset + indexBytes &&
+            h.metaOffset      >= h.nameBlobOffset  &&
+            (h.massOffset | h.stateOffset | h.nameIndexOffset) % 8 == 0;
+        if (!layoutOk) corrupt(path, "bad section layout");
+
+        formatVersion = h.version;
+        count     = static_cast<std::size_t>(n);
+        massData  = reinterpret_cast<const double*>(base + h.massOffset);
+        stateData = reinterpret_cast<const double*>(base + h.stateOffset);
+        nameIndex = reinterpret_cast<const std::uint64_t*>(base + h.nameIndexOffset);
+        nameBlob  = reinterpret_cast<const char*>(base + h.nameBlobOffset);
+
+        const std::uint64_t blobSize = h.metaOffset - h.nameBlobOffset;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (nameIndex[i] > nameIndex[i + 1] || nameIndex[i + 1] > blobSize) {
+                corrupt(path, "bad name table");
+            }
+        }
+
+        // Metadata: two length-prefixed strings
+        std::uint64_t pos = h.metaOffset;
+        std::string_view* fields[2] = {&metaName, &metaEpoch};
+        for (std::string_view* f : fields) {
+            std::uint64_t len = 0;
+            if (pos + sizeof(len) > mapSize) corrupt(path, "bad metadata");
+            std::memcpy(&len, base + pos, sizeof(len));
+            pos += sizeof(len);
+            if (len > mapSize - pos) corrupt(path, "bad metadata");
+            *f = std::string_view(reinterpret_cast<const char*>(base + pos), static_cast<std::size_t>(len));
+            pos += len;
+        }
+    }
+    catch (...) {
+#ifdef ORBIT_SNAPSHOT_MMAP
+        ::munmap(mapping, mapSize);
+#endif
+        mapping = nullptr;
+        throw;
+    }
+}
+
+SystemSnapshot::~SystemSnapshot() {
+#ifdef ORBIT_SNAPSHOT_MMAP
+    if (mapping) ::munmap(mapping, mapSize);
+#endif
+}
+
+std::string_view SystemSnapshot::name(std::size_t i) const {
+    return std::string_view(nameBlob + nameIndex[i],
+                            static_cast<std::size_t>(nameIndex[i + 1] - nameIndex[i]));
+}
+
+std::vector<CelestialBody> SystemSnapshot::toBodies() const {
+    std::vector<CelestialBody> bodies;
+    bodies.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const double* s = stateData + 6 * i;
+        bodies.emplace_back(std::string(name(i)), massData[i],
+                            s[0], s[1], s[2],
+                            s[3], s[4], s[5],
+                            0.0, 0.0, 0.0);
+    }
+    return bodies;
+}
+
+/***********************
+ * isSystemSnapshot
+ * @brief: Compares the first 8 bytes against the snapshot magic.
+ ***********************/
+bool isSystemSnapshot(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(MAGIC)] = {};
+    if (!in.read(magic, sizeof(magic))) return false;
+    return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+/***********************
+ * loadSystem
+ * @brief: Dispatches to SystemSnapshot or loadSystemFromJSON.
+ ***********************/
+std::vector<CelestialBody> loadSystem(const std::string& path, SystemMetadata* meta) {
+    if (!isSystemSnapshot(path)) {
+        return loadSystemFromJSON(path, meta);
+    }
+
+    SystemSnapshot snap(path);
+    if (meta) {
+        meta->name  = std::string(snap.systemName());
+        meta->epoch = std::string(snap.epoch());
+    }
+    return snap.toBodies();
+}
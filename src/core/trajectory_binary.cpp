@@ -0,0 +1,136 @@
+/****************
+ * Author: Sinan Demir
+ * File: trajectory_binary.cpp
+ * Date: 10/16/2026
+ * Purpose: Implementation of the binary trajectory writer/reader.
+ *****************/
+
+#include "trajectory_binary.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr char TRAJ_MAGIC[8] = {'O', 'R', 'B', 'T', 'R', 'A', 'J', '\0'};
+
+template <typename T>
+void writePod(std::ofstream& out, const T& v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <typename T>
+bool readPod(std::ifstream& in, T& v) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&v), sizeof(T)));
+}
+
+void writeString(std::ofstream& out, const std::string& s) {
+    writePod(out, static_cast<std::uint64_t>(s.size()));
+    out.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+bool readString(std::ifstream& in, std::string& s) {
+    std::uint64_t len = 0;
+    if (!readPod(in, len) || len > (1u << 20)) return false;   // names/epoch are short
+    s.resize(static_cast<std::size_t>(len));
+    return len == 0 || static_cast<bool>(in.read(&s[0], static_cast<std::streamsize>(len)));
+}
+
+} // namespace
+
+// ============================================================
+//  Writer
+// ============================================================
+
+bool TrajectoryBinaryWriter::open(const std::string& path,
+                                  const std::vector<CelestialBody>& bodies,
+                                  double dt,
+                                  const std::string& epoch)
+{
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    out.write(TRAJ_MAGIC, sizeof(TRAJ_MAGIC));
+    writePod(out, TRAJECTORY_VERSION);
+    writePod(out, static_cast<std::uint32_t>(bodies.size()));
+    writePod(out, dt);
+    writeString(out, epoch);
+    for (const auto& b : bodies) {
+        writeString(out, b.name);
+    }
+
+    buffer.resize(1 + 6 * bodies.size());
+    return static_cast<bool>(out);
+}
+
+/***********************
+ * write
+ * @brief: Packs one frame into the reused buffer and writes it at once.
+ ***********************/
+void TrajectoryBinaryWriter::write(double t, const std::vector<CelestialBody>& bodies) {
+    buffer.resize(1 + 6 * bodies.size());
+    double* p = buffer.data();
+    *p++ = t;
+    for (const auto& b : bodies) {
+        *p++ = b.position.x();  *p++ = b.position.y();  *p++ = b.position.z();
+        *p++ = b.velocity.x();  *p++ = b.velocity.y();  *p++ = b.velocity.z();
+    }
+    out.write(reinterpret_cast<const char*>(buffer.data()),
+              static_cast<std::streamsize>(buffer.size() * sizeof(double)));
+}
+
+// ============================================================
+//  Reader
+// ============================================================
+
+TrajectoryBinaryReader::TrajectoryBinaryReader(const std::string& path)
+    : in(path, std::ios::binary)
+{
+    if (!in) {
+        throw std::runtime_error("Could not open trajectory: " + path);
+    }
+
+    char magic[sizeof(TRAJ_MAGIC)] = {};
+    std::uint32_t version = 0, count = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, TRAJ_MAGIC, sizeof(magic)) != 0) {
+        throw std::runtime_error("Not a binary trajectory: " + path);
+    }
+    if (!readPod(in, version) || version != TRAJECTORY_VERSION) {
+        throw std::runtime_error("Unsupported trajectory version " + std::to_string(version)
+                                 + " in " + path);
+    }
+    if (!readPod(in, count) || !readPod(in, step) || !readString(in, epochText)) {
+        throw std::runtime_error("Truncated trajectory header: " + path);
+    }
+
+    names.resize(count);
+    for (auto& n : names) {
+        if (!readString(in, n)) {
+            throw std::runtime_error("Truncated trajectory header: " + path);
+        }
+    }
+    buffer.resize(1 + 6 * names.size());
+}
+
+bool TrajectoryBinaryReader::next(TrajectoryFrame& frame) {
+    const std::streamsize bytes = static_cast<std::streamsize>(buffer.size() * sizeof(double));
+    if (!in.read(reinterpret_cast<char*>(buffer.data()), bytes)) {
+        return false;
+    }
+
+    const double* p = buffer.data();
+    frame.t = *p++;
+    frame.positions.resize(names.size());
+    frame.velocities.resize(names.size());
+    for (std::size_t b = 0; b < names.size(); ++b, p += 6) {
+        frame.positions[b]  = vec3(p[0], p[1], p[2]);
+        frame.velocities[b] = vec3(p[3], p[4], p[5]);
+    }
+    return true;
+}
+
+bool isTrajectoryBinary(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(TRAJ_MAGIC)] = {};
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, TRAJ_MAGIC, sizeof(magic)) == 0;
+}
@@ -0,0 +1,366 @@
+/****************
+ * Author: Sinan Demir
+ * File: trajectory_csv.cpp
+ * Date: 10/16/2026
+ * Purpose: Implementation of the streaming trajectory CSV reader and the
+ *          parallel whole-file loader.
+ *****************/
+
+#include "trajectory_csv.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ORBIT_TRAJECTORY_MMAP 1
+#endif
+
+namespace {
+
+/***********************
+ * parseHeader
+ * @brief: Splits the header row and finds the x_<name> column of every
+ *         body (y_ and z_ follow it).
+ * @return total number of columns
+ ***********************/
+std::size_t parseHeader(const std::string& line,
+                        std::vector<std::string>& names,
+                        std::vector<int>& xCols) {
+    // Split header on commas
+    std::vector<std::string> columns;
+    std::size_t start = 0;
+    while (start <= line.size()) {
+        std::size_t comma = line.find(',', start);
+        if (comma == std::string::npos) comma = line.size();
+        columns.push_back(line.substr(start, comma - start));
+        start = comma + 1;
+    }
+
+    // x_<name>, y_<name>, z_<name> triplets
+    for (std::size_t i = 0; i + 2 < columns.size(); ++i) {
+        if (columns[i].rfind("x_", 0) == 0) {
+            names.push_back(columns[i].substr(2));
+            xCols.push_back(static_cast<int>(i));
+        }
+    }
+    return columns.size();
+}
+
+} // namespace
+
+/***********************
+ * TrajectoryCSVReader (constructor)
+ * @brief: Opens the file and parses the header row.
+ * @param path - CSV path
+ * @exception: runtime_error on open failure or missing body columns
+ ***********************/
+TrajectoryCSVReader::TrajectoryCSVReader(const std::string& path)
+    : file(path)
+{
+    if (!file) {
+        throw std::runtime_error("Could not open trajectory CSV: " + path);
+    }
+    if (!std::getline(file, line)) {
+        throw std::runtime_error("Empty trajectory CSV: " + path);
+    }
+
+    columnCount = parseHeader(line, names, xCols);
+
+    if (names.empty()) {
+        throw std::runtime_error("No x_* body columns in trajectory CSV: " + path);
+    }
+}
+
+/***********************
+ * bodyIndex
+ * @brief: Looks up a body by name.
+ * @return column-order index, or -1 if not present
+ ***********************/
+int TrajectoryCSVReader::bodyIndex(const std::string& name) const {
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+/***********************
+ * syncTo
+ * @brief: Seeks to pos - 1 and drops the rest of that line, so the next
+ *         read starts on a row boundary (exactly at pos if pos - 1 is the
+ *         previous row's newline).
+ ***********************/
+void TrajectoryCSVReader::syncTo(std::streampos pos) {
+    file.clear();
+    file.seekg(pos - std::streamoff(1));
+    std::getline(file, line);
+}
+
+/***********************
+ * next
+ * @brief: Reads and parses the next non-empty, well-formed row.
+ * @param row - destination (positions resized to bodyNames().size())
+ * @return false at end of file
+ * @note: Uses strtod directly on the line buffer; no per-field allocation.
+ ***********************/
+bool TrajectoryCSVReader::next(TrajectoryCSVRow& row) {
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+
+        values.clear();
+        const char* p   = line.c_str();
+        const char* end = p + line.size();
+
+        while (p < end) {
+            char* stop = nullptr;
+            double v = std::strtod(p, &stop);
+            if (stop == p) break;           // not a number → malformed
+            values.push_back(v);
+            p = stop;
+            if (p < end && *p == ',') ++p;
+        }
+
+        if (values.size() < columnCount) {
+            continue;   // malformed row, skip
+        }
+
+        row.step = static_cast<long>(values[0]);
+        row.positions.resize(names.size());
+        for (std::size_t b = 0; b < names.size(); ++b) {
+            const int ix = xCols[b];
+            row.positions[b] = vec3(values[ix], values[ix + 1], values[ix + 2]);
+        }
+        return true;
+    }
+    return false;
+}
+
+// ============================================================
+//  Parallel whole-file loader
+// ============================================================
+
+namespace {
+
+/***********************
+ * class MappedText
+ * @brief: Read-only view of a whole file (mmap where available).
+ ***********************/
+class MappedText {
+public:
+    explicit MappedText(const std::string& path) {
+#ifdef ORBIT_TRAJECTORY_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Could not open trajectory CSV: " + path);
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Could not stat trajectory CSV: " + path);
+        }
+        length = static_cast<std::size_t>(st.st_size);
+        if (length > 0) {
+            void* m = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Could not map trajectory CSV: " + path);
+            }
+            ::madvise(m, length, MADV_SEQUENTIAL);
+            mapping = m;
+            text    = static_cast<const char*>(m);
+        }
+        ::close(fd);
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Could not open trajectory CSV: " + path);
+        }
+        fallback.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        length = fallback.size();
+        text   = fallback.data();
+#endif
+    }
+
+    ~MappedText() {
+#ifdef ORBIT_TRAJECTORY_MMAP
+        if (mapping) ::munmap(mapping, length);
+#endif
+    }
+
+    MappedText(const MappedText&) = delete;
+    MappedText& operator=(const MappedText&) = delete;
+
+    const char* data() const { return text; }
+    std::size_t size() const { return length; }
+
+private:
+    void*             mapping = nullptr;
+    const char*       text    = nullptr;
+    std::size_t       length  = 0;
+    std::vector<char> fallback;   ///< used where mmap is unavailable
+};
+
+/// @return start of the line after the one containing p (or end).
+const char* nextLineStart(const char* p, const char* end) {
+    const void* nl = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+    return nl ? static_cast<const char*>(nl) + 1 : end;
+}
+
+/// Rows in [begin, end): newline count, plus an unterminated last row.
+std::size_t countRows(const char* begin, const char* end) {
+    std::size_t rows = 0;
+    for (const char* p = begin; p < end; ) {
+        p = nextLineStart(p, end);
+        ++rows;
+    }
+    return rows;
+}
+
+} // namespace
+
+/***********************
+ * loadTrajectoryCSV
+ * @brief: Maps the file, cuts the body into chunks at newline boundaries,
+ *         counts rows per chunk (pass 1), sizes the per-body arrays once,
+ *         then parses every chunk into its own row range (pass 2). Rows
+ *         rejected in pass 2 leave gaps that are closed at the end.
+ ***********************/
+TrajectoryCSVData loadTrajectoryCSV(const std::string& path, unsigned threads) {
+    MappedText file(path);
+    const char* const text = file.data();
+    const char* const end  = text + file.size();
+
+    const char* const body = nextLineStart(text, end);
+    if (body == text) {
+        throw std::runtime_error("Empty trajectory CSV: " + path);
+    }
+
+    // Header (without the line break)
+    std::string header(text, body);
+    while (!header.empty() && (header.back() == '\n' || header.back() == '\r')) {
+        header.pop_back();
+    }
+
+    TrajectoryCSVData data;
+    std::vector<int> xCols;
+    const std::size_t columnCount = parseHeader(header, data.names, xCols);
+    if (data.names.empty()) {
+        throw std::runtime_error("No x_* body columns in trajectory CSV: " + path);
+    }
+    const std::size_t nBodies = data.names.size();
+
+    // Column -> (body * 3 + axis), or -1 for columns we do not keep
+    std::vector<int> target(columnCount, -1);
+    for (std::size_t b = 0; b < nBodies; ++b) {
+        for (int a = 0; a < 3; ++a) {
+            target[static_cast<std::size_t>(xCols[b] + a)] = static_cast<int>(3 * b + a);
+        }
+    }
+
+    // ---- chunking (several per thread so uneven chunks balance) ----
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t bytes  = static_cast<std::size_t>(end - body);
+    const std::size_t chunks = std::max<std::size_t>(1,
+        std::min<std::size_t>(std::size_t(threads) * 4, bytes / (1u << 20) + 1));
+
+    std::vector<const char*> cut(chunks + 1);
+    cut[0]      = body;
+    cut[chunks] = end;
+    for (std::size_t k = 1; k < chunks; ++k) {
+        const char* guess = body + bytes / chunks * k;
+        cut[k] = std::max(cut[k - 1], nextLineStart(std::max(guess, body), end));
+    }
+
+    std::unique_ptr<ThreadPool> pool;
+    if (threads > 1) pool = std::make_unique<ThreadPool>(threads - 1);
+    auto forEachChunk = [&](const std::function<void(std::size_t)>& fn) {
+        if (pool) pool->parallelFor(chunks, fn);
+        else      for (std::size_t k = 0; k < chunks; ++k) fn(k);
+    };
+
+    // ---- pass 1: row counts -> output offsets ----
+    std::vector<std::size_t> first(chunks + 1, 0);
+    forEachChunk([&](std::size_t k) { first[k + 1] = countRows(cut[k], cut[k + 1]); });
+    for (std::size_t k = 0; k < chunks; ++k) first[k + 1] += first[k];
+
+    data.steps.assign(first[chunks], 0);
+    data.positions.assign(nBodies, std::vector<vec3>(first[chunks]));
+
+    // ---- pass 2: parse each chunk into rows [first[k], ...) ----
+    std::vector<std::size_t> kept(chunks, 0);
+    forEachChunk([&](std::size_t k) {
+        std::vector<double> row(3 * nBodies);
+        double step = 0.0;
+        std::size_t out = first[k];
+
+        for (const char* line = cut[k]; line < cut[k + 1]; ) {
+            const char* next    = nextLineStart(line, cut[k + 1]);
+            const char* lineEnd = next;
+            while (lineEnd > line && (lineEnd[-1] == '\n' || lineEnd[-1] == '\r')) --lineEnd;
+
+            bool ok = lineEnd > line;
+            const char* p = line;
+            for (std::size_t c = 0; ok && c < columnCount; ++c) {
+                if (c > 0) {
+                    if (p >= lineEnd || *p != ',') { ok = false; break; }
+                    ++p;
+                }
+                const int t = target[c];
+                if (c == 0 && t < 0) {
+                    const auto r = std::from_chars(p, lineEnd, step);
+                    ok = r.ec == std::errc() && (r.ptr == lineEnd || *r.ptr == ',');
+                    p  = r.ptr;
+                    continue;
+                }
+                if (t < 0) {
+                    const void* comma = std::memchr(p, ',', static_cast<std::size_t>(lineEnd - p));
+                    p = comma ? static_cast<const char*>(comma) : lineEnd;
+                    continue;
+                }
+                const auto r = std::from_chars(p, lineEnd, row[static_cast<std::size_t>(t)]);
+                ok = r.ec == std::errc() && (r.ptr == lineEnd || *r.ptr == ',');
+                p  = r.ptr;
+            }
+
+            if (ok) {
+                data.steps[out] = static_cast<long>(step);
+                for (std::size_t b = 0; b < nBodies; ++b) {
+                    data.positions[b][out] = vec3(row[3 * b], row[3 * b + 1], row[3 * b + 2]);
+                }
+                ++out;
+            }
+            line = next;
+        }
+        kept[k] = out - first[k];
+    });
+
+    // ---- close the gaps left by skipped rows ----
+    std::size_t rows = kept[0];
+    for (std::size_t k = 1; k < chunks; ++k) {
+        if (rows != first[k]) {
+            std::copy(data.steps.begin() + static_cast<std::ptrdiff_t>(first[k]),
+                      data.steps.begin() + static_cast<std::ptrdiff_t>(first[k] + kept[k]),
+                      data.steps.begin() + static_cast<std::ptrdiff_t>(rows));
+            for (auto& pos : data.positions) {
+                std::copy(pos.begin() + static_cast<std::ptrdiff_t>(first[k]),
+                          pos.begin() + static_cast<std::ptrdiff_t>(first[k] + kept[k]),
+                          pos.begin() + static_cast<std::ptrdiff_t>(rows));
+            }
+        }
+        rows += kept[k];
+    }
+    data.steps.resize(rows);
+    for (auto& pos : data.positions) pos.resize(rows);
+
+    return data;
+}
@@ -0,0 +1,318 @@
+/********************
+ * Author: Sinan Demir
+ * File: ephemeris_client.cpp
+ * Date: 10/16/2026
+ * Purpose:
+ *    Implementation of the query-daemon client and load generator.
+ *********************/
+
+#include "ephemeris_client.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define ORBIT_CLIENT_SOCKETS 1
+#endif
+
+using namespace protocol;
+
+namespace {
+
+const char* statusText(std::uint16_t s) {
+    switch (s) {
+    case STATUS_OK:           return "ok";
+    case STATUS_BAD_REQUEST:  return "bad request";
+    case STATUS_BAD_BODY:     return "unknown body index";
+    case STATUS_OUT_OF_RANGE: return "time outside the ephemeris span";
+    case STATUS_UNSUPPORTED:  return "unsupported (needs Sun, Earth and Moon)";
+    default:                  return "unknown status";
+    }
+}
+
+#ifdef ORBIT_CLIENT_SOCKETS
+void sendAll(int fd, const char* data, std::size_t n) {
+    while (n > 0) {
+#ifdef MSG_NOSIGNAL
+        const ssize_t w = ::send(fd, data, n, MSG_NOSIGNAL);
+#else
+        const ssize_t w = ::send(fd, data, n, 0);
+#endif
+        if (w <= 0) {
+            if (w < 0 && errno == EINTR) continue;
+            throw std::runtime_error("Connection to orbit-sim serve lost (send)");
+        }
+        data += w;
+        n -= static_cast<std::size_t>(w);
+    }
+}
+
+void recvAll(int fd, char* data, std::size_t n) {
+    while (n > 0) {
+        const ssize_t r = ::recv(fd, data, n, 0);
+        if (r <= 0) {
+            if (r < 0 && errno == EINTR) continue;
+            throw std::runtime_error("Connection to orbit-sim serve lost (recv)");
+        }
+        data += r;
+        n -= static_cast<std::size_t>(r);
+    }
+}
+#endif
+
+} // namespace
+
+int EphemerisInfo::bodyIndex(const std::string& name) const {
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        if (bodies[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+// ============================================================
+//  EphemerisClient
+// ============================================================
+
+#ifdef ORBIT_CLIENT_SOCKETS
+
+EphemerisClient::EphemerisClient(const std::string& socketPath)
+{
+    sockaddr_un addr{};
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + socketPath);
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        const std::string why = std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+        throw std::runtime_error("Could not connect to " + socketPath + ": " + why);
+    }
+}
+
+EphemerisClient::~EphemerisClient() {
+    if (fd >= 0) ::close(fd);
+}
+
+std::uint32_t EphemerisClient::send(Op op, const QueryRecord* queries, std::uint32_t count) {
+    if (count > MAX_BATCH) {
+        throw std::runtime_error("Batch exceeds " + std::to_string(MAX_BATCH) + " queries");
+    }
+
+    const RequestHeader h{REQUEST_MAGIC, VERSION, op, count, nextId++};
+    sendBuffer.resize(sizeof(h) + count * sizeof(QueryRecord));
+    std::memcpy(sendBuffer.data(), &h, sizeof(h));
+    if (count > 0) {
+        std::memcpy(sendBuffer.data() + sizeof(h), queries, count * sizeof(QueryRecord));
+    }
+    sendAll(fd, sendBuffer.data(), sendBuffer.size());
+    return h.requestId;
+}
+
+ResponseHeader EphemerisClient::receive(std::vector<char>& payload) {
+    ResponseHeader r;
+    recvAll(fd, reinterpret_cast<char*>(&r), sizeof(r));
+    if (r.magic != RESPONSE_MAGIC) {
+        throw std::runtime_error("Malformed reply from orbit-sim serve");
+    }
+    payload.resize(static_cast<std::size_t>(r.payloadBytes));
+    if (!payload.empty()) recvAll(fd, payload.data(), payload.size());
+    return r;
+}
+
+#else
+
+EphemerisClient::EphemerisClient(const std::string&) {
+    throw std::runtime_error("orbit-sim serve clients need Unix domain sockets");
+}
+EphemerisClient::~EphemerisClient() = default;
+std::uint32_t EphemerisClient::send(Op, const QueryRecord*, std::uint32_t) { return 0; }
+ResponseHeader EphemerisClient::receive(std::vector<char>&) { return ResponseHeader{}; }
+
+#endif
+
+void EphemerisClient::roundTrip(Op op, const std::vector<QueryRecord>& queries,
+                                std::vector<char>& payload)
+{
+    send(op, queries.data(), static_cast<std::uint32_t>(queries.size()));
+    const ResponseHeader r = receive(payload);
+    if (r.status != STATUS_OK) {
+        throw std::runtime_error(std::string("orbit-sim serve: ") + statusText(r.status));
+    }
+}
+
+EphemerisInfo EphemerisClient::info() {
+    std::vector<char> payload;
+    roundTrip(OP_INFO, {}, payload);
+
+    InfoRecord rec;
+    if (payload.size() < sizeof(rec)) throw std::runtime_error("Malformed info reply");
+    std::memcpy(&rec, payload.data(), sizeof(rec));
+    if (payload.size() < sizeof(rec) + rec.epochBytes) throw std::runtime_error("Malformed info reply");
+
+    EphemerisInfo info;
+    info.startTime = rec.startTime;
+    info.endTime   = rec.endTime;
+    info.degree    = static_cast<int>(rec.degree);
+    info.epoch.assign(payload.data() + sizeof(rec), rec.epochBytes);
+
+    std::size_t pos = sizeof(rec) + rec.epochBytes;
+    while (pos < payload.size()) {
+        const char* begin = payload.data() + pos;
+        const char* nl = static_cast<const char*>(std::memchr(begin, '\n', payload.size() - pos));
+        if (!nl) break;
+        info.bodies.emplace_back(begin, nl);
+        pos += static_cast<std::size_t>(nl - begin) + 1;
+    }
+    return info;
+}
+
+void EphemerisClient::states(const std::vector<QueryRecord>& queries, std::vector<double>& out) {
+    std::vector<char> payload;
+    roundTrip(OP_STATE, queries, payload);
+    const std::size_t n = payload.size() / sizeof(double);
+    const std::size_t base = out.size();
+    out.resize(base + n);
+    std::memcpy(out.data() + base, payload.data(), n * sizeof(double));
+}
+
+void EphemerisClient::positions(const std::vector<QueryRecord>& queries, std::vector<double>& out) {
+    std::vector<char> payload;
+    roundTrip(OP_POSITION, queries, payload);
+    const std::size_t n = payload.size() / sizeof(double);
+    const std::size_t base = out.size();
+    out.resize(base + n);
+    std::memcpy(out.data() + base, payload.data(), n * sizeof(double));
+}
+
+void EphemerisClient::eclipses(const std::vector<double>& times, std::vector<EclipseRecord>& out) {
+    std::vector<QueryRecord> queries(times.size());
+    for (std::size_t i = 0; i < times.size(); ++i) queries[i] = QueryRecord{0, 0, times[i]};
+
+    std::vector<char> payload;
+    roundTrip(OP_ECLIPSE, queries, payload);
+    const std::size_t n = payload.size() / sizeof(EclipseRecord);
+    const std::size_t base = out.size();
+    out.resize(base + n);
+    std::memcpy(out.data() + base, payload.data(), n * sizeof(EclipseRecord));
+}
+
+// ============================================================
+//  Load test
+// ============================================================
+
+/********************
+ * runLoadTest
+ * @brief: Each connection keeps `pipeline` requests of `batch` random
+ *         queries in flight until the deadline.
+ * @param opts - load test options
+ * @return true if every reply was OK
+ *********************/
+bool runLoadTest(const LoadTestOptions& opts)
+{
+    using Clock = std::chrono::steady_clock;
+
+    EphemerisInfo info;
+    try {
+        EphemerisClient probe(opts.socketPath);
+        info = probe.info();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "❌ " << e.what() << "\n";
+        return false;
+    }
+    if (info.bodies.empty()) {
+        std::cerr << "❌ Server holds no bodies\n";
+        return false;
+    }
+
+    const int connections = std::max(1, opts.connections);
+    const int batch       = std::clamp(opts.batch, 1, static_cast<int>(MAX_BATCH));
+    const int pipeline    = std::max(1, opts.pipeline);
+
+    std::atomic<std::uint64_t> totalQueries{0}, totalRequests{0}, failures{0};
+    std::vector<std::vector<double>> latencies(connections);   // µs per request
+    const auto deadline = Clock::now() + std::chrono::duration<double>(opts.seconds);
+
+    auto worker = [&](int id) {
+        try {
+            EphemerisClient client(opts.socketPath);
+            std::mt19937_64 rng(1234 + id);
+            std::uniform_real_distribution<double> ut(info.startTime, info.endTime);
+
+            std::vector<QueryRecord> queries(batch);
+            std::vector<char> payload;
+            std::deque<Clock::time_point> inFlight;
+            std::uint64_t done = 0, requests = 0;
+
+            auto issue = [&] {
+                for (auto& q : queries) {
+                    q = QueryRecord{static_cast<std::uint32_t>(rng() % info.bodies.size()), 0, ut(rng)};
+                }
+                inFlight.push_back(Clock::now());
+                client.send(opts.op, queries.data(), static_cast<std::uint32_t>(batch));
+            };
+
+            for (int i = 0; i < pipeline; ++i) issue();
+            while (!inFlight.empty()) {
+                const ResponseHeader r = client.receive(payload);
+                const auto now = Clock::now();
+                latencies[id].push_back(
+                    std::chrono::duration<double, std::micro>(now - inFlight.front()).count());
+                inFlight.pop_front();
+
+                if (r.status != STATUS_OK) ++failures;
+                done += r.count;
+                ++requests;
+                if (now < deadline) issue();
+            }
+            totalQueries  += done;
+            totalRequests += requests;
+        }
+        catch (const std::exception& e) {
+            std::cerr << "❌ Connection " << id << ": " << e.what() << "\n";
+            ++failures;
+        }
+    };
+
+    const auto t0 = Clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < connections; ++i) threads.emplace_back(worker, i);
+    for (auto& t : threads) t.join();
+    const double elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    std::vector<double> all;
+    for (const auto& l : latencies) all.insert(all.end(), l.begin(), l.end());
+    std::sort(all.begin(), all.end());
+    auto pct = [&](double p) {
+        return all.empty() ? 0.0 : all[std::min(all.size() - 1, static_cast<std::size_t>(p * all.size()))];
+    };
+
+    std::cout << "Load test: " << connections << " connections x " << pipeline
+              << " in flight, " << batch << " queries/request, " << elapsed << " s\n"
+              << " - " << totalRequests.load() << " requests, " << totalQueries.load() << " queries\n"
+              << " - " << static_cast<double>(totalQueries.load()) / elapsed << " queries/s, "
+              << static_cast<double>(totalRequests.load()) / elapsed << " requests/s\n"
+              << " - request latency: p50 " << pct(0.50) << " us, p99 " << pct(0.99)
+              << " us, max " << (all.empty() ? 0.0 : all.back()) << " us\n";
+
+    if (failures.load() > 0) {
+        std::cerr << "❌ " << failures.load() << " failed requests\n";
+        return false;
+    }
+    std::cout << "✅ All replies OK\n";
+    return true;
+}
@@ -0,0 +1,628 @@
+/********************
+ * Author: Sinan Demir
+ * File: ephemeris_server.cpp
+ * Date: 10/16/2026
+ * Purpose:
+ *    Implementation of the orbit-sim serve daemon.
+ *********************/
+
+#include "ephemeris_server.h"
+#include "eclipse.h"
+#include "ephemeris_protocol.h"
+#include "trajectory_binary.h"
+
+#include <iostream>
+
+#ifdef __linux__
+
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+using namespace protocol;
+
+// Batches up to this size are answered on the event-loop thread; the
+// hand-off to a worker would cost more than the evaluation itself.
+constexpr std::uint32_t INLINE_BATCH = 8;
+
+// Backpressure: a connection is read only while no request of it is in
+// flight and it holds less than this much undecoded input (a few maximal
+// requests). Beyond that the kernel socket buffer fills and the client
+// blocks, instead of the server buffering without limit. Output is not
+// capped: clients (e.g. loadtest) write a whole pipeline before reading,
+// and the server must keep answering for them to get there.
+constexpr std::size_t MAX_PENDING_BYTES =
+    4 * (sizeof(RequestHeader) + std::size_t(MAX_BATCH) * sizeof(QueryRecord));
+
+/********************
+ * struct Job
+ * @brief: One decoded request, or (as a completion) its encoded response.
+ *********************/
+struct Job {
+    std::uint64_t            connId = 0;
+    RequestHeader            header{};
+    std::vector<QueryRecord> queries;
+    std::vector<char>        response;
+};
+
+/********************
+ * struct Connection
+ * @brief: Per-client buffers. At most one request per connection is in
+ *         flight, which keeps pipelined responses in request order.
+ *********************/
+struct Connection {
+    int               fd = -1;
+    std::uint64_t     id = 0;
+    std::vector<char> in;          ///< received bytes not yet decoded
+    std::size_t       inStart = 0; ///< first undecoded byte in `in`
+    std::vector<char> out;         ///< encoded responses not yet sent
+    std::size_t       outSent = 0;
+    bool              busy       = false;
+    bool              readClosed = false;   ///< peer sent EOF (may still await replies)
+    bool              broken     = false;   ///< protocol or socket error: drop now
+    std::uint32_t     events     = EPOLLIN; ///< currently registered epoll mask
+};
+
+/********************
+ * class QueryEngine
+ * @brief: Evaluates request batches against the mapped ephemeris.
+ *         Stateless apart from the read-only mapping: safe from any thread.
+ *********************/
+class QueryEngine {
+public:
+    explicit QueryEngine(const ChebyshevEphemeris& eph) : eph(eph) {
+        sun   = eph.bodyIndex("Sun");
+        earth = eph.bodyIndex("Earth");
+        moon  = eph.bodyIndex("Moon");
+    }
+
+    void answer(const RequestHeader& h, const std::vector<QueryRecord>& q,
+                std::vector<char>& response) const
+    {
+        ResponseHeader r{RESPONSE_MAGIC, STATUS_OK, h.op, h.count, h.requestId, 0};
+        response.clear();
+
+        auto status = [&](Status s) {
+            r.status = s;
+            r.payloadBytes = 0;
+            append(response, &r, sizeof(r));
+        };
+
+        switch (h.op) {
+        case OP_INFO: {
+            std::string names;
+            for (std::size_t i = 0; i < eph.size(); ++i) {
+                names.append(eph.name(i)).push_back('\n');
+            }
+            const std::string_view epoch = eph.epoch();
+            InfoRecord info{static_cast<std::uint32_t>(eph.size()),
+                            static_cast<std::uint32_t>(eph.degree()),
+                            eph.startTime(), eph.endTime(),
+                            static_cast<std::uint32_t>(epoch.size()), 0};
+            r.payloadBytes = sizeof(info) + epoch.size() + names.size();
+            append(response, &r, sizeof(r));
+            append(response, &info, sizeof(info));
+            append(response, epoch.data(), epoch.size());
+            append(response, names.data(), names.size());
+            return;
+        }
+        case OP_STATE:
+        case OP_POSITION:
+        case OP_ECLIPSE:
+            break;
+        default:
+            status(STATUS_BAD_REQUEST);
+            return;
+        }
+
+        // Validate the whole batch before evaluating any of it
+        for (const QueryRecord& rec : q) {
+            if (h.op != OP_ECLIPSE && rec.body >= eph.size()) { status(STATUS_BAD_BODY);     return; }
+            if (!eph.contains(rec.t))                          { status(STATUS_OUT_OF_RANGE); return; }
+        }
+        if (h.op == OP_ECLIPSE && (sun < 0 || earth < 0 || moon < 0)) {
+            status(STATUS_UNSUPPORTED);
+            return;
+        }
+
+        const std::size_t stride = (h.op == OP_STATE)    ? 6 * sizeof(double)
+                                 : (h.op == OP_POSITION) ? 3 * sizeof(double)
+                                                         : sizeof(EclipseRecord);
+        r.payloadBytes = q.size() * stride;
+        response.resize(sizeof(r) + r.payloadBytes);
+        std::memcpy(response.data(), &r, sizeof(r));
+        char* out = response.data() + sizeof(r);
+
+        for (const QueryRecord& rec : q) {
+            if (h.op == OP_STATE) {
+                vec3 p, v;
+                eph.state(rec.body, rec.t, p, v);
+                const double s[6] = {p.x(), p.y(), p.z(), v.x(), v.y(), v.z()};
+                std::memcpy(out, s, sizeof(s));
+            } else if (h.op == OP_POSITION) {
+                const vec3 p = eph.position(rec.body, rec.t);
+                const double s[3] = {p.x(), p.y(), p.z()};
+                std::memcpy(out, s, sizeof(s));
+            } else {
+                const EclipseResult e = computeSolarEclipse(eph.position(sun, rec.t),
+                                                            eph.position(earth, rec.t),
+                                                            eph.position(moon, rec.t));
+                EclipseRecord er{e.eclipseType, 0,
+                                 {e.shadowCenter.x(), e.shadowCenter.y(), e.shadowCenter.z()},
+                                 e.umbraRadius, e.penumbraRadius};
+                std::memcpy(out, &er, sizeof(er));
+            }
+            out += stride;
+        }
+    }
+
+private:
+    static void append(std::vector<char>& buf, const void* data, std::size_t n) {
+        const char* p = static_cast<const char*>(data);
+        buf.insert(buf.end(), p, p + n);
+    }
+
+    const ChebyshevEphemeris& eph;
+    int sun = -1, earth = -1, moon = -1;
+};
+
+/********************
+ * class WorkerPool
+ * @brief: Fixed set of threads evaluating jobs; completed jobs are queued
+ *         back and signalled to the event loop through an eventfd.
+ *********************/
+class WorkerPool {
+public:
+    WorkerPool(const QueryEngine& engine, unsigned threads, int wakeFd)
+        : engine(engine), wakeFd(wakeFd)
+    {
+        for (unsigned i = 0; i < threads; ++i) {
+            workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto& t : workers) t.join();
+    }
+
+    void submit(Job job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(std::move(job));
+        }
+        ready.notify_one();
+    }
+
+    /// Moves every finished job into `out`.
+    void collect(std::deque<Job>& out) {
+        std::lock_guard<std::mutex> lock(doneMutex);
+        while (!done.empty()) {
+            out.push_back(std::move(done.front()));
+            done.pop_front();
+        }
+    }
+
+private:
+    void work() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [this] { return stopping || !pending.empty(); });
+                if (stopping && pending.empty()) return;
+                job = std::move(pending.front());
+                pending.pop_front();
+            }
+
+            engine.answer(job.header, job.queries, job.response);
+
+            {
+                std::lock_guard<std::mutex> lock(doneMutex);
+                done.push_back(std::move(job));
+            }
+            const std::uint64_t one = 1;
+            ssize_t w = ::write(wakeFd, &one, sizeof(one));
+            (void)w;
+        }
+    }
+
+    const QueryEngine&       engine;
+    int                      wakeFd;
+    std::vector<std::thread> workers;
+
+    std::mutex               mutex;
+    std::condition_variable  ready;
+    std::deque<Job>          pending;
+    bool                     stopping = false;
+
+    std::mutex               doneMutex;
+    std::deque<Job>          done;
+};
+
+/********************
+ * class EventLoop
+ * @brief: Owns the listening socket and all client connections.
+ *********************/
+class EventLoop {
+public:
+    EventLoop(const QueryEngine& engine, WorkerPool& pool, int epfd, int listenFd, int wakeFd)
+        : engine(engine), pool(pool), epfd(epfd), listenFd(listenFd), wakeFd(wakeFd) {}
+
+    ~EventLoop() {
+        for (auto& [fd, c] : connections) ::close(fd);
+    }
+
+    void onListen() {
+        for (;;) {
+            int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return;   // EAGAIN or transient error
+
+            Connection& c = connections[fd];
+            c = Connection{};
+            c.fd = fd;
+            c.id = ++nextId;
+            byId[c.id] = fd;
+            epoll_event ev{};
+            ev.events  = EPOLLIN;
+            ev.data.fd = fd;
+            ::epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+        }
+    }
+
+    void onClient(int fd, std::uint32_t events) {
+        auto it = connections.find(fd);
+        if (it == connections.end()) return;
+        Connection& c = it->second;
+
+        if (events & EPOLLIN) {
+            char buf[64 * 1024];
+            while (wantsInput(c)) {
+                const ssize_t n = ::read(fd, buf, sizeof(buf));
+                if (n > 0) { c.in.insert(c.in.end(), buf, buf + n); continue; }
+                if (n == 0) c.readClosed = true;
+                else if (errno != EAGAIN && errno != EWOULDBLOCK) c.broken = true;
+                break;
+            }
+            dispatch(c);
+        }
+        else if (events & (EPOLLERR | EPOLLHUP)) {
+            c.broken = true;
+        }
+        if (events & EPOLLOUT) flush(c);
+        closeIfDone(fd);
+    }
+
+    void onWake() {
+        std::uint64_t count;
+        ssize_t r = ::read(wakeFd, &count, sizeof(count));
+        (void)r;
+
+        std::deque<Job> finished;
+        pool.collect(finished);
+        for (Job& job : finished) {
+            // The connection may be gone (and its fd reused) by now
+            auto id = byId.find(job.connId);
+            if (id == byId.end()) continue;
+
+            const int fd = id->second;
+            Connection& c = connections[fd];
+            c.busy = false;
+            c.out.insert(c.out.end(), job.response.begin(), job.response.end());
+            dispatch(c);
+            closeIfDone(fd);
+        }
+    }
+
+    std::uint64_t requests = 0;
+    std::uint64_t queries  = 0;
+
+private:
+    /********************
+     * dispatch
+     * @brief: Decodes the next complete request, if any, and answers it
+     *         inline (tiny batches) or hands it to the pool.
+     *********************/
+    void dispatch(Connection& c) {
+        while (!c.busy) {
+            const std::size_t avail = c.in.size() - c.inStart;
+            if (avail < sizeof(RequestHeader)) break;
+
+            RequestHeader h;
+            std::memcpy(&h, c.in.data() + c.inStart, sizeof(h));
+            if (h.magic != REQUEST_MAGIC || h.version != VERSION || h.count > MAX_BATCH) {
+                // The stream cannot be resynchronised: drop the client
+                c.broken = true;
+                c.in.clear();
+                c.inStart = 0;
+                break;
+            }
+
+            const std::size_t need = sizeof(h) + std::size_t(h.count) * sizeof(QueryRecord);
+            if (avail < need) break;
+
+            Job job;
+            job.connId = c.id;
+            job.header = h;
+            job.queries.resize(h.count);
+            std::memcpy(job.queries.data(), c.in.data() + c.inStart + sizeof(h),
+                        std::size_t(h.count) * sizeof(QueryRecord));
+            c.inStart += need;
+
+            ++requests;
+            queries += h.count;
+
+            if (h.count <= INLINE_BATCH) {
+                engine.answer(job.header, job.queries, job.response);
+                c.out.insert(c.out.end(), job.response.begin(), job.response.end());
+            } else {
+                c.busy = true;
+                pool.submit(std::move(job));
+            }
+        }
+
+        // Compact the input buffer once it is mostly consumed
+        if (c.inStart > 0 && c.inStart * 2 >= c.in.size()) {
+            c.in.erase(c.in.begin(), c.in.begin() + static_cast<std::ptrdiff_t>(c.inStart));
+            c.inStart = 0;
+        }
+        flush(c);
+    }
+
+    /// True while the connection may take more input (see MAX_PENDING_BYTES).
+    static bool wantsInput(const Connection& c) {
+        return !c.readClosed && !c.busy && c.in.size() - c.inStart < MAX_PENDING_BYTES;
+    }
+
+    void flush(Connection& c) {
+        while (c.outSent < c.out.size()) {
+            const ssize_t n = ::send(c.fd, c.out.data() + c.outSent, c.out.size() - c.outSent,
+                                     MSG_NOSIGNAL);
+            if (n > 0) { c.outSent += static_cast<std::size_t>(n); continue; }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            c.broken = true;   // peer gone
+            break;
+        }
+        if (c.outSent == c.out.size()) {
+            c.out.clear();
+            c.outSent = 0;
+        }
+
+        // Poll for input only while it can be taken (not after EOF, where
+        // level-triggered EPOLLIN would fire forever, nor while a request is
+        // in flight or the buffers are full); for output only while replies
+        // are queued
+        const std::uint32_t wanted = (wantsInput(c) ? std::uint32_t(EPOLLIN) : 0u) |
+                                     (c.out.empty() ? 0u : std::uint32_t(EPOLLOUT));
+        if (wanted != c.events && !c.broken) {
+            c.events = wanted;
+            epoll_event ev{};
+            ev.events  = wanted;
+            ev.data.fd = c.fd;
+            ::epoll_ctl(epfd, EPOLL_CTL_MOD, c.fd, &ev);
+        }
+    }
+
+    /// Closes a broken connection, or one whose peer sent EOF once every
+    /// reply has been delivered.
+    void closeIfDone(int fd) {
+        auto it = connections.find(fd);
+        if (it == connections.end()) return;
+        Connection& c = it->second;
+        if (!c.broken && !(c.readClosed && !c.busy && c.out.empty())) return;
+
+        ::epoll_ctl(epfd, EPOLL_CTL_DEL, fd, nullptr);
+        ::close(fd);
+        byId.erase(c.id);
+        connections.erase(it);
+    }
+
+    const QueryEngine& engine;
+    WorkerPool&        pool;
+    int                epfd, listenFd, wakeFd;
+    std::uint64_t      nextId = 0;
+    std::unordered_map<int, Connection>    connections;
+    std::unordered_map<std::uint64_t, int> byId;   ///< connection id → fd
+};
+
+/********************
+ * openEphemeris
+ * @brief: Maps an ephemeris file, or fits a binary trajectory into a
+ *         temporary one first (unlinked once mapped).
+ *********************/
+std::unique_ptr<ChebyshevEphemeris> openEphemeris(const ServeOptions& opts) {
+    if (isChebyshevEphemeris(opts.inputPath)) {
+        return std::make_unique<ChebyshevEphemeris>(opts.inputPath);
+    }
+    if (!isTrajectoryBinary(opts.inputPath)) {
+        throw std::runtime_error("Not an ephemeris or binary trajectory: " + opts.inputPath);
+    }
+
+    TrajectoryBinaryReader reader(opts.inputPath);
+    const std::string tmp = (std::filesystem::temp_directory_path() /
+                             ("orbit-serve-" + std::to_string(::getpid()) + ".oeph")).string();
+
+    ChebyshevEphemerisWriter writer;
+    if (!writer.open(tmp, reader.bodyNames(), reader.dt(), reader.epoch(), opts.fit)) {
+        throw std::runtime_error("Could not fit trajectory into " + tmp);
+    }
+    TrajectoryFrame frame;
+    while (reader.next(frame)) writer.add(frame);
+    if (!writer.finish()) {
+        std::filesystem::remove(tmp);
+        throw std::runtime_error("Could not fit " + opts.inputPath + ": " + writer.error());
+    }
+
+    auto eph = std::make_unique<ChebyshevEphemeris>(tmp);
+    std::filesystem::remove(tmp);
+
+    std::cout << " - Fitted " << eph->windows() << " Chebyshev windows from the trajectory\n";
+    return eph;
+}
+
+/********************
+ * openListener
+ * @brief: Binds a non-blocking Unix stream socket, replacing a stale
+ *         socket file (but never a regular file).
+ * @return fd, or -1 on failure (reason printed)
+ *********************/
+int openListener(const std::string& path) {
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "❌ Socket path too long: " << path << "\n";
+        return -1;
+    }
+
+    struct stat st{};
+    if (::lstat(path.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            std::cerr << "❌ Refusing to replace non-socket file: " << path << "\n";
+            return -1;
+        }
+        ::unlink(path.c_str());
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        std::cerr << "❌ socket(): " << std::strerror(errno) << "\n";
+        return -1;
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0) {
+        std::cerr << "❌ Could not listen on " << path << ": " << std::strerror(errno) << "\n";
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace
+
+/********************
+ * runEphemerisServer
+ * @brief: Loads the ephemeris, starts the pool and runs the epoll loop.
+ * @param opts - server options
+ * @return true on clean shutdown, false if startup failed
+ * @note: SIGINT/SIGTERM are blocked in every thread and delivered to the
+ *        loop through a signalfd, so shutdown happens between events.
+ *********************/
+bool runEphemerisServer(const ServeOptions& opts)
+{
+    std::unique_ptr<ChebyshevEphemeris> eph;
+    try {
+        eph = openEphemeris(opts);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "❌ " << e.what() << "\n";
+        return false;
+    }
+
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    ::pthread_sigmask(SIG_BLOCK, &signals, nullptr);   // inherited by the workers
+
+    const int listenFd = openListener(opts.socketPath);
+    if (listenFd < 0) return false;
+
+    const int epfd   = ::epoll_create1(EPOLL_CLOEXEC);
+    const int wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    const int sigFd  = ::signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (epfd < 0 || wakeFd < 0 || sigFd < 0) {
+        std::cerr << "❌ Could not create event descriptors: " << std::strerror(errno) << "\n";
+        ::close(listenFd);
+        ::unlink(opts.socketPath.c_str());
+        return false;
+    }
+
+    for (int fd : {listenFd, wakeFd, sigFd}) {
+        epoll_event ev{};
+        ev.events  = EPOLLIN;
+        ev.data.fd = fd;
+        ::epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    const unsigned threads = opts.threads > 0
+                             ? opts.threads
+                             : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "✅ Serving " << eph->size() << " bodies, t = " << eph->startTime()
+              << " .. " << eph->endTime() << " s";
+    if (!eph->epoch().empty()) std::cout << " (epoch " << eph->epoch() << ")";
+    std::cout << "\n - Socket:  " << opts.socketPath
+              << "\n - Workers: " << threads << "\n"
+              << "Press Ctrl+C to stop.\n";
+
+    QueryEngine engine(*eph);
+    std::uint64_t requests = 0, queries = 0;
+    {
+        WorkerPool pool(engine, threads, wakeFd);
+        EventLoop loop(engine, pool, epfd, listenFd, wakeFd);
+
+        epoll_event events[256];
+        bool running = true;
+        while (running) {
+            const int n = ::epoll_wait(epfd, events, 256, -1);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                std::cerr << "❌ epoll_wait: " << std::strerror(errno) << "\n";
+                break;
+            }
+            for (int i = 0; i < n; ++i) {
+                const int fd = events[i].data.fd;
+                if (fd == listenFd)     loop.onListen();
+                else if (fd == wakeFd)  loop.onWake();
+                else if (fd == sigFd)   running = false;
+                else                    loop.onClient(fd, events[i].events);
+            }
+        }
+        requests = loop.requests;
+        queries  = loop.queries;
+    }
+
+    ::close(sigFd);
+    ::close(wakeFd);
+    ::close(epfd);
+    ::close(listenFd);
+    ::unlink(opts.socketPath.c_str());
+
+    std::cout << "\n✅ Server stopped after " << requests << " requests ("
+              << queries << " queries)\n";
+    return true;
+}
+
+#else  // !__linux__
+
+bool runEphemerisServer(const ServeOptions&)
+{
+    std::cerr << "❌ orbit-sim serve requires Linux (epoll)\n";
+    return false;
+}
+
+#endif
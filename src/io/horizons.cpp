@@ -7,6 +7,8 @@
  *********************/
 
 #include "horizons.h"
+#include "horizons_cache.h"
+#include "horizons_parser.h"
 
 #include <curl/curl.h>
 #include <stdexcept>
@@ -14,9 +16,6 @@
 #include <fstream>
 #include <sstream>
 
-#include <nlohmann/json.hpp>
-using json = nlohmann::json;
-
 // libcurl write callback: append received data to std::string buffer
 static size_t writeToStringCallback(void* contents, size_t size, size_t nmemb, void* userp) {
     size_t total = size * nmemb;
@@ -25,83 +24,158 @@ static size_t writeToStringCallback(void* contents, size_t size, size_t nmemb, v
     return total;
 }
 
+static const char* NASA_POST_API = "https://ssd.jpl.nasa.gov/api/horizons.api";
+static const char* NASA_FILE_API = "https://ssd-api.jpl.nasa.gov/horizons_file.api";
+
 /**************************
- * fetchHorizonsEphemeris
- * @brief: Calls the HORIZONS File API and writes raw ephemeris to a file.
- * @param opts       - HORIZONS request options
- * @param outputPath - File where the ephemeris text (from JSON "result") is saved
- * @param verbose    - Enable verbose output
- * @return true on success, false on failure
+ * horizonsTime
+ * @brief: Fix dates: add " 00:00" if user provided only yyyy-mm-dd
  **************************/
-bool fetchHorizonsEphemeris(const HorizonsFetchOptions& opts,
-                            const std::string& outputPath,
-                            bool verbose)
-{
-    const std::string baseUrl = "https://ssd-api.jpl.nasa.gov/horizons_file.api";
+std::string horizonsTime(const std::string& s) {
+    if (s.find(':') == std::string::npos)
+        return s + " 00:00";
+    return s;
+}
 
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        std::cerr << "❌ Failed to initialize libcurl\n";
-        return false;
-    }
+/**************************
+ * horizonsEndpoint
+ **************************/
+std::string horizonsEndpoint(bool usePost, const std::string& endpoint) {
+    if (!endpoint.empty()) return endpoint;
+    return usePost ? NASA_POST_API : NASA_FILE_API;
+}
 
-    // Fix dates: add " 00:00" if user provided only yyyy-mm-dd
-    auto fixDate = [](const std::string& s) {
-        if (s.find(':') == std::string::npos)
-            return s + " 00:00";
-        return s;
-    };
+/**************************
+ * struct PreparedRequest
+ * @brief: Buffers that must outlive a configured curl handle.
+ **************************/
+struct PreparedRequest {
+    std::string url;
+    std::string postData;
+    std::string response;
+};
 
-    std::string fixed_start = fixDate(opts.start_time);
-    std::string fixed_stop  = fixDate(opts.stop_time);
+/**************************
+ * prepareHandle
+ * @brief: Configures a curl easy handle for one HORIZONS VECTORS request
+ *         (GET File API or POST API).
+ * @param curl     - easy handle to configure
+ * @param opts     - HORIZONS request options
+ * @param usePost  - true = POST API, false = GET File API
+ * @param endpoint - base URL override (empty = NASA endpoint)
+ * @param req      - receives URL/body; response is written into it
+ * @param verbose  - print URL/body
+ * @return false if URL escaping failed
+ **************************/
+static bool prepareHandle(CURL* curl,
+                          const HorizonsFetchOptions& opts,
+                          bool usePost,
+                          const std::string& endpoint,
+                          PreparedRequest& req,
+                          bool verbose)
+{
+    const std::string start = horizonsTime(opts.start_time);
+    const std::string stop  = horizonsTime(opts.stop_time);
+
+    if (usePost) {
+        // POST API (recommended by NASA), form-urlencoded body
+        req.url = horizonsEndpoint(true, endpoint);
+
+        std::ostringstream body;
+        body << "format=json"
+             << "&EPHEM_TYPE=VECTORS"
+             << "&COMMAND='"     << opts.command    << "'"
+             << "&CENTER='"      << opts.center     << "'"
+             << "&START_TIME='"  << start           << "'"
+             << "&STOP_TIME='"   << stop            << "'"
+             << "&STEP_SIZE='"   << opts.step_size  << "'"
+             << "&MAKE_EPHEM=YES";
+        req.postData = body.str();
 
-    // Encode parameters EXCEPT CENTER (@ must NOT be escaped)
-    char* esc_cmd   = curl_easy_escape(curl, opts.command.c_str(),   0);
-    char* esc_start = curl_easy_escape(curl, fixed_start.c_str(),    0);
-    char* esc_stop  = curl_easy_escape(curl, fixed_stop.c_str(),     0);
-    char* esc_step  = curl_easy_escape(curl, opts.step_size.c_str(), 0);
+        if (verbose) {
+            std::cout << "\n[VERBOSE] POST → " << req.url << "\n";
+            std::cout << "[VERBOSE] POST body:\n" << req.postData << "\n\n";
+        }
 
-    if (!esc_cmd || !esc_start || !esc_stop || !esc_step) {
-        std::cerr << "❌ curl_easy_escape returned NULL\n";
-        curl_easy_cleanup(curl);
-        return false;
+        curl_easy_setopt(curl, CURLOPT_POST, 1L);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, req.postData.c_str());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(req.postData.size()));
     }
+    else {
+        // Encode parameters EXCEPT CENTER (@ must NOT be escaped)
+        char* esc_cmd   = curl_easy_escape(curl, opts.command.c_str(),   0);
+        char* esc_start = curl_easy_escape(curl, start.c_str(),          0);
+        char* esc_stop  = curl_easy_escape(curl, stop.c_str(),           0);
+        char* esc_step  = curl_easy_escape(curl, opts.step_size.c_str(), 0);
+
+        const bool escaped = esc_cmd && esc_start && esc_stop && esc_step;
+        if (escaped) {
+            // Build GET URL
+            std::ostringstream u;
+            u << horizonsEndpoint(false, endpoint)
+              << "?format=json"
+              << "&COMMAND='"    << esc_cmd      << "'"
+              << "&CENTER='"     << opts.center  << "'"     // NOT escaped
+              << "&EPHEM_TYPE=VECTORS"
+              << "&START_TIME='" << esc_start    << "'"
+              << "&STOP_TIME='"  << esc_stop     << "'"
+              << "&STEP_SIZE='"  << esc_step     << "'"
+              << "&MAKE_EPHEM=YES";
+            req.url = u.str();
+        }
 
-    // Build GET URL
-    std::ostringstream url;
-    url << baseUrl
-        << "?format=json"
-        << "&COMMAND='"    << esc_cmd      << "'"
-        << "&CENTER='"     << opts.center  << "'"     // NOT escaped
-        << "&EPHEM_TYPE=VECTORS"
-        << "&START_TIME='" << esc_start    << "'"
-        << "&STOP_TIME='"  << esc_stop     << "'"
-        << "&STEP_SIZE='"  << esc_step     << "'"
-        << "&MAKE_EPHEM=YES";
-
-    curl_free(esc_cmd);
-    curl_free(esc_start);
-    curl_free(esc_stop);
-    curl_free(esc_step);
+        curl_free(esc_cmd);
+        curl_free(esc_start);
+        curl_free(esc_stop);
+        curl_free(esc_step);
 
-    std::string response;
+        if (!escaped) {
+            std::cerr << "❌ curl_easy_escape returned NULL\n";
+            return false;
+        }
+
+        if (verbose) {
+            std::cout << "\n[VERBOSE] Requesting Horizons...\n";
+            std::cout << "[VERBOSE] GET URL:\n" << req.url << "\n\n";
+        }
+    }
 
     // curl settings
-    curl_easy_setopt(curl, CURLOPT_URL, url.str().c_str());
+    curl_easy_setopt(curl, CURLOPT_URL, req.url.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeToStringCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &req.response);
     curl_easy_setopt(curl, CURLOPT_USERAGENT, "orbit-sim/1.0");
     curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    return true;
+}
 
-    // ────────────────────────────────────────────
-    // VERBOSE MODE: print request URL
-    // ────────────────────────────────────────────
-    if (verbose) {
-        std::cout << "\n[VERBOSE] Requesting Horizons...\n";
-        std::cout << "[VERBOSE] GET URL:\n" << url.str() << "\n\n";
+/**************************
+ * horizonsRequest
+ * @brief: Performs one HORIZONS VECTORS request on a fresh easy handle
+ *         and returns the raw JSON reply.
+ * @param opts     - HORIZONS request options
+ * @param usePost  - true = POST API, false = GET File API
+ * @param verbose  - print URL/body/status and dump horizons_debug.json
+ * @param response - receives the raw reply body
+ * @return true on HTTP 200, false otherwise
+ **************************/
+static bool horizonsRequest(const HorizonsFetchOptions& opts,
+                            bool usePost,
+                            bool verbose,
+                            std::string& response)
+{
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        std::cerr << "❌ Failed to initialize libcurl\n";
+        return false;
+    }
+
+    PreparedRequest req;
+    if (!prepareHandle(curl, opts, usePost, "", req, verbose)) {
+        curl_easy_cleanup(curl);
+        return false;
     }
 
-    // Perform GET request
     CURLcode res = curl_easy_perform(curl);
     if (res != CURLE_OK) {
         std::cerr << "❌ curl_easy_perform failed: "
@@ -124,23 +198,41 @@ bool fetchHorizonsEphemeris(const HorizonsFetchOptions& opts,
         return false;
     }
 
-    // ────────────────────────────────────────────
     // VERBOSE: Save raw JSON body
-    // ────────────────────────────────────────────
     if (verbose) {
         std::ofstream dbg("horizons_debug.json");
-        dbg << response;
-        dbg.close();
+        dbg << req.response;
         std::cout << "[VERBOSE] Raw response saved to horizons_debug.json\n";
     }
 
-    // Parse JSON response
-    json j;
+    response = std::move(req.response);
+    return true;
+}
+
+/**************************
+ * fetchHorizonsText
+ * @brief: Fetches a VECTORS ephemeris and returns the "result" text.
+ * @param opts    - HORIZONS request options
+ * @param text    - receives the ephemeris text
+ * @param usePost - true = POST API, false = GET File API
+ * @param verbose - Enable verbose output
+ * @return true on success, false on failure
+ **************************/
+bool fetchHorizonsText(const HorizonsFetchOptions& opts,
+                       std::string& text,
+                       bool usePost,
+                       bool verbose)
+{
+    std::string response;
+    if (!horizonsRequest(opts, usePost, verbose, response)) {
+        return false;
+    }
+
     try {
-        j = json::parse(response);
+        text = extractHorizonsResult(response, true);
     }
     catch (const std::exception& e) {
-        std::cerr << "❌ Failed to parse HORIZONS JSON: " << e.what() << "\n";
+        std::cerr << "❌ Failed to read HORIZONS reply: " << e.what() << "\n";
 
         if (verbose) {
             std::cerr << "[VERBOSE] First 300 characters of reply:\n";
@@ -148,29 +240,37 @@ bool fetchHorizonsEphemeris(const HorizonsFetchOptions& opts,
         }
         return false;
     }
+    return true;
+}
 
-    if (j.contains("error")) {
-        std::cerr << "❌ HORIZONS API returned error: "
-                  << j["error"].get<std::string>() << "\n";
-        return false;
-    }
-
-    if (!j.contains("result")) {
-        std::cerr << "❌ HORIZONS JSON missing 'result' field\n";
-        return false;
-    }
-
-    std::string ephemText = j["result"].get<std::string>();
-
-    // Write output
+// Writes ephemeris text to outputPath
+static bool saveEphemeris(const std::string& text, const std::string& outputPath) {
     std::ofstream out(outputPath);
     if (!out) {
         std::cerr << "❌ Could not open output file: " << outputPath << "\n";
         return false;
     }
+    out << text;
+    return static_cast<bool>(out);
+}
 
-    out << ephemText;
-    out.close();
+/**************************
+ * fetchHorizonsEphemeris
+ * @brief: Calls the HORIZONS File API and writes raw ephemeris to a file.
+ * @param opts       - HORIZONS request options
+ * @param outputPath - File where the ephemeris text (from JSON "result") is saved
+ * @param verbose    - Enable verbose output
+ * @return true on success, false on failure
+ **************************/
+bool fetchHorizonsEphemeris(const HorizonsFetchOptions& opts,
+                            const std::string& outputPath,
+                            bool verbose)
+{
+    std::string ephemText;
+    if (!fetchHorizonsText(opts, ephemText, false, verbose) ||
+        !saveEphemeris(ephemText, outputPath)) {
+        return false;
+    }
 
     std::cout << "✅ HORIZONS ephemeris saved to: " << outputPath << "\n";
     return true;
@@ -178,128 +278,198 @@ bool fetchHorizonsEphemeris(const HorizonsFetchOptions& opts,
 
 /*******************
  * fetchHorizonsEphemerisPOST
- * @brief: Calls the HORIZONS File API using HTTP POST and writes raw ephemer
+ * @brief: Calls the HORIZONS API using HTTP POST (recommended by NASA)
+ *         and writes raw ephemeris to a file.
  * @param opts       - HORIZONS request options
  * @param outputPath - File where the ephemeris text (from JSON "result")
  * @param verbose    - Enable verbose output
  * @return true on success, false on failure
  *******************/
-/****************************************************
- * POST-based Horizons fetch (recommended by NASA)
- ****************************************************/
 bool fetchHorizonsEphemerisPOST(const HorizonsFetchOptions& opts,
                                 const std::string& outputPath,
                                 bool verbose)
 {
-//   const std::string url = "https://ssd-api.jpl.nasa.gov/horizons_file.api";  // GET API
-   const std::string url = "https://ssd.jpl.nasa.gov/api/horizons.api";  // POST API
-
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        std::cerr << "❌ Failed to initialize libcurl\n";
+    std::string text;
+    if (!fetchHorizonsText(opts, text, true, verbose) ||
+        !saveEphemeris(text, outputPath)) {
         return false;
     }
 
-    // Fix YYYY-MM-DD → YYYY-MM-DD 00:00
-    auto fixDate = [](const std::string& s){
-        if (s.find(':') == std::string::npos)
-            return s + " 00:00";
-        return s;
-    };
-
-    std::string start = fixDate(opts.start_time);
-    std::string stop  = fixDate(opts.stop_time);
+    std::cout << "✅ POST Horizons ephemeris saved to: " << outputPath << "\n";
+    return true;
+}
 
-    // Build POST body (NASA requires form-urlencoded)
-    std::ostringstream body;
+// ============================================================
+//  Concurrent transport (curl_multi)
+// ============================================================
 
-    body << "format=json"
-         << "&EPHEM_TYPE=VECTORS"
-         << "&COMMAND='"     << opts.command    << "'"
-         << "&CENTER='"      << opts.center     << "'"
-         << "&START_TIME='"  << start           << "'"
-         << "&STOP_TIME='"   << stop            << "'"
-         << "&STEP_SIZE='"   << opts.step_size  << "'"
-         << "&MAKE_EPHEM=YES";
+/*******************
+ * CurlMultiTransport (constructor)
+ *******************/
+CurlMultiTransport::CurlMultiTransport(const CurlTransportOptions& options)
+    : opt(options)
+{
+    if (opt.maxConnections < 1) opt.maxConnections = 1;
+}
 
-    std::string postData = body.str();
+/*******************
+ * fetchAll
+ * @brief: Adds one easy handle per request to a single multi handle and
+ *         drives them to completion.
+ * @note: All transfers share the multi handle's connection cache, so
+ *        requests to the same host reuse TCP/TLS connections (and HTTP/2
+ *        multiplexing where the server offers it). At most maxConnections
+ *        are opened; the rest wait in curl's pending queue.
+ *******************/
+std::vector<HorizonsReply> CurlMultiTransport::fetchAll(const std::vector<HorizonsFetchOptions>& requests)
+{
+    std::vector<HorizonsReply> replies(requests.size());
+    if (requests.empty()) return replies;
 
-    if (verbose) {
-        std::cout << "\n[VERBOSE] POST → " << url << "\n";
-        std::cout << "[VERBOSE] POST body:\n" << postData << "\n\n";
+    CURLM* multi = curl_multi_init();
+    if (!multi) {
+        for (auto& r : replies) r.error = "Failed to initialize libcurl multi handle";
+        return replies;
+    }
+    curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS,  static_cast<long>(opt.maxConnections));
+    curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, static_cast<long>(opt.maxConnections));
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+    std::vector<PreparedRequest> prepared(requests.size());
+    std::vector<CURL*>           handles(requests.size(), nullptr);
+
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        CURL* h = curl_easy_init();
+        if (!h) {
+            replies[i].error = "Failed to initialize libcurl";
+            continue;
+        }
+        if (!prepareHandle(h, requests[i], opt.usePost, opt.endpoint, prepared[i], opt.verbose)) {
+            replies[i].error = "curl_easy_escape returned NULL";
+            curl_easy_cleanup(h);
+            continue;
+        }
+        curl_easy_setopt(h, CURLOPT_PRIVATE, reinterpret_cast<char*>(i));
+        curl_easy_setopt(h, CURLOPT_TIMEOUT, opt.timeoutSeconds);
+        curl_multi_add_handle(multi, h);
+        handles[i] = h;
     }
 
-    std::string response;
-
-    // libcurl settings
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postData.c_str());
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, postData.size());
-
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeToStringCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, "orbit-sim/1.0");
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    int running = 0;
+    do {
+        CURLMcode mc = curl_multi_perform(multi, &running);
+        if (mc == CURLM_OK && running) {
+            mc = curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+        }
+        if (mc != CURLM_OK) {
+            for (std::size_t i = 0; i < handles.size(); ++i) {
+                if (handles[i] && replies[i].error.empty() && !replies[i].ok) {
+                    replies[i].error = curl_multi_strerror(mc);
+                }
+            }
+            break;
+        }
 
-    CURLcode res = curl_easy_perform(curl);
+        int queued = 0;
+        while (CURLMsg* msg = curl_multi_info_read(multi, &queued)) {
+            if (msg->msg != CURLMSG_DONE) continue;
+
+            char* priv = nullptr;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &priv);
+            const std::size_t i = reinterpret_cast<std::size_t>(priv);
+
+            HorizonsReply& r = replies[i];
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &r.httpCode);
+
+            if (msg->data.result != CURLE_OK) {
+                r.error = curl_easy_strerror(msg->data.result);
+            } else if (r.httpCode != 200) {
+                r.error = "HTTP " + std::to_string(r.httpCode);
+            } else {
+                r.ok   = true;
+                r.body = std::move(prepared[i].response);
+            }
+            if (opt.verbose) {
+                std::cout << "[VERBOSE] " << requests[i].command << ": "
+                          << (r.ok ? "HTTP 200" : r.error) << "\n";
+            }
+        }
+    } while (running);
 
-    if (res != CURLE_OK) {
-        std::cerr << "❌ curl_easy_perform failed: "
-                  << curl_easy_strerror(res) << "\n";
-        curl_easy_cleanup(curl);
-        return false;
+    for (CURL* h : handles) {
+        if (!h) continue;
+        curl_multi_remove_handle(multi, h);
+        curl_easy_cleanup(h);
     }
+    curl_multi_cleanup(multi);
+    return replies;
+}
 
-    long httpCode = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
+/*******************
+ * source
+ *******************/
+std::string CurlMultiTransport::source() const {
+    return (opt.usePost ? "POST " : "GET ") + horizonsEndpoint(opt.usePost, opt.endpoint);
+}
 
-    if (verbose) {
-        std::cout << "[VERBOSE] HTTP status: " << httpCode << "\n";
+/*******************
+ * fetchHorizonsBatch
+ * @brief: Serves each request from the cache when possible and sends the
+ *         rest through the transport in one batch.
+ *******************/
+bool fetchHorizonsBatch(const std::vector<HorizonsFetchOptions>& requests,
+                        HorizonsTransport& transport,
+                        const HorizonsCache* cache,
+                        std::vector<std::string>& texts)
+{
+    texts.assign(requests.size(), std::string());
+
+    std::vector<std::size_t>          missIndex;
+    std::vector<HorizonsFetchOptions> misses;
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        if (cache && cache->load(transport.source(), requests[i], texts[i])) continue;
+        missIndex.push_back(i);
+        misses.push_back(requests[i]);
     }
 
-    curl_easy_cleanup(curl);
-
-    if (httpCode != 200) {
-        std::cerr << "❌ Horizons returned HTTP " << httpCode << "\n";
-        return false;
-    }
+    std::cout << " - " << (requests.size() - misses.size()) << " cached, "
+              << misses.size() << " to fetch\n";
 
-    // Optional debugging dump
-    if (verbose) {
-        std::ofstream dbg("horizons_debug.json");
-        dbg << response;
-        std::cout << "[VERBOSE] Raw response saved to horizons_debug.json\n";
-    }
+    bool ok = true;
+    const std::vector<HorizonsReply> replies = transport.fetchAll(misses);
+    for (std::size_t k = 0; k < misses.size(); ++k) {
+        const HorizonsReply& r = replies[k];
+        const std::size_t    i = missIndex[k];
 
-    // Parse JSON from the API
-    json j;
-    try {
-        j = json::parse(response);
-    }
-    catch (const std::exception& e) {
-        std::cerr << "❌ Failed to parse JSON: " << e.what() << "\n";
-        return false;
-    }
+        if (!r.ok) {
+            std::cerr << "❌ Fetch failed for " << misses[k].command << ": " << r.error << "\n";
+            ok = false;
+            continue;
+        }
 
-    if (!j.contains("result")) {
-        std::cerr << "❌ JSON missing 'result' field\n";
-        return false;
-    }
+        try {
+            texts[i] = extractHorizonsResult(r.body, true);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "❌ Bad HORIZONS reply for " << misses[k].command << ": " << e.what() << "\n";
+            ok = false;
+            continue;
+        }
 
-    std::string text = j["result"].get<std::string>();
+        // HORIZONS reports unknown targets, bad dates etc. inside "result";
+        // such text must neither be cached nor treated as an ephemeris
+        if (!hasVectorsTable(texts[i])) {
+            std::cerr << "❌ HORIZONS returned no ephemeris for " << misses[k].command << ":\n"
+                      << texts[i].substr(0, 600) << "\n";
+            texts[i].clear();
+            ok = false;
+            continue;
+        }
 
-    // Save ephemeris text
-    std::ofstream out(outputPath);
-    if (!out) {
-        std::cerr << "❌ Couldn't open output file: " << outputPath << "\n";
-        return false;
+        if (cache && !cache->store(transport.source(), misses[k], texts[i])) {
+            std::cerr << "⚠️  Could not write cache entry "
+                      << cache->pathFor(transport.source(), misses[k]) << "\n";
+        }
     }
-
-    out << text;
-
-    std::cout << "✅ POST Horizons ephemeris saved to: " << outputPath << "\n";
-    return true;
+    return ok;
 }
-
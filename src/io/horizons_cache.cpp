@@ -0,0 +1,108 @@
+/********************
+ * Author: Sinan Demir
+ * File: horizons_cache.cpp
+ * Date: 10/16/2026
+ * Purpose:
+ *    Implementation of the content-addressed HORIZONS cache.
+ *********************/
+
+#include "horizons_cache.h"
+#include "horizons_parser.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+static const char* CACHE_TAG = "# orbit-sim horizons cache v2: ";
+
+HorizonsCache::HorizonsCache(std::string directory)
+    : dir(std::move(directory))
+{}
+
+std::string HorizonsCache::defaultDirectory() {
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+        return (fs::path(xdg) / "orbit-sim" / "horizons").string();
+    }
+    if (const char* home = std::getenv("HOME"); home && *home) {
+        return (fs::path(home) / ".cache" / "orbit-sim" / "horizons").string();
+    }
+    return ".horizons_cache";
+}
+
+std::string HorizonsCache::requestKey(const std::string& source, const HorizonsFetchOptions& opts) {
+    // Dates as sent, so "2025-01-01" and "2025-01-01 00:00" share an entry
+    return source + "|" + opts.command + "|" + opts.center + "|"
+         + horizonsTime(opts.start_time) + "|" + horizonsTime(opts.stop_time) + "|"
+         + opts.step_size;
+}
+
+std::uint64_t HorizonsCache::hash(const std::string& source, const HorizonsFetchOptions& opts) {
+    std::uint64_t h = 0xcbf29ce484222325ull;          // FNV offset basis
+    for (unsigned char c : requestKey(source, opts)) {
+        h ^= c;
+        h *= 0x100000001b3ull;                         // FNV prime
+    }
+    return h;
+}
+
+std::string HorizonsCache::pathFor(const std::string& source, const HorizonsFetchOptions& opts) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.txt",
+                  static_cast<unsigned long long>(hash(source, opts)));
+    return (fs::path(dir) / name).string();
+}
+
+/********************
+ * load
+ * @brief: Reads an entry and checks its key line against the request.
+ *         An entry without a VECTORS table is a miss.
+ *********************/
+bool HorizonsCache::load(const std::string& source, const HorizonsFetchOptions& opts,
+                         std::string& text) const {
+    std::ifstream in(pathFor(source, opts), std::ios::binary);
+    if (!in) return false;
+
+    std::string header;
+    if (!std::getline(in, header) || header != CACHE_TAG + requestKey(source, opts)) {
+        return false;   // collision or foreign file
+    }
+
+    std::ostringstream buf;
+    buf << in.rdbuf();
+    if (!hasVectorsTable(buf.str())) return false;
+    text = buf.str();
+    return true;
+}
+
+/********************
+ * store
+ * @brief: Writes <entry>.tmp then renames it over the entry, so readers
+ *         never see a partial file.
+ *********************/
+bool HorizonsCache::store(const std::string& source, const HorizonsFetchOptions& opts,
+                          const std::string& text) const {
+    if (!hasVectorsTable(text)) return false;
+
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+
+    const std::string path = pathFor(source, opts);
+    const std::string tmp  = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out << CACHE_TAG << requestKey(source, opts) << "\n" << text;
+        if (!out) return false;
+    }
+
+    fs::rename(tmp, path, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,211 @@
+/********************
+ * Author: Sinan Demir
+ * File: shadow_export.cpp
+ * Date: 10/16/2026
+ * Purpose:
+ *    Implementation of the shadow-map image sequence exporter.
+ *********************/
+
+#include "shadow_export.h"
+#include "trajectory_binary.h"
+#include "trajectory_csv.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+namespace {
+
+// Fewest significant digits accepted in CSV positions. The umbra is only
+// ~100-200 km wide; at 1 AU, 10 digits resolve ~15 m, while the old
+// 6-digit CSVs (1.49984e+11) are off by up to ~1000 km.
+constexpr int MIN_CSV_DIGITS = 10;
+
+/********************
+ * significantDigits
+ * @brief: Significant digits of one decimal field as written
+ *         ("1.49984e+11" → 6, "-0.0012" → 2).
+ *********************/
+int significantDigits(const std::string& field)
+{
+    int digits  = 0;
+    int pending = 0;   // zeros after the first nonzero digit, not yet counted
+    bool leading = true;
+    for (char c : field) {
+        if (c == 'e' || c == 'E') break;
+        if (!std::isdigit(static_cast<unsigned char>(c))) continue;
+        if (c == '0') {
+            if (!leading) ++pending;
+            continue;
+        }
+        leading = false;
+        digits += pending + 1;
+        pending = 0;
+    }
+    return digits;
+}
+
+/********************
+ * csvPrecision
+ * @brief: Most significant digits of any field in the first data row of a
+ *         trajectory CSV (0 if it has none).
+ *********************/
+int csvPrecision(const std::string& path)
+{
+    std::ifstream in(path);
+    std::string line;
+    if (!std::getline(in, line) || !std::getline(in, line)) return 0;
+
+    int best = 0;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ',')) best = std::max(best, significantDigits(field));
+    return best;
+}
+
+} // namespace
+
+/********************
+ * exportShadowMaps
+ * @brief: Renders Sun–Earth–Moon shadow maps for a trajectory (.otraj or
+ *         full-precision CSV).
+ * @param opts - export options
+ * @return true on success, false on failure
+ * @note: Two ShadowMap buffers are used: while frame k is written to disk
+ *        on a background task, frame k+1 is rendered into the other one.
+ *********************/
+bool exportShadowMaps(const ShadowExportOptions& opts)
+{
+    bool (*writer)(const std::string&, const ShadowMap&) = nullptr;
+    if (opts.format == "ppm")      writer = writeShadowPPM;
+    else if (opts.format == "pgm") writer = writeShadowPGM;
+    else if (opts.format == "pfm") writer = writeShadowPFM;
+    else {
+        std::cerr << "❌ Unknown shadow format: " << opts.format
+                  << " (expected ppm, pgm or pfm)\n";
+        return false;
+    }
+
+    try {
+        // Full-precision binary trajectory, or a CSV written with enough
+        // digits to place the umbra
+        std::unique_ptr<TrajectoryBinaryReader> binary;
+        std::unique_ptr<TrajectoryCSVReader>    csv;
+        std::vector<std::string>                names;
+        if (isTrajectoryBinary(opts.inputPath)) {
+            binary = std::make_unique<TrajectoryBinaryReader>(opts.inputPath);
+            names  = binary->bodyNames();
+        } else {
+            const int digits = csvPrecision(opts.inputPath);
+            if (digits < MIN_CSV_DIGITS) {
+                std::cerr << "❌ " << opts.inputPath << " stores positions with only " << digits
+                          << " significant digits (need " << MIN_CSV_DIGITS << "): the shadow would be"
+                          << " misplaced by up to ~1000 km.\n"
+                          << "   Use the .otraj from 'orbit-sim run --trajectory', or re-run to get a"
+                          << " full-precision CSV.\n";
+                return false;
+            }
+            csv   = std::make_unique<TrajectoryCSVReader>(opts.inputPath);
+            names = csv->bodyNames();
+        }
+
+        auto indexOf = [&](const char* name) {
+            const auto it = std::find(names.begin(), names.end(), name);
+            return it == names.end() ? -1 : static_cast<int>(it - names.begin());
+        };
+        const int iSun   = indexOf("Sun");
+        const int iEarth = indexOf("Earth");
+        const int iMoon  = indexOf("Moon");
+        if (iSun < 0 || iEarth < 0 || iMoon < 0) {
+            std::cerr << "❌ Trajectory must contain Sun, Earth and Moon\n";
+            return false;
+        }
+
+        // Next frame: its number in the file name (CSV step column, or
+        // frame index of the .otraj, 0 = initial state) and positions
+        TrajectoryFrame  frame;
+        TrajectoryCSVRow row;
+        long             binaryIndex = -1;
+        long             number      = 0;
+        const std::vector<vec3>* positions = nullptr;
+        auto next = [&]() {
+            if (binary) {
+                if (!binary->next(frame)) return false;
+                number    = ++binaryIndex;
+                positions = &frame.positions;
+            } else {
+                if (!csv->next(row)) return false;
+                number    = row.step;
+                positions = &row.positions;
+            }
+            return true;
+        };
+
+        std::filesystem::create_directories(opts.outputDir);
+
+        ShadowMapRenderer renderer(opts.map);
+        ShadowMap buffers[2];
+        std::future<bool> pendingWrite;
+        int current = 0;
+
+        const int every = std::max(1, opts.every);
+        long rowIndex = 0;
+        long frames   = 0;
+        double renderSeconds = 0.0;
+        bool ok = true;
+
+        auto t0 = std::chrono::steady_clock::now();
+
+        while (next()) {
+            if (rowIndex++ % every != 0) continue;
+
+            ShadowMap& map = buffers[current];
+
+            auto r0 = std::chrono::steady_clock::now();
+            const std::vector<vec3>& p = *positions;
+            renderer.render(p[iSun], p[iEarth], p[iMoon], map);
+            auto r1 = std::chrono::steady_clock::now();
+            renderSeconds += std::chrono::duration<double>(r1 - r0).count();
+
+            // Finish the previous write before reusing its buffer next turn
+            if (pendingWrite.valid() && !pendingWrite.get()) ok = false;
+
+            std::ostringstream name;
+            name << "shadow_" << std::setw(6) << std::setfill('0') << number
+                 << "." << opts.format;
+            const std::string path = (std::filesystem::path(opts.outputDir) / name.str()).string();
+
+            pendingWrite = std::async(std::launch::async, writer, path, std::cref(map));
+            current ^= 1;
+            ++frames;
+        }
+
+        if (pendingWrite.valid() && !pendingWrite.get()) ok = false;
+
+        auto t1 = std::chrono::steady_clock::now();
+        const double total = std::chrono::duration<double>(t1 - t0).count();
+
+        std::cout << "✅ Rendered " << frames << " shadow maps ("
+                  << renderer.options().width << "x" << renderer.options().height
+                  << ") → " << opts.outputDir << "\n";
+        if (frames > 0) {
+            std::cout << " - render: " << frames / renderSeconds << " fps"
+                      << " | end-to-end (incl. I/O): " << frames / total << " fps\n";
+        }
+        if (!ok) {
+            std::cerr << "⚠️ Some frames could not be written\n";
+        }
+        return ok;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "❌ Shadow export failed: " << e.what() << "\n";
+        return false;
+    }
+}
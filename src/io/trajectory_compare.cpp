@@ -0,0 +1,415 @@
+/********************
+ * Author: Sinan Demir
+ * File: trajectory_compare.cpp
+ * Date: 10/16/2026
+ * Purpose:
+ *    Implementation of the trajectory-vs-HORIZONS comparison.
+ *********************/
+
+#include "trajectory_compare.h"
+#include "horizons_parser.h"
+#include "trajectory_binary.h"
+#include "trajectory_csv.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+namespace {
+
+/********************
+ * class FrameSource
+ * @brief: Sequential access to trajectory frames, whatever the format.
+ *********************/
+class FrameSource {
+public:
+    virtual ~FrameSource() = default;
+    virtual const std::vector<std::string>& bodyNames() const = 0;
+    virtual bool next(TrajectoryFrame& frame) = 0;
+};
+
+class BinaryFrameSource : public FrameSource {
+public:
+    explicit BinaryFrameSource(const std::string& path) : reader(path) {}
+    const std::vector<std::string>& bodyNames() const override { return reader.bodyNames(); }
+    bool next(TrajectoryFrame& frame) override { return reader.next(frame); }
+    const std::string& epoch() const { return reader.epoch(); }
+
+private:
+    TrajectoryBinaryReader reader;
+};
+
+/// CSV row `step` holds the state after step+1 RK4 steps, i.e. t = (step+1)*dt.
+class CSVFrameSource : public FrameSource {
+public:
+    CSVFrameSource(const std::string& path, double dt) : reader(path), dt(dt) {}
+    const std::vector<std::string>& bodyNames() const override { return reader.bodyNames(); }
+    bool next(TrajectoryFrame& frame) override {
+        if (!reader.next(row)) return false;
+        frame.t = static_cast<double>(row.step + 1) * dt;
+        frame.positions.swap(row.positions);
+        frame.velocities.clear();
+        return true;
+    }
+
+private:
+    TrajectoryCSVReader reader;
+    TrajectoryCSVRow    row;
+    double              dt;
+};
+
+/// One reference epoch of one body, in simulation time.
+struct ReferenceEvent {
+    double t;        ///< s since the trajectory epoch
+    int    body;     ///< trajectory body index
+    int    ref;      ///< index into references
+    int    state;    ///< index into references[ref].states
+};
+
+/// Interpolation error at one reference epoch.
+struct ErrorSample {
+    double jd;
+    double t;
+    vec3   dr;
+    vec3   dv;
+};
+
+bool equalsIgnoreCase(const std::string& a, const std::string& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) !=
+            std::tolower(static_cast<unsigned char>(b[i]))) return false;
+    }
+    return true;
+}
+
+int findBody(const std::vector<std::string>& names, const std::string& name) {
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        if (equalsIgnoreCase(names[i], name)) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+/********************
+ * tangent
+ * @brief: Time derivative of body b's position at window[k]: the stored
+ *         velocity if present, otherwise a (central where possible)
+ *         finite difference of the neighbouring frames.
+ *********************/
+vec3 tangent(const std::deque<TrajectoryFrame>& window, std::size_t k, int b) {
+    if (!window[k].velocities.empty()) return window[k].velocities[b];
+
+    const std::size_t lo = (k > 0) ? k - 1 : k;
+    const std::size_t hi = (k + 1 < window.size()) ? k + 1 : k;
+    if (lo == hi) return vec3(0, 0, 0);
+    return (window[hi].positions[b] - window[lo].positions[b])
+           / (window[hi].t - window[lo].t);
+}
+
+/********************
+ * hermite
+ * @brief: Cubic Hermite interpolation of position and velocity between
+ *         frames a and b at time t.
+ *********************/
+void hermite(double ta, const vec3& pa, const vec3& ma,
+             double tb, const vec3& pb, const vec3& mb,
+             double t, vec3& pos, vec3& vel)
+{
+    const double h  = tb - ta;
+    const double s  = (t - ta) / h;
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+
+    const double h00 =  2 * s3 - 3 * s2 + 1;
+    const double h10 =      s3 - 2 * s2 + s;
+    const double h01 = -2 * s3 + 3 * s2;
+    const double h11 =      s3 -     s2;
+    pos = h00 * pa + (h10 * h) * ma + h01 * pb + (h11 * h) * mb;
+
+    const double d00 = (6 * s2 - 6 * s) / h;
+    const double d10 =  3 * s2 - 4 * s + 1;
+    const double d01 = (6 * s - 6 * s2) / h;
+    const double d11 =  3 * s2 - 2 * s;
+    vel = d00 * pa + d10 * ma + d01 * pb + d11 * mb;
+}
+
+/********************
+ * growthExponent
+ * @brief: Least-squares slope of log|err| against log t, i.e. k in
+ *         |err| ~ t^k (1 = linear drift, 2 = quadratic, ...).
+ * @return NaN when fewer than two usable samples exist
+ *********************/
+double growthExponent(const std::vector<ErrorSample>& samples, bool velocity) {
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    int n = 0;
+    for (const auto& e : samples) {
+        const double err = velocity ? e.dv.length() : e.dr.length();
+        if (e.t <= 0.0 || err <= 0.0) continue;
+        const double x = std::log(e.t), y = std::log(err);
+        sx += x; sy += y; sxx += x * x; sxy += x * y;
+        ++n;
+    }
+    const double den = n * sxx - sx * sx;
+    if (n < 2 || den <= 0.0) return std::nan("");
+    return (n * sxy - sx * sy) / den;
+}
+
+/// Formats without touching std::cout's stream state.
+std::string fmt(double v, int precision, std::ios_base::fmtflags style = std::ios_base::fmtflags{}) {
+    std::ostringstream ss;
+    ss.setf(style, std::ios_base::floatfield);
+    ss << std::setprecision(precision) << v;
+    return ss.str();
+}
+
+bool readFile(const std::string& path, std::string& text) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    text = ss.str();
+    return true;
+}
+
+} // namespace
+
+/********************
+ * compareTrajectory
+ * @brief: Streams the trajectory once and evaluates the error at every
+ *         reference epoch inside it.
+ * @param opts - comparison options
+ * @return true on success, false on failure
+ * @note: Reference events are sorted by time; a sliding window of at most
+ *        four frames (previous, interval start, interval end, next) is
+ *        kept, which is all the finite-difference tangents need.
+ *********************/
+bool compareTrajectory(const CompareOptions& opts)
+{
+    try {
+        // ----------------------------------------------
+        // Trajectory source
+        // ----------------------------------------------
+        std::unique_ptr<FrameSource> source;
+        std::string storedEpoch;
+        if (isTrajectoryBinary(opts.trajectoryPath)) {
+            auto bin = std::make_unique<BinaryFrameSource>(opts.trajectoryPath);
+            storedEpoch = bin->epoch();
+            source = std::move(bin);
+        } else {
+            if (opts.dt <= 0.0) {
+                std::cerr << "❌ CSV trajectories need --dt (the run's step size)\n";
+                return false;
+            }
+            source = std::make_unique<CSVFrameSource>(opts.trajectoryPath, opts.dt);
+            std::cout << "⚠️ CSV input: velocities come from finite differences; "
+                         "use run --trajectory for stored velocities.\n";
+        }
+        const auto& names = source->bodyNames();
+
+        // ----------------------------------------------
+        // References
+        // ----------------------------------------------
+        std::vector<HorizonsEphemeris> references;
+        std::vector<int> refBody;
+        for (const auto& entry : opts.referencePaths) {
+            std::string bodyName, path = entry;
+            const std::size_t eq = entry.find('=');
+            if (eq != std::string::npos && !std::ifstream(entry)) {
+                bodyName = entry.substr(0, eq);
+                path     = entry.substr(eq + 1);
+            }
+
+            std::string text;
+            if (!readFile(path, text)) {
+                std::cerr << "❌ Could not read reference: " << path << "\n";
+                return false;
+            }
+            HorizonsEphemeris eph = parseHorizonsVectors(extractHorizonsResult(text));
+            if (bodyName.empty()) bodyName = eph.targetName;
+
+            const int b = findBody(names, bodyName);
+            if (b < 0) {
+                std::cerr << "❌ Reference " << path << " (" << bodyName
+                          << ") matches no trajectory body; use Body=" << path << "\n";
+                return false;
+            }
+            references.push_back(std::move(eph));
+            refBody.push_back(b);
+        }
+        if (references.empty()) {
+            std::cerr << "❌ No reference ephemerides given\n";
+            return false;
+        }
+
+        // ----------------------------------------------
+        // Epoch of t = 0
+        // ----------------------------------------------
+        double epochJD = 0.0;
+        const std::string epochText = !opts.epoch.empty() ? opts.epoch : storedEpoch;
+        if (!epochText.empty()) {
+            if (!calendarToJD(epochText, epochJD)) {
+                std::cerr << "❌ Unrecognised epoch: " << epochText << "\n";
+                return false;
+            }
+        } else {
+            epochJD = references.front().states.front().jdTDB;
+            for (const auto& r : references) {
+                epochJD = std::min(epochJD, r.states.front().jdTDB);
+            }
+            std::cout << "⚠️ No epoch known for the trajectory; assuming t = 0 at the first "
+                         "reference epoch (JD " << fmt(epochJD, 4, std::ios_base::fixed) << ")\n";
+        }
+
+        std::vector<ReferenceEvent> events;
+        for (std::size_t r = 0; r < references.size(); ++r) {
+            const auto& states = references[r].states;
+            for (std::size_t s = 0; s < states.size(); ++s) {
+                events.push_back({(states[s].jdTDB - epochJD) * 86400.0,
+                                  refBody[r], static_cast<int>(r), static_cast<int>(s)});
+            }
+        }
+        std::stable_sort(events.begin(), events.end(),
+                         [](const ReferenceEvent& a, const ReferenceEvent& b) { return a.t < b.t; });
+
+        // ----------------------------------------------
+        // Stream frames and interpolate
+        // ----------------------------------------------
+        std::vector<std::vector<ErrorSample>> errors(references.size());
+        std::deque<TrajectoryFrame> window;
+        std::size_t start = 0;   // window index of the current interval start
+        std::size_t ev = 0;
+        long frames = 0, outside = 0;
+        bool eof = false;
+        double firstT = 0.0, lastT = 0.0;
+
+        auto fill = [&]() {
+            TrajectoryFrame f;
+            if (!source->next(f)) { eof = true; return; }
+            if (f.positions.size() != names.size()) { eof = true; return; }
+            if (frames++ == 0) firstT = f.t;
+            lastT = f.t;
+            window.push_back(std::move(f));
+        };
+
+        while (ev < events.size()) {
+            while (!eof && window.size() < start + 3) fill();
+            if (window.size() < start + 2) break;   // no interval left
+
+            const TrajectoryFrame& a = window[start];
+            const TrajectoryFrame& b = window[start + 1];
+
+            for (; ev < events.size() && events[ev].t <= b.t; ++ev) {
+                const ReferenceEvent& e = events[ev];
+                if (e.t < a.t) { ++outside; continue; }
+
+                vec3 pos, vel;
+                hermite(a.t, a.positions[e.body], tangent(window, start, e.body),
+                        b.t, b.positions[e.body], tangent(window, start + 1, e.body),
+                        e.t, pos, vel);
+
+                const HorizonsState& ref = references[e.ref].states[e.state];
+                errors[e.ref].push_back({ref.jdTDB, e.t, pos - ref.position, vel - ref.velocity});
+            }
+
+            // Slide: keep one frame before the next interval for its tangent
+            if (start == 0) start = 1;
+            else window.pop_front();
+        }
+        outside += static_cast<long>(events.size() - ev);
+
+        if (frames < 2) {
+            std::cerr << "❌ Trajectory has fewer than two frames: " << opts.trajectoryPath << "\n";
+            return false;
+        }
+
+        // ----------------------------------------------
+        // Report
+        // ----------------------------------------------
+        std::cout << "Compared " << (events.size() - outside) << " reference epochs against "
+                  << frames << " frames (t = " << firstT << " .. " << lastT << " s)\n";
+        if (outside > 0) {
+            std::cout << "⚠️ " << outside << " reference epochs lie outside the trajectory "
+                         "and were skipped\n";
+        }
+
+        std::ofstream csv;
+        if (!opts.outputPath.empty()) {
+            csv.open(opts.outputPath);
+            if (!csv) {
+                std::cerr << "❌ Could not open output file: " << opts.outputPath << "\n";
+                return false;
+            }
+            csv << "body,jd_tdb,t_s,dx,dy,dz,dr,dvx,dvy,dvz,dv\n" << std::setprecision(17);
+        }
+
+        for (std::size_t r = 0; r < references.size(); ++r) {
+            const auto& samples = errors[r];
+            const std::string& name = names[refBody[r]];
+
+            std::cout << "\n" << name << " vs " << references[r].targetName;
+            if (!references[r].centerName.empty()) {
+                std::cout << " (center: " << references[r].centerName << ")";
+            }
+            std::cout << "\n";
+            if (samples.empty()) {
+                std::cout << "  (no reference epochs inside the trajectory)\n";
+                continue;
+            }
+
+            std::cout << "  " << std::setw(12) << "t [days]"
+                      << std::setw(16) << "|dr| [km]"
+                      << std::setw(16) << "|dv| [m/s]" << "\n";
+
+            const std::size_t rows = std::max<std::size_t>(
+                1, std::min<std::size_t>(samples.size(), static_cast<std::size_t>(std::max(1, opts.tableRows))));
+            for (std::size_t k = 0; k < rows; ++k) {
+                const std::size_t i = (rows == 1) ? samples.size() - 1
+                                                  : k * (samples.size() - 1) / (rows - 1);
+                const auto& e = samples[i];
+                std::cout << "  " << std::setw(12) << fmt(e.t / 86400.0, 3, std::ios_base::fixed)
+                          << std::setw(16) << fmt(e.dr.length() / 1000.0, 4, std::ios_base::scientific)
+                          << std::setw(16) << fmt(e.dv.length(), 4, std::ios_base::scientific) << "\n";
+            }
+
+            double maxDr = 0, maxDv = 0, maxDrT = 0;
+            for (const auto& e : samples) {
+                if (e.dr.length() > maxDr) { maxDr = e.dr.length(); maxDrT = e.t; }
+                maxDv = std::max(maxDv, e.dv.length());
+            }
+            const double kr = growthExponent(samples, false);
+            const double kv = growthExponent(samples, true);
+
+            std::cout << "  max |dr| = " << maxDr / 1000.0 << " km at t = "
+                      << maxDrT / 86400.0 << " d, final |dr| = "
+                      << samples.back().dr.length() / 1000.0 << " km\n"
+                      << "  max |dv| = " << maxDv << " m/s, final |dv| = "
+                      << samples.back().dv.length() << " m/s\n";
+            if (!std::isnan(kr)) {
+                std::cout << "  growth: |dr| ~ t^" << fmt(kr, 3)
+                          << ", |dv| ~ t^" << fmt(kv, 3) << "\n";
+            }
+
+            if (csv) {
+                for (const auto& e : samples) {
+                    csv << name << "," << e.jd << "," << e.t << ","
+                        << e.dr.x() << "," << e.dr.y() << "," << e.dr.z() << "," << e.dr.length() << ","
+                        << e.dv.x() << "," << e.dv.y() << "," << e.dv.z() << "," << e.dv.length() << "\n";
+                }
+            }
+        }
+
+        if (csv) {
+            std::cout << "\n✅ Per-epoch errors written to " << opts.outputPath << "\n";
+        }
+        return true;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "❌ Comparison failed: " << e.what() << "\n";
+        return false;
+    }
+}
@@ -9,23 +9,28 @@
 
 /********************
  * validateSystemFile
- * @brief: Validate a JSON system file.
- * Loads the system using loadSystemFromJSON() and prints summary.
+ * @brief: Validate a system file (JSON or binary snapshot).
+ * Loads the system using loadSystem() and prints summary.
  *
- * @param path Path to JSON file
+ * @param path Path to JSON or snapshot file
  * @return true if valid, false if invalid
  *********************/
 bool validateSystemFile(const std::string& path)
 {
     try {
-        auto bodies = loadSystemFromJSON(path);
+        SystemMetadata meta;
+        auto bodies = loadSystem(path, &meta);
 
         if (bodies.empty()) {
             std::cout << "⚠️  System loaded but contains 0 bodies.\n";
             return false;
         }
 
-        std::cout << "✅ System is valid: " << bodies.size() << " bodies\n";
+        std::cout << "✅ System is valid: " << bodies.size() << " bodies"
+                  << (isSystemSnapshot(path) ? " (binary snapshot)" : "") << "\n";
+        if (!meta.epoch.empty()) {
+            std::cout << "   Epoch: " << meta.epoch << "\n";
+        }
 
         for (const auto& b : bodies) {
             std::cout   << " - " << b.name
@@ -0,0 +1,95 @@
+/*******************
+ * body_culler.cpp
+ * @brief Frustum culling and level-of-detail selection for the bodies
+ * @author Sinan Demir
+ * @date 10/16/2026
+ ******************/
+
+#include "viewer/body_culler.h"
+
+#include <cmath>
+
+void BodyCuller::cull(const std::vector<BodyInstance>& instances,
+                      const glm::mat4& viewProj,
+                      const glm::vec3& viewPos,
+                      float pixelAngle) {
+    const std::size_t n = instances.size();
+    x.resize(n);
+    y.resize(n);
+    z.resize(n);
+    r.resize(n);
+    codes.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = instances[i].center.x - viewPos.x;
+        y[i] = instances[i].center.y - viewPos.y;
+        z[i] = instances[i].center.z - viewPos.z;
+        r[i] = instances[i].radius;
+    }
+
+    // Clip-space planes (Gribb–Hartmann): w ± x, w ± y, w + z >= 0,
+    // normalized, moved to the camera so the test runs on the offsets above
+    float plane[5][4];
+    for (int p = 0; p < 5; ++p) {
+        const int   row  = p / 2;
+        const float sign = (p % 2 == 0) ? 1.0f : -1.0f;
+        float a[4];
+        for (int c = 0; c < 4; ++c) a[c] = viewProj[c][3] + sign * viewProj[c][row];
+        const float len = std::sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+        const float inv = len > 0.0f ? 1.0f / len : 0.0f;
+        for (int c = 0; c < 4; ++c) plane[p][c] = a[c] * inv;
+        plane[p][3] += plane[p][0] * viewPos.x + plane[p][1] * viewPos.y + plane[p][2] * viewPos.z;
+    }
+
+    // Level l when radius / distance >= LOD_MIN_PIXELS[l] * pixelAngle,
+    // compared squared: r^2 >= k_l * distance^2
+    static_assert(LOD_LEVELS == 4, "the test below is unrolled for 4 levels");
+    float k[LOD_LEVELS];
+    for (int l = 0; l < LOD_LEVELS; ++l) {
+        const float a = LOD_MIN_PIXELS[l] * pixelAngle;
+        k[l] = a * a;
+    }
+    const float k1 = k[1], k2 = k[2], k3 = k[3];
+
+    // Planes and thresholds as scalars, loops unrolled: the compiler
+    // only vectorizes the body loop without inner loops
+    const float l0 = plane[0][0], l1 = plane[0][1], l2 = plane[0][2], l3 = plane[0][3];
+    const float r0 = plane[1][0], r1 = plane[1][1], r2 = plane[1][2], r3 = plane[1][3];
+    const float b0 = plane[2][0], b1 = plane[2][1], b2 = plane[2][2], b3 = plane[2][3];
+    const float t0 = plane[3][0], t1 = plane[3][1], t2 = plane[3][2], t3 = plane[3][3];
+    const float n0 = plane[4][0], n1 = plane[4][1], n2 = plane[4][2], n3 = plane[4][3];
+
+    const float* __restrict px = x.data();
+    const float* __restrict py = y.data();
+    const float* __restrict pz = z.data();
+    const float* __restrict pr = r.data();
+    std::int8_t* __restrict out = codes.data();
+
+#pragma omp simd
+    for (std::size_t i = 0; i < n; ++i) {
+        const float X = px[i], Y = py[i], Z = pz[i], R = pr[i];
+
+        // Sphere at least partly on the inner side of every plane
+        const int inside = (l0 * X + l1 * Y + l2 * Z + l3 >= -R)
+                         & (r0 * X + r1 * Y + r2 * Z + r3 >= -R)
+                         & (b0 * X + b1 * Y + b2 * Z + b3 >= -R)
+                         & (t0 * X + t1 * Y + t2 * Z + t3 >= -R)
+                         & (n0 * X + n1 * Y + n2 * Z + n3 >= -R);
+
+        const float dist2 = X * X + Y * Y + Z * Z;
+        const float rr    = R * R;
+        const int   level = (rr >= k1 * dist2) + (rr >= k2 * dist2) + (rr >= k3 * dist2);
+
+        out[i] = static_cast<std::int8_t>(inside ? level : -1);
+    }
+
+    for (auto& list : levels) list.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (codes[i] >= 0) levels[codes[i]].push_back(static_cast<std::uint32_t>(i));
+    }
+}
+
+std::size_t BodyCuller::visible() const {
+    std::size_t count = 0;
+    for (const auto& list : levels) count += list.size();
+    return count;
+}
@@ -0,0 +1,340 @@
+/*******************
+ * body_renderer.cpp
+ * @brief Instanced sphere renderer implementation for the orbit viewer
+ * @author Sinan Demir
+ * @date 10/16/2026
+ ******************/
+
+#include "viewer/body_renderer.h"
+#include "viewer/shader_utils.h"
+
+#include <cstddef>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace {
+
+// Unit sphere scaled and offset per instance; Option C lighting
+// (ambient-boosted Lambert + Blinn-Phong + rim), same look as before.
+const char* BODY_VS = R"GLSL(
+    #version 330 core
+    layout(location = 0) in vec3 aPos;
+    layout(location = 1) in vec3 aNormal;
+
+    // Per-instance, center relative to the camera target
+    layout(location = 2) in vec3  iCenter;
+    layout(location = 3) in float iRadius;
+    layout(location = 4) in vec3  iColor;
+    layout(location = 5) in uint  iBody;
+
+    uniform mat4  uViewProj;
+    uniform float uLogDepthC;
+
+    // Trajectory mode: centers come from the buffer texture, frame-major,
+    // (position high, position low, velocity) texels per body (iBody:
+    // culling reorders the instances)
+    uniform bool          uFromTrajectory;
+    uniform samplerBuffer uTrajectory;
+    uniform int           uFrame;       // first frame of the interval
+    uniform int           uNextFrame;   // second frame (== uFrame at the end)
+    uniform int           uBodies;
+    uniform float         uFraction;    // position in the interval, 0..1
+    uniform float         uSpan;        // interval length (s)
+    uniform vec3          uOriginHigh;  // camera target, high/low floats
+    uniform vec3          uOriginLow;
+
+    // Position stored at `texel`, relative to the camera target: the
+    // high and low halves are subtracted separately, so nothing large
+    // is rounded
+    vec3 relativePosition(int texel) {
+        return (texelFetch(uTrajectory, texel).xyz     - uOriginHigh)
+             + (texelFetch(uTrajectory, texel + 1).xyz - uOriginLow);
+    }
+
+    vec3 trajectoryCenter() {
+        int i0 = 3 * (uFrame     * uBodies + int(iBody));
+        int i1 = 3 * (uNextFrame * uBodies + int(iBody));
+        vec3 p0 = relativePosition(i0);
+        vec3 v0 = texelFetch(uTrajectory, i0 + 2).xyz;
+        vec3 p1 = relativePosition(i1);
+        vec3 v1 = texelFetch(uTrajectory, i1 + 2).xyz;
+
+        // Cubic Hermite basis
+        float s  = uFraction;
+        float s2 = s * s;
+        float s3 = s2 * s;
+        return ( 2.0 * s3 - 3.0 * s2 + 1.0) * p0
+             + (       s3 - 2.0 * s2 + s) * uSpan * v0
+             + (-2.0 * s3 + 3.0 * s2)       * p1
+             + (       s3 -       s2)       * uSpan * v1;
+    }
+
+    out vec3  vNormal;
+    out vec3  vWorldPos;
+    out vec3  vColor;
+    out float vLogDepth;
+
+    void main() {
+        // Translation + uniform scale: the normal is unchanged
+        vec3 center = uFromTrajectory ? trajectoryCenter() : iCenter;
+
+        vNormal   = aNormal;
+        vWorldPos = center + iRadius * aPos;
+        vColor    = iColor;
+        gl_Position = uViewProj * vec4(vWorldPos, 1.0);
+        vLogDepth   = 1.0 + uLogDepthC * gl_Position.w;
+    }
+)GLSL";
+
+const char* BODY_FS = R"GLSL(
+    #version 330 core
+
+    in vec3  vNormal;
+    in vec3  vWorldPos;
+    in vec3  vColor;
+    in float vLogDepth;
+
+    out vec4 FragColor;
+
+    uniform vec3  uLightPos;
+    uniform vec3  uViewPos;
+    uniform float uLogDepthScale;
+
+    void main() {
+        gl_FragDepth = log2(max(vLogDepth, 1.0)) * uLogDepthScale;
+
+        vec3 N = normalize(vNormal);
+        vec3 L = normalize(uLightPos - vWorldPos);
+        vec3 V = normalize(uViewPos - vWorldPos);
+        vec3 H = normalize(L + V);
+
+        // Lambert + Blinn–Phong
+        float diff = max(dot(N, L), 0.0);
+        float spec = pow(max(dot(N, H), 0.0), 32.0);
+        float ambient = 0.18;
+
+        vec3 base = vColor * (ambient + diff)
+                  + vec3(0.4) * spec;
+
+        // Rim light for cinematic look
+        float rim = pow(1.0 - max(dot(N, V), 0.0), 2.0);
+        vec3 rimColor = vec3(0.3, 0.4, 0.9) * rim * 0.5;
+
+        vec3 color = base + rimColor;
+
+        // Gamma
+        color = pow(color, vec3(1.0 / 2.2));
+
+        FragColor = vec4(color, 1.0);
+    }
+)GLSL";
+
+constexpr std::size_t INITIAL_CAPACITY = 64;
+
+// (segments, rings) of the sphere at each level of detail: from about
+// a hundred triangles for bodies a few pixels across to 6k for close-ups
+constexpr int LOD_TESSELLATION[BodyCuller::LOD_LEVELS][2] = {
+    {8, 6}, {16, 12}, {32, 24}, {64, 48}
+};
+
+} // namespace
+
+BodyRenderer::~BodyRenderer() {
+    if (instanceVBO) glDeleteBuffers(1, &instanceVBO);
+    if (program)     glDeleteProgram(program);
+}
+
+bool BodyRenderer::init() {
+    program = createProgram(BODY_VS, BODY_FS);
+    if (!program) return false;
+
+    locViewProj      = glGetUniformLocation(program, "uViewProj");
+    locLight         = glGetUniformLocation(program, "uLightPos");
+    locViewPos       = glGetUniformLocation(program, "uViewPos");
+    locLogDepthC     = glGetUniformLocation(program, "uLogDepthC");
+    locLogDepthScale = glGetUniformLocation(program, "uLogDepthScale");
+    locFromTraj      = glGetUniformLocation(program, "uFromTrajectory");
+    locTraj          = glGetUniformLocation(program, "uTrajectory");
+    locFrame         = glGetUniformLocation(program, "uFrame");
+    locNext          = glGetUniformLocation(program, "uNextFrame");
+    locFraction      = glGetUniformLocation(program, "uFraction");
+    locSpan          = glGetUniformLocation(program, "uSpan");
+    locBodies        = glGetUniformLocation(program, "uBodies");
+    locOriginHigh    = glGetUniformLocation(program, "uOriginHigh");
+    locOriginLow     = glGetUniformLocation(program, "uOriginLow");
+
+    // Trajectory sampler always reads texture unit 0
+    glUseProgram(program);
+    glUniform1i(locTraj, 0);
+    glUseProgram(0);
+
+    for (int l = 0; l < BodyCuller::LOD_LEVELS; ++l) {
+        meshes[l].build(1.0f, LOD_TESSELLATION[l][0], LOD_TESSELLATION[l][1]);
+    }
+
+    // Instance attributes live in each mesh VAO next to position/normal;
+    // their offsets are set per draw (drawLevels)
+    glGenBuffers(1, &instanceVBO);
+    for (const SphereMesh& mesh : meshes) {
+        glBindVertexArray(mesh.vertexArray());
+        for (GLuint loc = 2; loc <= 5; ++loc) {
+            glEnableVertexAttribArray(loc);
+            glVertexAttribDivisor(loc, 1);
+        }
+    }
+    glBindVertexArray(0);
+
+    reserve(INITIAL_CAPACITY);
+    return true;
+}
+
+/**
+ * @brief Grows the instance buffer to at least `instances` slots
+ *        (doubling, so a growing system reallocates O(log N) times).
+ */
+void BodyRenderer::reserve(std::size_t instances) {
+    if (instances <= capacity) return;
+
+    std::size_t cap = capacity ? capacity : INITIAL_CAPACITY;
+    while (cap < instances) cap *= 2;
+    capacity = cap;
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(GpuInstance), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/**
+ * @brief Replaces the instance buffer contents with the visible sized
+ *        instances (culler's last result), level by level.
+ */
+void BodyRenderer::upload() {
+    staging.clear();
+    for (int l = 0; l < BodyCuller::LOD_LEVELS; ++l) {
+        for (std::uint32_t i : culler.level(l)) {
+            const BodyInstance& b = sized[i];
+            staging.push_back({b.center, b.radius, b.color, i});
+        }
+    }
+    if (staging.empty()) return;
+
+    reserve(staging.size());
+
+    // Orphan last frame's storage so the upload never waits on the GPU
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(GpuInstance), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, staging.size() * sizeof(GpuInstance), staging.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/**
+ * @brief One instanced draw per non-empty level, its instance attributes
+ *        pointed at the level's range of the buffer.
+ */
+void BodyRenderer::drawLevels() {
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+
+    std::size_t first = 0;
+    for (int l = 0; l < BodyCuller::LOD_LEVELS; ++l) {
+        const std::size_t count = culler.level(l).size();
+        if (count == 0) continue;
+
+        glBindVertexArray(meshes[l].vertexArray());
+        const GLsizei stride = sizeof(GpuInstance);
+        const std::size_t base = first * sizeof(GpuInstance);
+        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(base + offsetof(GpuInstance, center)));
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(base + offsetof(GpuInstance, radius)));
+        glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(base + offsetof(GpuInstance, color)));
+        glVertexAttribIPointer(5, 1, GL_UNSIGNED_INT, stride,
+                               (void*)(base + offsetof(GpuInstance, body)));
+
+        meshes[l].drawInstanced(static_cast<GLsizei>(count));
+        first += count;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void BodyRenderer::setCommonUniforms(const glm::mat4& viewProj,
+                                     const glm::vec3& lightPos,
+                                     const glm::vec3& viewPos) {
+    glUseProgram(program);
+    glUniformMatrix4fv(locViewProj, 1, GL_FALSE, glm::value_ptr(viewProj));
+    glUniform3fv(locLight,   1, glm::value_ptr(lightPos));
+    glUniform3fv(locViewPos, 1, glm::value_ptr(viewPos));
+    glUniform1f(locLogDepthC,     LOG_DEPTH_C);
+    glUniform1f(locLogDepthScale, logDepthScale());
+}
+
+/**
+ * @brief Sizes `instances` to their drawn radius, culls them and uploads
+ *        the visible ones.
+ * @return false if nothing is visible
+ */
+bool BodyRenderer::cullAndUpload(const std::vector<BodyInstance>& instances,
+                                 const glm::mat4& viewProj,
+                                 const glm::vec3& viewPos,
+                                 float pixelAngle) {
+    // At true scale most bodies are far below a pixel: cull and pick the
+    // LOD at the radius they are drawn with
+    sized.resize(instances.size());
+    for (std::size_t i = 0; i < instances.size(); ++i) {
+        sized[i] = instances[i];
+        sized[i].radius = drawRadius(instances[i].radius,
+                                     glm::length(instances[i].center - viewPos),
+                                     pixelAngle);
+    }
+
+    culler.cull(sized, viewProj, viewPos, pixelAngle);
+    upload();
+    return !staging.empty();
+}
+
+void BodyRenderer::draw(const std::vector<BodyInstance>& instances,
+                        const glm::mat4& viewProj,
+                        const glm::vec3& lightPos,
+                        const glm::vec3& viewPos,
+                        float pixelAngle) {
+    if (!program) return;
+    if (!cullAndUpload(instances, viewProj, viewPos, pixelAngle)) return;
+
+    setCommonUniforms(viewProj, lightPos, viewPos);
+    glUniform1i(locFromTraj, GL_FALSE);
+    drawLevels();
+}
+
+void BodyRenderer::drawTrajectory(TrajectoryBuffer& traj,
+                                  std::size_t frame,
+                                  float s,
+                                  float span,
+                                  const glm::dvec3& origin,
+                                  const std::vector<BodyInstance>& instances,
+                                  const glm::mat4& viewProj,
+                                  const glm::vec3& lightPos,
+                                  const glm::vec3& viewPos,
+                                  float pixelAngle) {
+    if (!program || traj.bodies() == 0) return;
+    if (!cullAndUpload(instances, viewProj, viewPos, pixelAngle)) return;
+
+    const GLint local = traj.select(frame);
+    const bool  last  = frame + 1 >= traj.frames();
+
+    // Camera target as a high/low float pair, like the stored positions
+    const glm::vec3 originHigh(origin);
+    const glm::vec3 originLow(origin - glm::dvec3(originHigh));
+
+    setCommonUniforms(viewProj, lightPos, viewPos);
+    glUniform1i(locFromTraj, GL_TRUE);
+    glUniform1i(locFrame, local);
+    glUniform1i(locNext, last ? local : local + 1);
+    glUniform1f(locFraction, last ? 0.0f : s);
+    glUniform1f(locSpan, span);
+    glUniform1i(locBodies, static_cast<GLint>(traj.bodies()));
+    glUniform3fv(locOriginHigh, 1, glm::value_ptr(originHigh));
+    glUniform3fv(locOriginLow,  1, glm::value_ptr(originLow));
+    traj.bind(0);
+
+    drawLevels();
+}
@@ -0,0 +1,293 @@
+/*******************
+ * frame_writer.cpp
+ * @brief Image sequence output for headless orbit-viewer runs
+ * @author Sinan Demir
+ * @date 10/16/2026
+ ******************/
+
+#include "viewer/frame_writer.h"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace {
+
+// --------------------------------------------------
+// Deflate (RFC 1951): greedy LZ77 + fixed Huffman codes
+// --------------------------------------------------
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<std::uint8_t>& out) : out(out) {}
+
+    /// Appends the low `n` bits of `value`, least significant first.
+    void bits(std::uint32_t value, int n) {
+        acc   |= static_cast<std::uint64_t>(value) << count;
+        count += n;
+        while (count >= 8) {
+            out.push_back(static_cast<std::uint8_t>(acc));
+            acc  >>= 8;
+            count -= 8;
+        }
+    }
+
+    /// Appends a Huffman code (defined most significant bit first).
+    void code(std::uint32_t value, int n) {
+        std::uint32_t reversed = 0;
+        for (int i = 0; i < n; ++i) reversed |= ((value >> i) & 1u) << (n - 1 - i);
+        bits(reversed, n);
+    }
+
+    void flush() {
+        if (count > 0) out.push_back(static_cast<std::uint8_t>(acc));
+        acc   = 0;
+        count = 0;
+    }
+
+private:
+    std::vector<std::uint8_t>& out;
+    std::uint64_t acc   = 0;
+    int           count = 0;
+};
+
+constexpr std::array<std::uint16_t, 29> LENGTH_BASE = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr std::array<std::uint8_t, 29> LENGTH_EXTRA = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr std::array<std::uint16_t, 30> DIST_BASE = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr std::array<std::uint8_t, 30> DIST_EXTRA = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+/// Fixed literal/length code of symbol 0..287.
+void writeSymbol(BitWriter& bw, unsigned sym) {
+    if (sym < 144)      bw.code(0x30 + sym, 8);
+    else if (sym < 256) bw.code(0x190 + (sym - 144), 9);
+    else if (sym < 280) bw.code(sym - 256, 7);
+    else                bw.code(0xC0 + (sym - 280), 8);
+}
+
+void writeMatch(BitWriter& bw, unsigned length, unsigned distance) {
+    unsigned li = 0;
+    while (li + 1 < LENGTH_BASE.size() && LENGTH_BASE[li + 1] <= length) ++li;
+    writeSymbol(bw, 257 + li);
+    bw.bits(length - LENGTH_BASE[li], LENGTH_EXTRA[li]);
+
+    unsigned di = 0;
+    while (di + 1 < DIST_BASE.size() && DIST_BASE[di + 1] <= distance) ++di;
+    bw.code(di, 5);
+    bw.bits(distance - DIST_BASE[di], DIST_EXTRA[di]);
+}
+
+/**
+ * @brief zlib stream (RFC 1950) of `data`: one fixed-Huffman block.
+ */
+std::vector<std::uint8_t> zlibCompress(const std::vector<std::uint8_t>& data) {
+    constexpr std::size_t WINDOW    = 32768;
+    constexpr std::size_t MAX_MATCH = 258;
+    constexpr int         HASH_BITS = 15;
+
+    std::vector<std::uint8_t> out = {0x78, 0x01};
+    out.reserve(data.size() / 8 + 64);
+    BitWriter bw(out);
+    bw.bits(1, 1);   // BFINAL
+    bw.bits(1, 2);   // BTYPE = fixed Huffman
+
+    std::vector<std::int64_t> last(std::size_t(1) << HASH_BITS, -1);
+    auto hash3 = [&](std::size_t i) {
+        const std::uint32_t v = data[i] | (data[i + 1] << 8) | (data[i + 2] << 16);
+        return (v * 2654435761u) >> (32 - HASH_BITS);
+    };
+
+    const std::size_t n = data.size();
+    std::size_t i = 0;
+    while (i < n) {
+        std::size_t bestLen = 0, bestDist = 0;
+        if (i + 3 <= n) {
+            const std::uint32_t hsh = hash3(i);
+            const std::int64_t cand = last[hsh];
+            last[hsh] = static_cast<std::int64_t>(i);
+            if (cand >= 0 && i - static_cast<std::size_t>(cand) <= WINDOW) {
+                const std::size_t c = static_cast<std::size_t>(cand);
+                const std::size_t limit = std::min(MAX_MATCH, n - i);
+                std::size_t len = 0;
+                while (len < limit && data[c + len] == data[i + len]) ++len;
+                if (len >= 3) {
+                    bestLen  = len;
+                    bestDist = i - c;
+                }
+            }
+        }
+
+        if (bestLen) {
+            writeMatch(bw, static_cast<unsigned>(bestLen), static_cast<unsigned>(bestDist));
+            // Index the skipped positions (sparsely) so later rows find them
+            for (std::size_t k = i + 1; k < i + bestLen && k + 3 <= n; k += 4) {
+                last[hash3(k)] = static_cast<std::int64_t>(k);
+            }
+            i += bestLen;
+        } else {
+            writeSymbol(bw, data[i]);
+            ++i;
+        }
+    }
+    writeSymbol(bw, 256);   // end of block
+    bw.flush();
+
+    // Adler-32, big-endian
+    std::uint32_t a = 1, b = 0;
+    for (std::size_t k = 0; k < n; ) {
+        const std::size_t end = std::min(n, k + 5552);
+        for (; k < end; ++k) {
+            a += data[k];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    const std::uint32_t adler = (b << 16) | a;
+    for (int s = 24; s >= 0; s -= 8) out.push_back(static_cast<std::uint8_t>(adler >> s));
+    return out;
+}
+
+// --------------------------------------------------
+// PNG chunks
+// --------------------------------------------------
+
+std::uint32_t crc32(const std::uint8_t* p, std::size_t n, std::uint32_t crc = 0) {
+    static const std::array<std::uint32_t, 256> table = [] {
+        std::array<std::uint32_t, 256> t{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (std::size_t i = 0; i < n; ++i) crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+void put32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    for (int s = 24; s >= 0; s -= 8) out.push_back(static_cast<std::uint8_t>(v >> s));
+}
+
+void chunk(std::vector<std::uint8_t>& out, const char* type, const std::vector<std::uint8_t>& data) {
+    put32(out, static_cast<std::uint32_t>(data.size()));
+    const std::size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    put32(out, crc32(out.data() + start, out.size() - start));
+}
+
+} // namespace
+
+std::vector<std::uint8_t> encodePNG(int width, int height, const std::uint8_t* rgb) {
+    // Scanlines with the Sub filter (byte minus the pixel to its left),
+    // which turns flat regions into zero runs
+    const std::size_t stride = static_cast<std::size_t>(width) * 3;
+    std::vector<std::uint8_t> raw;
+    raw.reserve((stride + 1) * height);
+    for (int y = 0; y < height; ++y) {
+        const std::uint8_t* row = rgb + y * stride;
+        raw.push_back(1);
+        for (std::size_t x = 0; x < stride; ++x) {
+            raw.push_back(static_cast<std::uint8_t>(row[x] - (x >= 3 ? row[x - 3] : 0)));
+        }
+    }
+
+    std::vector<std::uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+    std::vector<std::uint8_t> ihdr;
+    put32(ihdr, static_cast<std::uint32_t>(width));
+    put32(ihdr, static_cast<std::uint32_t>(height));
+    ihdr.insert(ihdr.end(), {8, 2, 0, 0, 0});   // 8-bit RGB, no interlace
+    chunk(png, "IHDR", ihdr);
+    chunk(png, "IDAT", zlibCompress(raw));
+    chunk(png, "IEND", {});
+    return png;
+}
+
+// --------------------------------------------------
+// FrameWriter
+// --------------------------------------------------
+
+FrameWriter::FrameWriter(const std::string& target, int width, int height, unsigned threads)
+    : w(width), h(height), pool(target == "-" ? 1 : threads) {
+    maxPending = 2 * pool.size();
+    if (target == "-") {
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    } else {
+        directory = target;
+        std::filesystem::create_directories(directory);
+    }
+}
+
+FrameWriter::~FrameWriter() {
+    finish();
+}
+
+/**
+ * @brief Waits for queued frames, oldest first, until at most `keep`
+ *        remain in flight.
+ */
+bool FrameWriter::collect(std::size_t keep) {
+    while (pending.size() > keep) {
+        if (!pending.front().get()) ok = false;
+        pending.pop_front();
+    }
+    return ok;
+}
+
+bool FrameWriter::write(std::vector<std::uint8_t>&& rgb) {
+    if (!ok) return false;
+    const std::size_t index = written++;
+
+    if (directory.empty()) {
+        // Raw frames must stay in order: one writer task at a time
+        collect(0);
+        auto frame = std::make_shared<std::vector<std::uint8_t>>(std::move(rgb));
+        pending.push_back(pool.submit([frame] {
+            return std::fwrite(frame->data(), 1, frame->size(), stdout) == frame->size();
+        }));
+        return ok;
+    }
+
+    collect(maxPending - 1);
+
+    std::ostringstream name;
+    name << "frame_" << std::setw(6) << std::setfill('0') << index << ".png";
+    const std::string path = (std::filesystem::path(directory) / name.str()).string();
+
+    auto frame = std::make_shared<std::vector<std::uint8_t>>(std::move(rgb));
+    const int fw = w, fh = h;
+    pending.push_back(pool.submit([frame, path, fw, fh] {
+        const std::vector<std::uint8_t> png = encodePNG(fw, fh, frame->data());
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+        return static_cast<bool>(out);
+    }));
+    return ok;
+}
+
+bool FrameWriter::finish() {
+    collect(0);
+    if (directory.empty()) std::fflush(stdout);
+    return ok;
+}
@@ -0,0 +1,103 @@
+/*******************
+ * live_simulation.cpp
+ * @brief In-process simulation feeding the orbit viewer
+ * @author Sinan Demir
+ * @date 10/16/2026
+ ******************/
+
+#include "viewer/live_simulation.h"
+#include "simulation.h"
+
+#include <chrono>
+
+namespace {
+
+// The producer publishes at least this often while it is behind
+constexpr std::chrono::milliseconds PUBLISH_EVERY(8);
+
+void capture(const std::vector<CelestialBody>& bodies, double t, TrajectoryFrame& frame) {
+    frame.t = t;
+    frame.positions.resize(bodies.size());
+    frame.velocities.resize(bodies.size());
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        frame.positions[i]  = bodies[i].position;
+        frame.velocities[i] = bodies[i].velocity;
+    }
+}
+
+} // namespace
+
+LiveSimulation::LiveSimulation(std::vector<CelestialBody> initial, double dt)
+    : bodies(std::move(initial)), step(dt) {
+    names.reserve(bodies.size());
+    for (const auto& b : bodies) names.push_back(b.name);
+
+    capture(bodies, 0.0, current);
+    previous = current;
+    publish();
+
+    producer = std::thread(&LiveSimulation::run, this);
+}
+
+LiveSimulation::~LiveSimulation() {
+    {
+        std::lock_guard<std::mutex> lk(idleMtx);
+        stopping.store(true);
+    }
+    idleCv.notify_all();
+    if (producer.joinable()) producer.join();
+}
+
+void LiveSimulation::advanceTo(double t) {
+    if (t <= horizon.load(std::memory_order_relaxed)) return;
+    horizon.store(t, std::memory_order_release);
+    idleCv.notify_one();
+}
+
+const LiveState* LiveSimulation::latest() {
+    if (!(middle.load(std::memory_order_acquire) & FRESH)) return nullptr;
+    front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+    return &slots[front];
+}
+
+/**
+ * @brief Copies the last two steps into the back slot and swaps it in
+ *        as the newest state (producer thread only).
+ */
+void LiveSimulation::publish() {
+    LiveState& slot = slots[back];
+    slot.a     = previous;
+    slot.b     = current;
+    slot.steps = steps;
+    back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+}
+
+/**
+ * @brief Producer: integrates up to the horizon, publishing as it goes,
+ *        then waits for the viewer to move the horizon.
+ */
+void LiveSimulation::run() {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point lastPublish = Clock::now();
+
+    while (!stopping.load()) {
+        if (current.t >= horizon.load(std::memory_order_acquire)) {
+            std::unique_lock<std::mutex> lk(idleMtx);
+            idleCv.wait_for(lk, std::chrono::milliseconds(10), [&] {
+                return stopping.load() || current.t < horizon.load(std::memory_order_acquire);
+            });
+            continue;
+        }
+
+        rk4Step(bodies, step);
+        ++steps;
+        std::swap(previous, current);
+        capture(bodies, static_cast<double>(steps) * step, current);
+
+        const Clock::time_point now = Clock::now();
+        if (current.t >= horizon.load(std::memory_order_acquire) || now - lastPublish >= PUBLISH_EVERY) {
+            publish();
+            lastPublish = now;
+        }
+    }
+}
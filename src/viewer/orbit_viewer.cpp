@@ -6,26 +6,55 @@
  *
  * Notes:
  *  - Uses option C lighting (ambient-boosted Lambert + rim)
+ *  - Bodies are frustum-culled on the CPU and drawn with one instanced
+ *    call per sphere level of detail, picked by size on screen (see
+ *    BodyRenderer, BodyCuller)
+ *  - A loaded trajectory is uploaded once into a buffer texture
+ *    (TrajectoryBuffer) as high/low float pairs; the shader fetches the
+ *    visible bodies' states by index and interpolates them
+ *  - Camera-relative rendering: states stay in double on the CPU and
+ *    the camera target is subtracted before anything becomes float;
+ *    depth is logarithmic (see LOG_DEPTH_C), so one depth buffer covers
+ *    meters to the outer planets
+ *  - Playback follows a wall clock (PlaybackClock) at --speed simulated
+ *    seconds per second; bodies are Hermite-interpolated between stored
+ *    frames from positions and velocities (finite differences for CSV,
+ *    frame times (step + 1) * --dt)
+ *  - CSV path from argv[1] (default ./build/orbit_three_body.csv)
+ *  - --stream (or a .otraj / very large file) plays the trajectory
+ *    out of core through a bounded read-ahead buffer (TrajectoryStream)
+ *  - --live --system FILE integrates the system in a producer thread
+ *    and shows its latest state as it is computed (LiveSimulation)
+ *  - Left / Right = seek -/+ 5%, Home = restart
+ *  - + / - = double / halve speed, Space = pause
+ *  - Orbit trails (TrailRenderer): fixed ring of LOD-decimated points per
+ *    body, --trail N points (0 = off), T = show / hide
  *  - Dynamically renders ALL bodies found in orbit_three_body.csv
  *  - HUD legend (Sun / Earth / Moon) in top-left
  *  - Click legend squares to change camera center (Sun / Earth / Moon)
  *  - Scroll = zoom, RMB drag = orbit
  *  - Keyboard 1–0 = recenter camera on Sun..Neptune
+ *  - --headless OUT renders the same scene without a window or GPU
+ *    (SoftwareRenderer) at --size / --fps and writes raw RGB24 frames
+ *    to stdout ('-') or a PNG sequence into OUT (FrameWriter)
  *  - Distances:
- *      meters → GL via 1 GL = 5e9 m, then uniformly scaled to 2%
- *      (so outer planets are visible in one view)
+ *      meters → GL via 1 GL = 5e9 m, true scale
  *  - Radii:
- *      physically scaled (no extra radius exaggeration)
- *  - Moon:
- *      orbit exaggerated 15× around Earth for visibility
+ *      physically scaled, drawn at least MIN_BODY_PIXELS across so
+ *      distant bodies stay visible
  *************************/
 
 #include <iostream>
 #include <vector>
 #include <string>
-#include <fstream>
-#include <sstream>
 #include <unordered_map>
+#include <optional>
+#include <filesystem>
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <stdexcept>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -34,7 +63,17 @@
 #include <glm/gtc/matrix_transform.hpp> // includes glm::infinitePerspective
 #include <glm/gtc/type_ptr.hpp>
 
-#include "viewer/sphere_mesh.h"
+#include "viewer/body_renderer.h"
+#include "viewer/frame_writer.h"
+#include "viewer/playback_clock.h"
+#include "viewer/trail_renderer.h"
+#include "viewer/live_simulation.h"
+#include "system_snapshot.h"
+#include "viewer/shader_utils.h"
+#include "viewer/software_renderer.h"
+#include "viewer/trajectory_stream.h"
+#include "trajectory_binary.h"
+#include "trajectory_csv.h"
 
 // ---------------------------
 // Global Viewer State
@@ -45,7 +84,7 @@ static int   g_windowHeight = 720;
 // Orbit camera spherical coords
 static float g_yaw    = glm::radians(45.0f);
 static float g_pitch  = glm::radians(20.0f);
-static float g_radius = 250.0f;   // distance from target (in GL units)
+static float g_radius = 12500.0f;   // distance from target (in GL units)
 
 static bool   g_mouseRotating = false;
 static double g_lastMouseX = 0.0;
@@ -68,6 +107,8 @@ enum class CameraTarget {
 
 static CameraTarget g_cameraTarget = CameraTarget::Barycenter;
 
+static constexpr int CAMERA_TARGET_COUNT = 11;
+
 // Legend rendering objects (2D)
 static GLuint g_legendShader = 0;
 static GLuint g_legendVAO    = 0;
@@ -89,20 +130,67 @@ static const float LEGEND_SIZE_PX  = 14.0f;  // base square size
 struct BodyRenderInfo {
     std::string name;
     glm::vec3   color;
-    float       radius;               // visual radius in GL units
-    std::vector<glm::vec3> positions; // per-frame positions in GL units
-    SphereMesh  mesh;
+    float       radius;               // physical radius in GL units
 };
 
 static std::vector<BodyRenderInfo>              g_bodies;
+// States in GL units, frame-major, (position, velocity) per body:
+// [2 * (frame * g_bodies.size() + body)] (+1 for the velocity, GL units/s)
+// (double: float loses meters at planetary distances)
+static std::vector<glm::dvec3>                  g_states;
+static std::vector<double>                      g_times;      // s, per frame
 static std::unordered_map<std::string, size_t> g_bodyIndex;
 static size_t                                   g_numFrames  = 0;
-static size_t                                   g_frameIndex = 0;
+static size_t                                   g_frameIndex = 0;   // interval start
+
+// Frame interval being drawn (into g_states, or the streamed frames):
+// states at its start and end, span (s) and playback fraction in [0, 1].
+// g_stateA is nullptr until the first frame is available.
+static const glm::dvec3*                        g_stateA   = nullptr;
+static const glm::dvec3*                        g_stateB   = nullptr;
+static double                                   g_span     = 0.0;
+static double                                   g_fraction = 0.0;
+
+static PlaybackClock                            g_clock;
+
+static bool g_showTrails = true;
+
+// Seek requests from the keyboard, applied by the render loop
+static int  g_seekSteps = 0;      // in units of 5% of the trajectory
+static bool g_seekHome  = false;
+
+// --dt: step size of CSV trajectories (frame times) and of --live
+// integration; and frames played per second by default
+static double             g_dt = 3600.0;
+static constexpr double   DEFAULT_FRAMES_PER_SECOND = 60.0;
+
+// Files above this size are streamed instead of loaded whole
+static constexpr std::uintmax_t STREAM_AUTO_BYTES = 512ull << 20;
+
+// Live simulation or streamed trajectory (neither: the whole trajectory
+// is in g_states)
+static std::unique_ptr<LiveSimulation>   g_live;
+static std::unique_ptr<TrajectoryStream> g_stream;
+
+// Streamed / live frame interval: SI as read, then GL states
+static TrajectoryFrame         g_frameA, g_frameB;
+static std::vector<glm::dvec3> g_streamA, g_streamB;
+static bool                   g_streamSync  = true;   // playback jumps to the next frame read
+static double                 g_streamShown = 0.0;    // playback time last drawn
+
+// Headless rendering (--headless): output and frame format
+struct HeadlessOptions {
+    std::string output;          ///< "-" = raw RGB24 on stdout, else a PNG directory
+    int         width  = 1280;
+    int         height = 720;
+    double      fps    = 30.0;
+    long        frames = 0;      ///< 0 = one pass of the trajectory
+};
 
 // Forward declarations
-static void      handleLegendClick(double mouseX, double mouseY);
-static glm::vec3 getBodyPos(const std::string& name);
-static bool      initBodiesFromCSV(const std::string& path);
+static void       handleLegendClick(double mouseX, double mouseY);
+static glm::dvec3 getBodyPos(const std::string& name);
+static bool       initBodiesFromCSV(const std::string& path);
 
 // --------------------------------------------------
 // Callbacks
@@ -162,13 +250,16 @@ static void cursor_pos_callback(GLFWwindow*, double xpos, double ypos) {
 static void scroll_callback(GLFWwindow*, double /*xoff*/, double yoff) {
     float zoomSpeed = std::max(0.0000005f, g_radius * 0.1f);
     g_radius -= static_cast<float>(yoff) * zoomSpeed;
-    g_radius = glm::clamp(g_radius, 0.00000001f, 100000.0f);
+    g_radius = glm::clamp(g_radius, 0.00000001f, 5000000.0f);
 }
 
 /**
  * @brief Keyboard controls:
  *  1 = Sun, 2 = Mercury, 3 = Venus, 4 = Earth, 5 = Moon,
  *  6 = Mars, 7 = Jupiter, 8 = Saturn, 9 = Uranus, 0 = Neptune
+ *  Left / Right = seek back / forward 5%, Home = first frame
+ *  + / - = double / halve playback speed, Space = pause
+ *  T = show / hide orbit trails
  */
 static void key_callback(GLFWwindow* /*win*/, int key, int /*scancode*/, int action, int /*mods*/) {
     if (action != GLFW_PRESS) return;
@@ -184,62 +275,29 @@ static void key_callback(GLFWwindow* /*win*/, int key, int /*scancode*/, int act
         case GLFW_KEY_8: g_cameraTarget = CameraTarget::Saturn;  break;
         case GLFW_KEY_9: g_cameraTarget = CameraTarget::Uranus;  break;
         case GLFW_KEY_0: g_cameraTarget = CameraTarget::Neptune; break;
+        case GLFW_KEY_LEFT:  --g_seekSteps;     break;
+        case GLFW_KEY_RIGHT: ++g_seekSteps;     break;
+        case GLFW_KEY_HOME:  g_seekHome = true; break;
+        case GLFW_KEY_EQUAL:
+        case GLFW_KEY_KP_ADD:
+            g_clock.setSpeed(g_clock.speed() * 2.0);
+            std::cout << "⏩ Speed " << g_clock.speed() << " sim s / s\n";
+            break;
+        case GLFW_KEY_MINUS:
+        case GLFW_KEY_KP_SUBTRACT:
+            g_clock.setSpeed(g_clock.speed() * 0.5);
+            std::cout << "⏩ Speed " << g_clock.speed() << " sim s / s\n";
+            break;
+        case GLFW_KEY_T: g_showTrails = !g_showTrails; break;
+        case GLFW_KEY_SPACE:
+            g_clock.togglePause();
+            std::cout << (g_clock.paused() ? "⏸️ Paused\n" : "▶️ Playing\n");
+            break;
         default: break;
     }
 }
 
 
-// --------------------------------------------------
-// Shader helpers
-// --------------------------------------------------
-/**
- * @brief Compiles a shader of given type from source code.
- */
-static GLuint compileShader(GLenum type, const char* src) {
-    GLuint s = glCreateShader(type);
-    glShaderSource(s, 1, &src, nullptr);
-    glCompileShader(s);
-
-    GLint ok = 0;
-    glGetShaderiv(s, GL_COMPILE_STATUS, &ok);
-    if (!ok) {
-        GLint len = 0;
-        glGetShaderiv(s, GL_INFO_LOG_LENGTH, &len);
-        std::string log(len, '\0');
-        glGetShaderInfoLog(s, len, nullptr, log.data());
-        std::cerr << "❌ Shader error:\n" << log << "\n";
-    }
-    return s;
-}
-
-/**
- * @brief Creates an OpenGL program from a vertex + fragment shader pair.
- */
-static GLuint createProgram(const char* vsSrc, const char* fsSrc) {
-    GLuint vs = compileShader(GL_VERTEX_SHADER, vsSrc);
-    GLuint fs = compileShader(GL_FRAGMENT_SHADER, fsSrc);
-
-    GLuint prog = glCreateProgram();
-    glAttachShader(prog, vs);
-    glAttachShader(prog, fs);
-    glLinkProgram(prog);
-
-    GLint ok = 0;
-    glGetProgramiv(prog, GL_LINK_STATUS, &ok);
-    if (!ok) {
-        GLint len = 0;
-        glGetProgramiv(prog, GL_INFO_LOG_LENGTH, &len);
-        std::string log(len, '\0');
-        glGetProgramInfoLog(prog, len, nullptr, log.data());
-        std::cerr << "❌ Link error:\n" << log << "\n";
-    }
-
-    glDeleteShader(vs);
-    glDeleteShader(fs);
-    return prog;
-}
-
-
 // --------------------------------------------------
 // Legend helpers (2D quads in NDC)
 // --------------------------------------------------
@@ -381,16 +439,10 @@ static void handleLegendClick(double mouseX, double mouseY) {
 // --------------------------------------------------
 
 // Distance scale: 1 GL unit = 5e9 meters
-static constexpr float DIST_SCALE_METERS = 1.0f / 5e9f;
+static constexpr double DIST_SCALE_METERS = 1.0 / 5e9;
 
-// Additional uniform compression for visualization.
-// After converting meters → GL, we multiply positions by this:
-// 1.0f  = no extra compression (true scale in GL)
-// 0.02f = 2% of that distance → outer planets pulled in so you can see them
-static constexpr float DIST_VIS_SCALE = 0.02f;
-
-// Moon orbit exaggeration (for visibility). Set to 1.0f for strict realism.
-static constexpr float MOON_EXAGGERATION = 15.0f;
+// Near plane (GL units, 5 m): log depth keeps precision at any distance
+static constexpr float NEAR_PLANE = 1.0e-9f;
 
 // Color map for Solar System bodies
 static glm::vec3 colorForBody(const std::string& name) {
@@ -423,152 +475,365 @@ static float radiusForBody(const std::string& name) {
     else if (name == "Neptune") r_m = 2.4622e7f;
 
     // meters → GL units (no extra radius exaggeration)
-    return r_m * DIST_SCALE_METERS;
+    return static_cast<float>(r_m * DIST_SCALE_METERS);
+}
+
+/**
+ * @brief Position of body `bi` (GL units) at the playback time: Hermite
+ *        interpolation over the current frame interval.
+ */
+static glm::dvec3 interpolatedPos(size_t bi) {
+    return hermite(g_stateA[2 * bi], g_stateA[2 * bi + 1],
+                   g_stateB[2 * bi], g_stateB[2 * bi + 1],
+                   g_span, g_fraction);
 }
 
 /**
- * @brief Returns the current position of a body (in GL units) for the active frame.
+ * @brief Returns the current position of a body (in GL units) at the playback time.
  *        If body is missing or has no data, returns (0,0,0).
  */
-static glm::vec3 getBodyPos(const std::string& name) {
+static glm::dvec3 getBodyPos(const std::string& name) {
     auto it = g_bodyIndex.find(name);
-    if (it == g_bodyIndex.end()) return glm::vec3(0.0f);
-    size_t idx = it->second;
-    if (g_bodies.empty() || g_bodies[idx].positions.empty()) return glm::vec3(0.0f);
+    if (it == g_bodyIndex.end()) return glm::dvec3(0.0);
+    if (!g_stateA) return glm::dvec3(0.0);
 
-    size_t frame = (g_numFrames == 0) ? 0 : (g_frameIndex % g_numFrames);
-    return g_bodies[idx].positions[frame];
+    return interpolatedPos(it->second);
+}
+
+/**
+ * @brief Body name of a camera target ("Barycenter" for the origin).
+ */
+static const char* cameraTargetName(CameraTarget target) {
+    static const char* const NAMES[CAMERA_TARGET_COUNT] = {
+        "Barycenter", "Sun", "Mercury", "Venus", "Earth", "Moon",
+        "Mars", "Jupiter", "Saturn", "Uranus", "Neptune"
+    };
+    return NAMES[static_cast<int>(target)];
+}
+
+/**
+ * @brief Current position of the camera target (GL units).
+ */
+static glm::dvec3 cameraTargetPos() {
+    if (g_cameraTarget == CameraTarget::Barycenter) return glm::dvec3(0.0);
+    return getBodyPos(cameraTargetName(g_cameraTarget));
+}
+
+/**
+ * @brief Camera position relative to its target, from the orbit
+ *        camera's spherical coordinates.
+ */
+static glm::vec3 cameraOffset() {
+    return glm::vec3(
+        g_radius * cos(g_pitch) * sin(g_yaw),
+        g_radius * sin(g_pitch),
+        g_radius * cos(g_pitch) * cos(g_yaw)
+    );
+}
+
+/**
+ * @brief Registers a body (color and radius from its name).
+ */
+static void addBody(const std::string& name) {
+    BodyRenderInfo body;
+    body.name   = name;
+    body.color  = colorForBody(name);
+    body.radius = radiusForBody(name);
+
+    g_bodyIndex[name] = static_cast<size_t>(g_bodies.size());
+    g_bodies.push_back(std::move(body));
+}
+
+/**
+ * @brief Meters → GL units.
+ */
+static glm::dvec3 metersToGL(double x, double y, double z) {
+    return glm::dvec3(x, y, z) * DIST_SCALE_METERS;
+}
+
+/**
+ * @brief One frame of (position, velocity) in meters → interleaved GL
+ *        states.
+ */
+static void frameToGL(const std::vector<vec3>& positions,
+                      const std::vector<vec3>& velocities,
+                      glm::dvec3* states) {
+    for (size_t bi = 0; bi < positions.size(); ++bi) {
+        const vec3& p = positions[bi];
+        const vec3& v = velocities[bi];
+        states[2 * bi]     = metersToGL(p.x(), p.y(), p.z());
+        states[2 * bi + 1] = metersToGL(v.x(), v.y(), v.z());
+    }
+}
+
+/**
+ * @brief Points the frame interval at frames a and b of g_states for
+ *        playback time t.
+ */
+static void setInterval(size_t a, size_t b, double t) {
+    const size_t stride = 2 * g_bodies.size();
+    const double span   = g_times[b] - g_times[a];
+
+    g_stateA   = &g_states[a * stride];
+    g_stateB   = &g_states[b * stride];
+    g_span     = span;
+    g_fraction = span > 0.0 ? std::clamp((t - g_times[a]) / span, 0.0, 1.0) : 0.0;
 }
 
 /**
  * @brief Initialize N-body data by reading orbit_three_body.csv.
- *        - Detects all x_, y_, z_ position columns
- *        - Scales meters to GL units
- *        - Compresses distances (2%) for visibility
- *        - Optionally exaggerates Moon orbit for visibility
+ *        - Parallel mmap + from_chars parse (loadTrajectoryCSV)
+ *        - Frame times (step + 1) * g_dt, central-difference velocities
+ *        - Scales meters to GL units (double)
  */
 static bool initBodiesFromCSV(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        std::cerr << "❌ Could not open CSV: " << path << "\n";
+    TrajectoryCSVData data;
+    try {
+        data = loadTrajectoryCSV(path);
+    } catch (const std::exception& e) {
+        std::cerr << "❌ " << e.what() << "\n";
         return false;
     }
 
-    std::string line;
-    if (!std::getline(file, line)) {
-        std::cerr << "⚠️ Empty CSV: " << path << "\n";
-        return false;
-    }
+    for (const auto& name : data.names) addBody(name);
+
+    const size_t nBodies = g_bodies.size();
+    g_numFrames = data.frames();
+    g_states.resize(g_numFrames * nBodies * 2);
 
-    std::stringstream header(line);
-    std::vector<std::string> columns;
-    std::string col;
-    while (std::getline(header, col, ',')) {
-        columns.push_back(col);
+    g_times.resize(g_numFrames);
+    for (size_t f = 0; f < g_numFrames; ++f) {
+        g_times[f] = static_cast<double>(data.steps[f] + 1) * g_dt;
     }
 
-    // Identify body columns: x_name,y_name,z_name groups.
-    struct Triplet { int ix, iy, iz; };
-    std::vector<Triplet> bodyCols;
-
-    for (size_t i = 0; i + 2 < columns.size(); ++i) {
-        if (columns[i].rfind("x_", 0) == 0) {
-            std::string name = columns[i].substr(2);
-            int ix = static_cast<int>(i);
-            int iy = static_cast<int>(i + 1);
-            int iz = static_cast<int>(i + 2);
-
-            BodyRenderInfo body;
-            body.name   = name;
-            body.color  = colorForBody(name);
-            body.radius = radiusForBody(name);
-
-            g_bodyIndex[name] = static_cast<size_t>(g_bodies.size());
-            g_bodies.push_back(std::move(body));
-            bodyCols.push_back({ix, iy, iz});
+    // Per-body arrays (m) → frame-major GL states. The CSV has no
+    // velocities: central differences, one-sided at the ends.
+    std::vector<vec3> pos(nBodies), vel(nBodies);
+    for (size_t f = 0; f < g_numFrames; ++f) {
+        const size_t lo = f > 0 ? f - 1 : f;
+        const size_t hi = f + 1 < g_numFrames ? f + 1 : f;
+        const double dt = g_times[hi] - g_times[lo];
+
+        for (size_t bi = 0; bi < nBodies; ++bi) {
+            const std::vector<vec3>& track = data.positions[bi];
+            pos[bi] = track[f];
+            vel[bi] = dt > 0.0 ? (track[hi] - track[lo]) / dt : vec3(0.0, 0.0, 0.0);
         }
-    }
 
-    if (g_bodies.empty()) {
-        std::cerr << "⚠️ No x_* body columns found in CSV header.\n";
-        return false;
+        frameToGL(pos, vel, &g_states[f * nBodies * 2]);
     }
 
-    constexpr float SCALE_METERS = DIST_SCALE_METERS;
-
-    size_t lineCount = 0;
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-        std::stringstream ss(line);
-        std::vector<double> rowValues;
-        std::string v;
-        while (std::getline(ss, v, ',')) {
-            try {
-                rowValues.push_back(std::stod(v));
-            } catch (...) {
-                rowValues.push_back(0.0);
-            }
-        }
-
-        if (rowValues.size() < columns.size()) {
-            // malformed row, skip
-            continue;
-        }
+    std::cout << "📄 Loaded " << g_numFrames
+              << " frames for " << nBodies
+              << " bodies from " << path << "\n";
+    return (g_numFrames > 0);
+}
 
-        // Per-frame positions for all bodies (scaled).
-        std::vector<glm::vec3> framePos(g_bodies.size(), glm::vec3(0.0f));
 
-        // First, load raw scaled positions.
-        for (size_t bi = 0; bi < g_bodies.size(); ++bi) {
-            const auto& trips = bodyCols[bi];
-            double x = rowValues[trips.ix];
-            double y = rowValues[trips.iy];
-            double z = rowValues[trips.iz];
-
-            glm::vec3 p(
-                static_cast<float>(x * SCALE_METERS),
-                static_cast<float>(y * SCALE_METERS),
-                static_cast<float>(z * SCALE_METERS)
-            );
+// --------------------------------------------------
+// Playback
+// --------------------------------------------------
 
-            // ----------------------------------------
-            // ✨ VISUAL DISTANCE COMPRESSION (2%)
-            // ----------------------------------------
-            // This keeps all orbital shapes and relative geometry,
-            // but pulls the whole system closer to the camera so
-            // Jupiter / Saturn / Uranus / Neptune are actually visible.
-            p *= DIST_VIS_SCALE;
+/**
+ * @brief Points the frame interval (g_stateA / g_stateB, g_span,
+ *        g_fraction) at playback time `t` and applies pending seeks.
+ *
+ * `t` may move: to a seek target, back to the start when playback loops,
+ * or back to the last time shown while streamed data is missing. The
+ * caller keeps g_clock in step with it.
+ *
+ * @param ready  set to whether the interval holds `t` (false while the
+ *               stream reader or the live producer has not reached it)
+ * @return true if playback jumped (seek or loop): trails restart
+ */
+static bool updatePlayback(double& t, bool& ready) {
+    bool jumped = false;
+    ready = false;
+
+    if (g_live) {
+        // No history to seek in: the producer integrates up to the
+        // playback time and the newest pair of steps brackets it
+        if (const LiveState* state = g_live->latest()) {
+            g_frameA = state->a;
+            g_frameB = state->b;
+            frameToGL(g_frameA.positions, g_frameA.velocities, g_streamA.data());
+            frameToGL(g_frameB.positions, g_frameB.velocities, g_streamB.data());
+            g_stateA = g_streamA.data();
+            g_stateB = g_streamB.data();
+            g_span   = g_frameB.t - g_frameA.t;
+        }
+        g_live->advanceTo(t);
+        ready = g_stateA && t <= g_frameB.t;
+
+        // A producer that falls behind holds the clock at its latest step
+        if (g_stateA && t > g_frameB.t + g_dt) t = g_frameB.t;
+
+        g_fraction = g_span > 0.0 ? std::clamp((t - g_frameA.t) / g_span, 0.0, 1.0) : 0.0;
+    } else if (g_stream) {
+        // Seeking by frame (the count is an estimate until EOF)
+        const size_t totalFrames = g_stream->approxFrames();
+        if (g_seekHome) {
+            g_frameIndex = 0;
+        } else if (g_seekSteps != 0 && totalFrames > 0) {
+            const long long step   = std::max<long long>(1, static_cast<long long>(totalFrames) / 20);
+            const long long target = static_cast<long long>(g_frameIndex) + g_seekSteps * step;
+            g_frameIndex = static_cast<size_t>(
+                std::clamp<long long>(target, 0, static_cast<long long>(totalFrames) - 1));
+        }
+        if (g_seekHome || g_seekSteps != 0) {
+            std::cout << "⏩ Seek to frame " << g_frameIndex << "\n";
+            g_streamSync = true;
+        }
 
-            framePos[bi] = p;
+        // Move the interval forward until it holds the playback time,
+        // jumping by the frames the elapsed time covers. Missing data
+        // holds the clock (playback waits for the reader).
+        ready = g_stream->acquire(g_frameIndex, g_frameA, &g_frameB);
+        if (ready && g_streamSync) {
+            t = g_frameA.t;
+            g_streamSync = false;
+            jumped = true;
+        }
+        while (ready && g_frameB.t > g_frameA.t && t >= g_frameB.t) {
+            const double span = g_frameB.t - g_frameA.t;
+            g_frameIndex += std::max<size_t>(1, static_cast<size_t>((t - g_frameA.t) / span));
+            ready = g_stream->acquire(g_frameIndex, g_frameA, &g_frameB);
         }
 
-        // Exaggerate Moon orbit if both Earth and Moon exist.
-        if (MOON_EXAGGERATION != 1.0f) {
-            auto itEarth = g_bodyIndex.find("Earth");
-            auto itMoon  = g_bodyIndex.find("Moon");
-            if (itEarth != g_bodyIndex.end() && itMoon != g_bodyIndex.end()) {
-                size_t eIdx = itEarth->second;
-                size_t mIdx = itMoon->second;
-                glm::vec3 earthPos = framePos[eIdx];
-                glm::vec3 moonPos  = framePos[mIdx];
-                glm::vec3 offset   = moonPos - earthPos;
-                framePos[mIdx]     = earthPos + offset * MOON_EXAGGERATION;
+        if (ready) {
+            if (t < g_frameA.t) t = g_frameA.t;   // jumped past t
+            g_streamShown = t;
+
+            frameToGL(g_frameA.positions, g_frameA.velocities, g_streamA.data());
+            frameToGL(g_frameB.positions, g_frameB.velocities, g_streamB.data());
+            const double span = g_frameB.t - g_frameA.t;
+            g_stateA   = g_streamA.data();
+            g_stateB   = g_streamB.data();
+            g_span     = span;
+            g_fraction = span > 0.0 ? std::min(1.0, (t - g_frameA.t) / span) : 0.0;
+
+            if (span <= 0.0 && t >= g_frameA.t) {
+                g_frameIndex = 0;   // last frame: loop (reloads from the first checkpoint)
+                g_streamSync = true;
             }
+        } else if (g_stream->frameCount() > 0 && g_frameIndex >= g_stream->frameCount()) {
+            g_frameIndex = 0;
+            g_streamSync = true;
+        } else if (g_stateA) {
+            t = g_streamShown;
+        }
+    } else if (g_numFrames > 0) {
+        // Seeking by time, 5% of the duration per step; loops at the end
+        const double t0 = g_times.front();
+        const double t1 = g_times.back();
+        if (g_seekHome) {
+            t = t0;
+        } else if (g_seekSteps != 0) {
+            t = std::clamp(t + g_seekSteps * 0.05 * (t1 - t0), t0, t1);
         }
+        if (t >= t1 || t < t0) {
+            t = t0;
+            jumped = true;
+        }
+        if (g_seekHome || g_seekSteps != 0) {
+            jumped = true;
+            std::cout << "⏩ Seek to t = " << (t - t0) / 86400.0 << " d\n";
+        }
+
+        const auto it = std::upper_bound(g_times.begin(), g_times.end(), t);
+        g_frameIndex = static_cast<size_t>(std::max<std::ptrdiff_t>(0, (it - g_times.begin()) - 1));
+        setInterval(g_frameIndex, std::min(g_frameIndex + 1, g_numFrames - 1), t);
+        ready = true;
+    }
+    g_seekHome  = false;
+    g_seekSteps = 0;
+    return jumped;
+}
+
+/**
+ * @brief Renders without a window: the viewer's scene on the CPU
+ *        (SoftwareRenderer) at a fixed size and frame rate, written by
+ *        FrameWriter. Frame k shows playback time t0 + k * speed / fps;
+ *        missing streamed / live data is waited for, not skipped.
+ * @return process exit code
+ */
+static int runHeadless(const HeadlessOptions& opt, size_t trailPoints) {
+    std::unique_ptr<FrameWriter> writer;
+    try {
+        writer = std::make_unique<FrameWriter>(opt.output, opt.width, opt.height);
+    } catch (const std::exception& e) {
+        std::cerr << "❌ " << e.what() << "\n";
+        return -1;
+    }
+
+    SoftwareRenderer renderer(opt.width, opt.height);
+    std::optional<SoftwareTrails> trails;
+    if (trailPoints > 0) trails.emplace(g_bodies.size(), trailPoints);
 
-        // Append frame positions to each body.
+    std::vector<BodyInstance> instances;
+    instances.reserve(g_bodies.size());
+    for (const auto& body : g_bodies) {
+        instances.push_back({glm::vec3(0.0f), body.radius, body.color});
+    }
+    std::vector<glm::dvec3> centers(g_bodies.size());
+
+    std::cout << "🎞️ Rendering " << opt.width << "x" << opt.height << " at " << opt.fps
+              << " fps to " << (opt.output == "-" ? "stdout (raw RGB24)" : opt.output) << "\n";
+
+    const float pixelAngle = 2.0f * std::tan(glm::radians(45.0f) * 0.5f)
+                           / static_cast<float>(opt.height);
+    const double frameStep = g_clock.speed() / opt.fps;   // simulated s per frame
+    const auto   start     = std::chrono::steady_clock::now();
+
+    std::vector<std::uint8_t> rgb;
+    size_t frame = 0;
+    for (; opt.frames == 0 || frame < static_cast<size_t>(opt.frames); ++frame) {
+        const double request = frame == 0 ? g_clock.time() : g_clock.time() + frameStep;
+        double t      = request;
+        bool   ready  = false;
+        bool   jumped = updatePlayback(t, ready);
+        while (!ready) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            t = request;
+            jumped |= updatePlayback(t, ready);
+        }
+        // Without --frames: one pass, up to where playback loops
+        if (opt.frames == 0 && frame > 0 && jumped) break;
+        g_clock.seek(t);
+
+        // Bodies relative to the camera target (subtracted in double),
+        // trails in world space
+        SoftwareCamera camera;
+        camera.origin   = cameraTargetPos();
+        camera.position = glm::dvec3(cameraOffset());
+        camera.target   = glm::dvec3(0.0);
         for (size_t bi = 0; bi < g_bodies.size(); ++bi) {
-            g_bodies[bi].positions.push_back(framePos[bi]);
+            const glm::dvec3 pos = interpolatedPos(bi);
+            const glm::vec3  rel(pos - camera.origin);
+            centers[bi]          = pos;
+            instances[bi].center = rel;
+            instances[bi].radius = drawRadius(g_bodies[bi].radius,
+                                              glm::length(rel - cameraOffset()), pixelAngle);
+        }
+        if (trails) {
+            if (jumped) trails->clear();
+            trails->append(centers);
         }
 
-        ++lineCount;
+        const glm::vec3 light(getBodyPos("Sun") - camera.origin);
+        renderer.render(instances, trails ? &*trails : nullptr, camera, light, rgb);
+        if (!writer->write(std::move(rgb))) break;
     }
 
-    g_numFrames = lineCount;
-    std::cout << "📄 Loaded " << g_numFrames
-              << " frames for " << g_bodies.size()
-              << " bodies from " << path << "\n";
-    return (g_numFrames > 0);
+    const bool ok = writer->finish();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!ok) {
+        std::cerr << "❌ Failed to write frames to " << opt.output << "\n";
+        return -1;
+    }
+    std::cout << "✅ Rendered " << frame << " frames in " << seconds << " s ("
+              << (seconds > 0.0 ? static_cast<double>(frame) / seconds : 0.0) << " frames / s)\n";
+    return 0;
 }
 
 
@@ -578,12 +843,144 @@ static bool initBodiesFromCSV(const std::string& path) {
 /**
  * @brief Entry point for the Orbit Viewer application.
  */
-int main() {
-    // Init N-body positions first (Solar System) from simulation output
-    if (!initBodiesFromCSV("./build/orbit_three_body.csv")) {
+int main(int argc, char** argv) {
+    // Usage: orbit-viewer [--stream] [--dt T] [--speed X] [--trail N]
+    //                     [trajectory.csv | trajectory.otraj]
+    //        orbit-viewer --live --system FILE [--dt T] [--speed X] [--trail N]
+    //        either one with --headless OUT [--size WxH] [--fps N] [--frames N]
+    //                        [--target NAME] [--distance R]
+    std::string path = "./build/orbit_three_body.csv";
+    std::string systemPath;
+    bool   streaming = false;
+    bool   liveMode  = false;
+    double speed     = 0.0;   // 0 = DEFAULT_FRAMES_PER_SECOND frames per second
+    long   trailPoints = static_cast<long>(TrailRenderer::DEFAULT_POINTS);
+    HeadlessOptions headless;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        try {
+            if (arg == "--headless" && i + 1 < argc) {
+                headless.output = argv[++i];
+            } else if (arg == "--size" && i + 1 < argc) {
+                const std::string size = argv[++i];
+                const size_t x = size.find('x');
+                if (x == std::string::npos) throw std::invalid_argument(size);
+                headless.width  = std::stoi(size.substr(0, x));
+                headless.height = std::stoi(size.substr(x + 1));
+            } else if (arg == "--fps" && i + 1 < argc) {
+                headless.fps = std::stod(argv[++i]);
+            } else if (arg == "--frames" && i + 1 < argc) {
+                headless.frames = std::stol(argv[++i]);
+            } else if (arg == "--target" && i + 1 < argc) {
+                const std::string name = argv[++i];
+                int target = 0;
+                while (target < CAMERA_TARGET_COUNT &&
+                       name != cameraTargetName(static_cast<CameraTarget>(target))) {
+                    ++target;
+                }
+                if (target == CAMERA_TARGET_COUNT) throw std::invalid_argument(name);
+                g_cameraTarget = static_cast<CameraTarget>(target);
+            } else if (arg == "--distance" && i + 1 < argc) {
+                g_radius = std::stof(argv[++i]);
+            } else if (arg == "--stream") {
+                streaming = true;
+            } else if (arg == "--live") {
+                liveMode = true;
+            } else if (arg == "--system" && i + 1 < argc) {
+                systemPath = argv[++i];
+            } else if (arg == "--dt" && i + 1 < argc) {
+                g_dt = std::stod(argv[++i]);
+            } else if (arg == "--speed" && i + 1 < argc) {
+                speed = std::stod(argv[++i]);
+            } else if (arg == "--trail" && i + 1 < argc) {
+                trailPoints = std::stol(argv[++i]);
+            } else {
+                path = arg;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "❌ Invalid value for " << arg << "\n";
+            return -1;
+        }
+    }
+    if (g_dt <= 0.0 || speed < 0.0 || trailPoints < 0) {
+        std::cerr << "❌ --dt, --speed and --trail must be positive\n";
+        return -1;
+    }
+
+    if (liveMode && systemPath.empty()) {
+        std::cerr << "❌ --live requires --system FILE\n";
+        return -1;
+    }
+
+    if (!headless.output.empty()) {
+        if (headless.width <= 0 || headless.height <= 0 || headless.fps <= 0.0 ||
+            headless.frames < 0 || g_radius <= 0.0f) {
+            std::cerr << "❌ --size, --fps, --frames and --distance must be positive\n";
+            return -1;
+        }
+        if (liveMode && headless.frames == 0) {
+            std::cerr << "❌ --headless with --live requires --frames N\n";
+            return -1;
+        }
+        // Raw frames own stdout: messages go to stderr
+        if (headless.output == "-") std::cout.rdbuf(std::cerr.rdbuf());
+    }
+
+    // Binary trajectories and very large files always stream
+    std::error_code ec;
+    const std::uintmax_t fileBytes = std::filesystem::file_size(path, ec);
+    if (!liveMode && !ec && (fileBytes > STREAM_AUTO_BYTES || isTrajectoryBinary(path))) {
+        streaming = true;
+    }
+
+    // Live: the system is integrated while the window is up. Streaming:
+    // only the header is read here, frames arrive once the window is up.
+    // Otherwise load all N-body positions first.
+    if (liveMode) {
+        try {
+            g_live = std::make_unique<LiveSimulation>(loadSystem(systemPath), g_dt);
+        } catch (const std::exception& e) {
+            std::cerr << "❌ " << e.what() << "\n";
+            return -1;
+        }
+        for (const auto& name : g_live->bodyNames()) addBody(name);
+        std::cout << "📡 Live simulation of " << g_bodies.size() << " bodies from "
+                  << systemPath << " (dt = " << g_dt << " s)\n";
+    } else if (streaming) {
+        try {
+            g_stream = std::make_unique<TrajectoryStream>(path, g_dt);
+        } catch (const std::exception& e) {
+            std::cerr << "❌ " << e.what() << "\n";
+            return -1;
+        }
+        for (const auto& name : g_stream->bodyNames()) addBody(name);
+        std::cout << "📡 Streaming " << g_bodies.size() << " bodies from " << path
+                  << " (" << g_stream->capacityFrames() << "-frame read-ahead)\n";
+    } else if (!initBodiesFromCSV(path)) {
         return -1;
     }
 
+    // Default speed: DEFAULT_FRAMES_PER_SECOND stored frames per second
+    // (frame spacing unknown before the first streamed frames: --dt)
+    if (speed == 0.0) {
+        const double spacing = (!g_stream && !g_live && g_numFrames > 1)
+            ? (g_times.back() - g_times.front()) / static_cast<double>(g_numFrames - 1)
+            : g_dt;
+        speed = spacing * DEFAULT_FRAMES_PER_SECOND;
+    }
+    g_clock.setSpeed(speed);
+    if (!g_stream && !g_live && g_numFrames > 0) g_clock.seek(g_times.front());
+
+    g_streamA.resize(2 * g_bodies.size());
+    g_streamB.resize(2 * g_bodies.size());
+
+    if (!headless.output.empty()) {
+        const int rc = runHeadless(headless, static_cast<size_t>(trailPoints));
+        g_live.reset();
+        g_stream.reset();
+        return rc;
+    }
+
     // ----------------- GLFW init -----------------
     if (!glfwInit()) {
         std::cerr << "❌ Failed to init GLFW\n";
@@ -620,78 +1017,45 @@ int main() {
 
     glEnable(GL_DEPTH_TEST);
 
-    // Build sphere meshes for all bodies now that we have a valid GL context
-    for (auto& body : g_bodies) {
-        body.mesh.build(body.radius, 32, 32);
-    }
-
     // ----------------------------------------------------
-    // Create main 3D shader (Option C lighting)
+    // Body renderer: one shared unit sphere, drawn instanced
+    // (Option C lighting)
     // ----------------------------------------------------
-    const char* vsSrc = R"GLSL(
-        #version 330 core
-        layout(location = 0) in vec3 aPos;
-        layout(location = 1) in vec3 aNormal;
-
-        uniform mat4 uMVP;
-        uniform mat4 uModel;
-
-        out vec3 vNormal;
-        out vec3 vWorldPos;
-
-        void main() {
-            mat3 normalMat = mat3(transpose(inverse(uModel)));
-            vNormal   = normalMat * aNormal;
-            vWorldPos = vec3(uModel * vec4(aPos, 1.0));
-            gl_Position = uMVP * vec4(aPos, 1.0);
-        }
-    )GLSL";
-
-    const char* fsSrc = R"GLSL(
-        #version 330 core
-
-        in vec3 vNormal;
-        in vec3 vWorldPos;
-
-        out vec4 FragColor;
-
-        uniform vec3 uColor;
-        uniform vec3 uLightPos;
-        uniform vec3 uViewPos;
-
-        void main() {
-            vec3 N = normalize(vNormal);
-            vec3 L = normalize(uLightPos - vWorldPos);
-            vec3 V = normalize(uViewPos - vWorldPos);
-            vec3 H = normalize(L + V);
-
-            // Lambert + Blinn–Phong
-            float diff = max(dot(N, L), 0.0);
-            float spec = pow(max(dot(N, H), 0.0), 32.0);
-            float ambient = 0.18;
-
-            vec3 base = uColor * (ambient + diff)
-                      + vec3(0.4) * spec;
-
-            // Rim light for cinematic look
-            float rim = pow(1.0 - max(dot(N, V), 0.0), 2.0);
-            vec3 rimColor = vec3(0.3, 0.4, 0.9) * rim * 0.5;
-
-            vec3 color = base + rimColor;
+    // Optional so their GL objects can be freed while the context is current
+    std::optional<BodyRenderer>     renderer;
+    std::optional<TrajectoryBuffer> trajectory;
+    renderer.emplace();
+    if (!g_stream && !g_live) trajectory.emplace();
+    if (!renderer->init() ||
+        (trajectory && !trajectory->init(g_states.data(), g_numFrames, g_bodies.size()))) {
+        trajectory.reset();
+        renderer.reset();
+        glfwDestroyWindow(win);
+        glfwTerminate();
+        return -1;
+    }
 
-            // Gamma
-            color = pow(color, vec3(1.0 / 2.2));
+    // Radius and color are constant; centers are refreshed every frame,
+    // relative to the camera target (for culling only when the shader
+    // reads them from the trajectory)
+    std::vector<BodyInstance> instances;
+    instances.reserve(g_bodies.size());
+    for (const auto& body : g_bodies) {
+        instances.push_back({glm::vec3(0.0f), body.radius, body.color});
+    }
 
-            FragColor = vec4(color, 1.0);
-        }
-    )GLSL";
+    // Orbit trails (optional: --trail 0 disables them)
+    std::optional<TrailRenderer> trails;
+    if (trailPoints > 0) {
+        std::vector<glm::vec3> colors;
+        colors.reserve(g_bodies.size());
+        for (const auto& body : g_bodies) colors.push_back(body.color);
 
-    GLuint shader = createProgram(vsSrc, fsSrc);
-    GLint locMVP     = glGetUniformLocation(shader, "uMVP");
-    GLint locModel   = glGetUniformLocation(shader, "uModel");
-    GLint locColor   = glGetUniformLocation(shader, "uColor");
-    GLint locLight   = glGetUniformLocation(shader, "uLightPos");
-    GLint locViewPos = glGetUniformLocation(shader, "uViewPos");
+        trails.emplace();
+        if (!trails->init(colors, static_cast<size_t>(trailPoints))) trails.reset();
+    }
+    std::vector<glm::dvec3> centers(g_bodies.size());
+    bool trailsShown = g_showTrails;
 
     // ----------------------------------------------------
     // Init legend renderer (2D colored boxes in NDC)
@@ -704,72 +1068,68 @@ int main() {
     while (!glfwWindowShouldClose(win)) {
         glfwPollEvents();
 
-        if (g_numFrames > 0) {
-            g_frameIndex = (g_frameIndex + 1) % g_numFrames;
-        }
+        // Playback jumps (seek, loop) restart the trails
+        double t = g_clock.tick();
+        const double ticked = t;
+        bool ready = false;
+        const bool trailReset = updatePlayback(t, ready);
+        if (t != ticked) g_clock.seek(t);
 
         glClearColor(0.02f, 0.02f, 0.05f, 1.0f); // deep navy space
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        if (!g_bodies.empty() && g_numFrames > 0) {
-            // Determine camera target position
-            glm::vec3 target(0.0f);
-            switch (g_cameraTarget) {
-                case CameraTarget::Sun:     target = getBodyPos("Sun");     break;
-                case CameraTarget::Mercury: target = getBodyPos("Mercury"); break;
-                case CameraTarget::Venus:   target = getBodyPos("Venus");   break;
-                case CameraTarget::Earth:   target = getBodyPos("Earth");   break;
-                case CameraTarget::Moon:    target = getBodyPos("Moon");    break;
-                case CameraTarget::Mars:    target = getBodyPos("Mars");    break;
-                case CameraTarget::Jupiter: target = getBodyPos("Jupiter"); break;
-                case CameraTarget::Saturn:  target = getBodyPos("Saturn");  break;
-                case CameraTarget::Uranus:  target = getBodyPos("Uranus");  break;
-                case CameraTarget::Neptune: target = getBodyPos("Neptune"); break;
-                case CameraTarget::Barycenter:
-                default:
-                    target = glm::vec3(0.0f);
-                    break;
-            }
-
-            // Camera offset in local spherical coords
-            glm::vec3 camOffset(
-                g_radius * cos(g_pitch) * sin(g_yaw),
-                g_radius * sin(g_pitch),
-                g_radius * cos(g_pitch) * cos(g_yaw)
-            );
-
-            glm::vec3 camPos = target + camOffset;
+        if (!g_bodies.empty() && g_stateA) {
+            // Camera target in double: everything drawn is relative to
+            // it, so the view matrix has no large translation
+            const glm::dvec3 target = cameraTargetPos();
+            const glm::vec3  camPos = cameraOffset();
 
             float aspect = float(g_windowWidth) / float(g_windowHeight);
 
-            // Reverse-Z style infinite perspective: tiny near plane, infinite far.
+            // Infinite perspective: tiny near plane, infinite far
+            // (the shaders write logarithmic depth)
             glm::mat4 proj = glm::infinitePerspective(
                 glm::radians(45.0f),
                 aspect,
-                0.000001f   // near plane in GL units
+                NEAR_PLANE
             );
 
-            glm::mat4 view = glm::lookAt(camPos, target, glm::vec3(0, 1, 0));
-
-            glUseProgram(shader);
+            glm::mat4 view = glm::lookAt(camPos, glm::vec3(0.0f), glm::vec3(0, 1, 0));
 
-            // view position for specular
-            glUniform3fv(locViewPos, 1, glm::value_ptr(camPos));
             // light at Sun position (or origin if missing)
-            glm::vec3 sunPos = getBodyPos("Sun");
-            glUniform3fv(locLight, 1, glm::value_ptr(sunPos));
+            const glm::vec3 sunPos(getBodyPos("Sun") - target);
+
+            // View angle of one pixel, for the body and trail LOD
+            const float pixelAngle = 2.0f * std::tan(glm::radians(45.0f) * 0.5f)
+                                   / static_cast<float>(std::max(1, g_windowHeight));
+
+            // Body centers on the CPU, camera-relative for drawing and
+            // culling, world space for the trails
+            for (size_t bi = 0; bi < g_bodies.size(); ++bi) {
+                const glm::dvec3 pos = interpolatedPos(bi);
+                centers[bi]          = pos;
+                instances[bi].center = glm::vec3(pos - target);
+            }
 
             // ---------------- N-body draw ----------------
-            size_t frame = g_frameIndex % g_numFrames;
-            for (auto& body : g_bodies) {
-                if (frame >= body.positions.size()) continue;
-                glm::mat4 model = glm::translate(glm::mat4(1.0f),
-                                                 body.positions[frame]);
-                glm::mat4 mvp   = proj * view * model;
-                glUniformMatrix4fv(locMVP,   1, GL_FALSE, glm::value_ptr(mvp));
-                glUniformMatrix4fv(locModel, 1, GL_FALSE, glm::value_ptr(model));
-                glUniform3fv(locColor, 1, glm::value_ptr(body.color));
-                body.mesh.draw();
+            if (trajectory) {
+                renderer->drawTrajectory(*trajectory, g_frameIndex,
+                                         static_cast<float>(g_fraction),
+                                         static_cast<float>(g_span), target, instances,
+                                         proj * view, sunPos, camPos, pixelAngle);
+            } else {
+                renderer->draw(instances, proj * view, sunPos, camPos, pixelAngle);
+            }
+
+            // ---------------- Orbit trails ----------------
+            if (trails) {
+                // Hidden trails stop recording: start over when shown again
+                if (trailReset || (g_showTrails && !trailsShown)) trails->clear();
+                trailsShown = g_showTrails;
+                if (g_showTrails) {
+                    trails->update(centers, target + glm::dvec3(camPos), pixelAngle);
+                    trails->draw(proj * view, target);
+                }
             }
         }
 
@@ -811,6 +1171,11 @@ int main() {
         glfwSwapBuffers(win);
     }
 
+    g_live.reset();
+    g_stream.reset();
+    trails.reset();
+    trajectory.reset();
+    renderer.reset();
     glfwDestroyWindow(win);
 
     // cleanup legend objects
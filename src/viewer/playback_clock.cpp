@@ -0,0 +1,18 @@
+/*******************
+ * playback_clock.cpp
+ * @brief Wall-clock driven playback time
+ * @author Sinan Demir
+ * @date 10/16/2026
+ ******************/
+
+#include "viewer/playback_clock.h"
+
+double PlaybackClock::tick() {
+    const Clock::time_point now = Clock::now();
+    if (started && !isPaused) {
+        t += rate * std::chrono::duration<double>(now - last).count();
+    }
+    last    = now;
+    started = true;
+    return t;
+}
@@ -0,0 +1,292 @@
+/*******************
+ * software_renderer.cpp
+ * @brief CPU renderer for headless orbit-viewer output
+ * @author Sinan Demir
+ * @date 10/16/2026
+ ******************/
+
+#include "viewer/software_renderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Same clear color as the window (written as is, no gamma)
+const glm::vec3 BACKGROUND(0.02f, 0.02f, 0.05f);
+
+constexpr double NEAR_PLANE = 1.0e-9;   // GL units, as in the viewer
+
+/**
+ * @brief Liang-Barsky: the part of p + t * d, t in [t0, t1], inside the
+ *        box [lo, hi].
+ * @return false if none of it is
+ */
+bool clipToBox(const glm::dvec2& p, const glm::dvec2& d,
+               const glm::dvec2& lo, const glm::dvec2& hi,
+               double& t0, double& t1) {
+    const double q[4] = {p.x - lo.x, hi.x - p.x, p.y - lo.y, hi.y - p.y};
+    const double r[4] = {-d.x, d.x, -d.y, d.y};
+    for (int i = 0; i < 4; ++i) {
+        if (r[i] == 0.0) {
+            if (q[i] < 0.0) return false;   // parallel and outside
+            continue;
+        }
+        const double t = q[i] / r[i];
+        if (r[i] < 0.0) t0 = std::max(t0, t);
+        else            t1 = std::min(t1, t);
+        if (t0 > t1) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Body shader lighting for one surface point, display space.
+ */
+glm::vec3 shade(const glm::vec3& color, const glm::vec3& N,
+                const glm::vec3& L, const glm::vec3& V) {
+    const glm::vec3 H = glm::normalize(L + V);
+
+    // Lambert + Blinn–Phong
+    const float diff = std::max(glm::dot(N, L), 0.0f);
+    const float spec = std::pow(std::max(glm::dot(N, H), 0.0f), 32.0f);
+    const float ambient = 0.18f;
+
+    glm::vec3 c = color * (ambient + diff) + glm::vec3(0.4f) * spec;
+
+    // Rim light
+    const float rim = std::pow(1.0f - std::max(glm::dot(N, V), 0.0f), 2.0f);
+    c += glm::vec3(0.3f, 0.4f, 0.9f) * rim * 0.5f;
+
+    // Gamma
+    return glm::pow(glm::max(c, glm::vec3(0.0f)), glm::vec3(1.0f / 2.2f));
+}
+
+} // namespace
+
+// --------------------------------------------------
+// SoftwareTrails
+// --------------------------------------------------
+
+SoftwareTrails::SoftwareTrails(std::size_t bodies, std::size_t points)
+    : numBodies(bodies), ring(bodies * std::max<std::size_t>(points, 2)) {}
+
+void SoftwareTrails::append(const std::vector<glm::dvec3>& centers) {
+    if (numBodies == 0 || centers.size() != numBodies) return;
+
+    const std::size_t cap = capacity();
+    head = length ? (head + 1) % cap : 0;
+    std::copy(centers.begin(), centers.end(), ring.begin() + head * numBodies);
+    length = std::min(length + 1, cap);
+}
+
+// --------------------------------------------------
+// SoftwareRenderer
+// --------------------------------------------------
+
+SoftwareRenderer::SoftwareRenderer(int width, int height, unsigned threads)
+    : w(std::max(1, width)), h(std::max(1, height)), pool(threads) {
+    color.resize(static_cast<std::size_t>(w) * h);
+    depth.resize(static_cast<std::size_t>(w) * h);
+    bandSegments.resize(static_cast<std::size_t>((h + BAND_ROWS - 1) / BAND_ROWS));
+}
+
+void SoftwareRenderer::render(const std::vector<BodyInstance>& bodies,
+                              const SoftwareTrails* trails,
+                              const SoftwareCamera& camera,
+                              const glm::vec3& lightPos,
+                              std::vector<std::uint8_t>& rgb) {
+    // Camera basis (glm::lookAt) and tangent-space extents (perspective)
+    forward = glm::normalize(camera.target - camera.position);
+    right   = glm::normalize(glm::cross(forward, glm::dvec3(0.0, 1.0, 0.0)));
+    up      = glm::cross(right, forward);
+    tanY    = std::tan(camera.fovY * 0.5);
+    tanX    = tanY * double(w) / double(h);
+
+    auto toPixelX = [&](double x) { return (x / tanX + 1.0) * 0.5 * w - 0.5; };
+    auto toPixelY = [&](double y) { return (1.0 - y / tanY) * 0.5 * h - 0.5; };
+
+    // Screen rectangle of every body: bounds of (X ± R) / (Z ± R)
+    rects.resize(bodies.size());
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        const glm::dvec3 oc = glm::dvec3(bodies[i].center) - camera.position;
+        const double R = bodies[i].radius;
+        const double X = glm::dot(oc, right);
+        const double Y = glm::dot(oc, up);
+        const double Z = glm::dot(oc, forward);
+
+        Rect& r = rects[i];
+        if (Z + R <= NEAR_PLANE) {
+            r = {1, 1, 0, 0};   // behind the camera
+            continue;
+        }
+        if (Z - R <= NEAR_PLANE) {
+            r = {0, 0, w - 1, h - 1};   // camera inside or touching: test all
+            continue;
+        }
+        const double xs[4] = {(X - R) / (Z - R), (X - R) / (Z + R), (X + R) / (Z - R), (X + R) / (Z + R)};
+        const double ys[4] = {(Y - R) / (Z - R), (Y - R) / (Z + R), (Y + R) / (Z - R), (Y + R) / (Z + R)};
+        const double px0 = toPixelX(*std::min_element(xs, xs + 4));
+        const double px1 = toPixelX(*std::max_element(xs, xs + 4));
+        const double py0 = toPixelY(*std::max_element(ys, ys + 4));
+        const double py1 = toPixelY(*std::min_element(ys, ys + 4));
+
+        r.x0 = static_cast<int>(std::max(0.0, std::floor(px0)));
+        r.x1 = static_cast<int>(std::min(double(w - 1), std::ceil(px1)));
+        r.y0 = static_cast<int>(std::max(0.0, std::floor(py0)));
+        r.y1 = static_cast<int>(std::min(double(h - 1), std::ceil(py1)));
+    }
+
+    // Trails: every point to camera space once, then clip each segment
+    // (near plane in 3D, image in pixels) and bin it by band
+    segments.clear();
+    for (auto& list : bandSegments) list.clear();
+    if (trails && trails->bodies() == bodies.size() && trails->points() > 1) {
+        const std::size_t nb  = trails->bodies();
+        const std::size_t len = trails->points();
+        const float cap = static_cast<float>(trails->capacity());
+
+        viewPoints.resize(len * nb);
+        for (std::size_t age = 0; age < len; ++age) {
+            for (std::size_t b = 0; b < nb; ++b) {
+                const glm::dvec3 oc = trails->point(b, age) - camera.origin - camera.position;
+                viewPoints[age * nb + b] = {glm::dot(oc, right), glm::dot(oc, up), glm::dot(oc, forward)};
+            }
+        }
+
+        auto toPixel = [&](const glm::dvec3& v) {
+            return glm::dvec2(toPixelX(v.x / v.z), toPixelY(v.y / v.z));
+        };
+        // Half a pixel beyond the image so rounding still reaches the edges
+        const glm::dvec2 lo(-0.5, -0.5), hi(w - 0.5, h - 0.5);
+
+        const int bandCount = static_cast<int>(bandSegments.size());
+        for (std::size_t age = 0; age + 1 < len; ++age) {
+            for (std::size_t b = 0; b < nb; ++b) {
+                glm::dvec3 va = viewPoints[age * nb + b];
+                glm::dvec3 vb = viewPoints[(age + 1) * nb + b];
+                if (va.z <= NEAR_PLANE && vb.z <= NEAR_PLANE) continue;
+
+                // Near plane: move the end behind it onto the plane
+                if (va.z <= NEAR_PLANE || vb.z <= NEAR_PLANE) {
+                    const glm::dvec3 cut = va + (NEAR_PLANE - va.z) / (vb.z - va.z) * (vb - va);
+                    (va.z <= NEAR_PLANE ? va : vb) = glm::dvec3(cut.x, cut.y, NEAR_PLANE);
+                }
+
+                // Image: 1 / z is linear in screen space, so it carries over
+                const glm::dvec2 pa = toPixel(va), pb = toPixel(vb);
+                double t0 = 0.0, t1 = 1.0;
+                if (!clipToBox(pa, pb - pa, lo, hi, t0, t1)) continue;
+
+                const glm::dvec2 qa = pa + t0 * (pb - pa), qb = pa + t1 * (pb - pa);
+                const double iza = 1.0 / va.z, izb = 1.0 / vb.z;
+
+                const std::uint32_t index = static_cast<std::uint32_t>(segments.size());
+                segments.push_back({static_cast<float>(qa.x), static_cast<float>(qa.y),
+                                    static_cast<float>(iza + t0 * (izb - iza)),
+                                    static_cast<float>(qb.x), static_cast<float>(qb.y),
+                                    static_cast<float>(iza + t1 * (izb - iza)),
+                                    static_cast<std::uint32_t>(b),
+                                    0.7f * (1.0f - static_cast<float>(age) / cap)});
+
+                const double ymin = std::min(qa.y, qb.y), ymax = std::max(qa.y, qb.y);
+                const int b0 = std::max(0, static_cast<int>(std::floor(ymin + 0.5)) / BAND_ROWS);
+                const int b1 = std::min(bandCount - 1, static_cast<int>(std::floor(ymax + 0.5)) / BAND_ROWS);
+                for (int band = b0; band <= b1; ++band) bandSegments[band].push_back(index);
+            }
+        }
+    }
+
+    pool.parallelFor(bandSegments.size(), [&](std::size_t band) {
+        renderBand(static_cast<int>(band), bodies, camera, lightPos);
+    });
+
+    // Display space → 8-bit RGB
+    rgb.resize(color.size() * 3);
+    for (std::size_t i = 0; i < color.size(); ++i) {
+        const glm::vec3 c = glm::clamp(color[i], 0.0f, 1.0f);
+        rgb[3 * i + 0] = static_cast<std::uint8_t>(c.x * 255.0f + 0.5f);
+        rgb[3 * i + 1] = static_cast<std::uint8_t>(c.y * 255.0f + 0.5f);
+        rgb[3 * i + 2] = static_cast<std::uint8_t>(c.z * 255.0f + 0.5f);
+    }
+}
+
+/**
+ * @brief Renders scanlines [band * BAND_ROWS, +BAND_ROWS): bodies by
+ *        ray casting, then trail segments on top.
+ */
+void SoftwareRenderer::renderBand(int band,
+                                  const std::vector<BodyInstance>& bodies,
+                                  const SoftwareCamera& camera,
+                                  const glm::vec3& lightPos) {
+    const int y0 = band * BAND_ROWS;
+    const int y1 = std::min(h, y0 + BAND_ROWS);
+
+    for (int y = y0; y < y1; ++y) {
+        std::fill(color.begin() + std::size_t(y) * w, color.begin() + std::size_t(y + 1) * w, BACKGROUND);
+        std::fill(depth.begin() + std::size_t(y) * w, depth.begin() + std::size_t(y + 1) * w,
+                  std::numeric_limits<float>::infinity());
+    }
+
+    const glm::dvec3 light(lightPos);
+
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        const Rect& r = rects[i];
+        if (r.x0 > r.x1 || r.y1 < y0 || r.y0 >= y1) continue;
+
+        const glm::dvec3 oc = glm::dvec3(bodies[i].center) - camera.position;
+        const double R2 = double(bodies[i].radius) * double(bodies[i].radius);
+
+        for (int y = std::max(y0, r.y0); y <= std::min(y1 - 1, r.y1); ++y) {
+            const double sy = (1.0 - 2.0 * (y + 0.5) / h) * tanY;
+            for (int x = r.x0; x <= r.x1; ++x) {
+                const double sx = (2.0 * (x + 0.5) / w - 1.0) * tanX;
+                const glm::dvec3 d = glm::normalize(forward + sx * right + sy * up);
+
+                // Closest approach of the ray to the center, then the near hit
+                const double b = glm::dot(oc, d);
+                if (b <= 0.0) continue;
+                const glm::dvec3 q = oc - b * d;
+                const double h2 = R2 - glm::dot(q, q);
+                if (h2 < 0.0) continue;
+                const double t = b - std::sqrt(h2);
+                if (t <= NEAR_PLANE) continue;
+
+                const float z = static_cast<float>(t * glm::dot(d, forward));
+                const std::size_t pix = std::size_t(y) * w + x;
+                if (z >= depth[pix]) continue;
+
+                const glm::dvec3 rel = t * d - oc;   // hit - center
+                const glm::dvec3 hit = camera.position + t * d;
+                const glm::vec3 N(glm::normalize(rel));
+                const glm::vec3 L(glm::normalize(light - hit));
+                const glm::vec3 V(-d);
+
+                depth[pix] = z;
+                color[pix] = shade(bodies[i].color, N, L, V);
+            }
+        }
+    }
+
+    // Trails: DDA lines over the clipped segments (at most w + h steps),
+    // depth-tested against the bodies, blended
+    for (std::uint32_t s : bandSegments[band]) {
+        const Segment& seg = segments[s];
+        const glm::vec3 c = glm::pow(glm::max(bodies[seg.body].color, glm::vec3(0.0f)),
+                                     glm::vec3(1.0f / 2.2f));
+
+        const float dx = seg.x1 - seg.x0, dy = seg.y1 - seg.y0;
+        const int steps = std::max(1, static_cast<int>(std::ceil(std::max(std::fabs(dx), std::fabs(dy)))));
+        for (int k = 0; k < steps; ++k) {
+            const float f = static_cast<float>(k) / static_cast<float>(steps);
+            const int x = static_cast<int>(std::floor(seg.x0 + f * dx + 0.5f));
+            const int y = static_cast<int>(std::floor(seg.y0 + f * dy + 0.5f));
+            if (y < y0 || y >= y1 || x < 0 || x >= w) continue;
+
+            const std::size_t pix = std::size_t(y) * w + x;
+            if (1.0f / (seg.iz0 + f * (seg.iz1 - seg.iz0)) >= depth[pix]) continue;
+            color[pix] = color[pix] * (1.0f - seg.alpha) + c * seg.alpha;
+        }
+    }
+}
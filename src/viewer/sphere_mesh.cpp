@@ -96,3 +96,9 @@ void SphereMesh::draw() const {
     glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
 }
+
+void SphereMesh::drawInstanced(GLsizei instances) const {
+    glBindVertexArray(vao);
+    glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, instances);
+    glBindVertexArray(0);
+}
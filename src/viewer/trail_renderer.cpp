@@ -0,0 +1,332 @@
+/*******************
+ * trail_renderer.cpp
+ * @brief Orbit trail implementation for the orbit viewer
+ * @author Sinan Demir
+ * @date 10/16/2026
+ ******************/
+
+#include "viewer/trail_renderer.h"
+#include "viewer/shader_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace {
+
+// Vertex layout: ring b occupies slots [b * uSlots, (b + 1) * uSlots); the
+// last slot mirrors slot 0 so a wrapped ring draws as two strips without
+// losing the segment across the seam. The live segments of the frame
+// being drawn start at uLiveBase, after all rings.
+const char* TRAIL_VS = R"GLSL(
+    #version 330 core
+    layout(location = 0) in vec3 aHigh;   // world position = high + low
+    layout(location = 1) in vec3 aLow;
+
+    uniform mat4          uViewProj;   // camera-relative
+    uniform vec3          uOriginHigh; // camera target = high + low
+    uniform vec3          uOriginLow;
+    uniform float         uLogDepthC;
+    uniform samplerBuffer uTrack;     // per body: rgb color, a = head slot
+    uniform int           uSlots;     // ring slots + 1
+    uniform int           uRing;      // ring slots
+    uniform int           uPoints;    // points drawn per ring
+    uniform int           uLiveBase;  // first live-segment vertex
+
+    out vec4  vColor;
+    out float vLogDepth;
+
+    void main() {
+        int body;
+        int age = 0;
+        if (gl_VertexID >= uLiveBase) {
+            body = (gl_VertexID - uLiveBase) / 2;
+        } else {
+            body = gl_VertexID / uSlots;
+            int slot = gl_VertexID - body * uSlots;
+            if (slot == uRing) slot = 0;
+            int head = int(texelFetch(uTrack, body).a);
+            age = (head - slot + uRing) % uRing;
+        }
+
+        // Older points fade out
+        vec3 color = texelFetch(uTrack, body).rgb;
+        vColor = vec4(color, 0.7 * (1.0 - float(age) / float(uPoints)));
+        // High halves cancel exactly near the camera; the low halves
+        // carry the rest, so p keeps double's precision where it matters
+        vec3 p = (aHigh - uOriginHigh) + (aLow - uOriginLow);
+        gl_Position = uViewProj * vec4(p, 1.0);
+        vLogDepth   = 1.0 + uLogDepthC * gl_Position.w;
+    }
+)GLSL";
+
+const char* TRAIL_FS = R"GLSL(
+    #version 330 core
+    in vec4  vColor;
+    in float vLogDepth;
+    out vec4 FragColor;
+
+    uniform float uLogDepthScale;
+
+    void main() {
+        gl_FragDepth = log2(max(vLogDepth, 1.0)) * uLogDepthScale;
+
+        // Gamma, as for the bodies
+        FragColor = vec4(pow(vColor.rgb, vec3(1.0 / 2.2)), vColor.a);
+    }
+)GLSL";
+
+} // namespace
+
+TrailRenderer::~TrailRenderer() {
+    for (GLsync f : fence) {
+        if (f) glDeleteSync(f);
+    }
+    if (trackTexture) glDeleteTextures(1, &trackTexture);
+    if (trackBuffer)  glDeleteBuffers(1, &trackBuffer);
+    if (vbo)          glDeleteBuffers(1, &vbo);
+    if (vao)          glDeleteVertexArrays(1, &vao);
+    if (program)      glDeleteProgram(program);
+}
+
+bool TrailRenderer::init(const std::vector<glm::vec3>& colors, std::size_t points) {
+    const std::size_t bodies = colors.size();
+    if (bodies == 0 || points < 2) return false;
+
+    program = createProgram(TRAIL_VS, TRAIL_FS);
+    if (!program) return false;
+
+    locViewProj   = glGetUniformLocation(program, "uViewProj");
+    locOriginHigh = glGetUniformLocation(program, "uOriginHigh");
+    locOriginLow  = glGetUniformLocation(program, "uOriginLow");
+    locTrack    = glGetUniformLocation(program, "uTrack");
+    locSlots    = glGetUniformLocation(program, "uSlots");
+    locRing     = glGetUniformLocation(program, "uRing");
+    locPoints   = glGetUniformLocation(program, "uPoints");
+    locLiveBase = glGetUniformLocation(program, "uLiveBase");
+
+    // Ring size: as requested, within the byte budget. Per body: the
+    // spare slots and the mirror of slot 0, and a live segment per frame
+    // in flight
+    const std::size_t overhead = REGIONS + 2 * REGIONS;
+    const std::size_t budget   = MAX_BUFFER_BYTES / (bodies * sizeof(TrailVertex));
+    capacity = std::clamp<std::size_t>(budget > overhead + 2 ? budget - overhead : 2, 2, points);
+    if (capacity < points) {
+        std::cerr << "⚠️ Trails shortened to " << capacity << " points per body ("
+                  << (MAX_BUFFER_BYTES >> 20) << " MiB budget)\n";
+    }
+    ringSlots = capacity + REGIONS - 1;
+
+    const std::size_t vertices = bodies * (ringSlots + 1) + REGIONS * 2 * bodies;
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices * sizeof(TrailVertex), nullptr, GL_DYNAMIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(TrailVertex),
+                          (void*)offsetof(TrailVertex, high));
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TrailVertex),
+                          (void*)offsetof(TrailVertex, low));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    tracks.assign(bodies, Track{});
+    trackData.resize(bodies);
+    for (std::size_t b = 0; b < bodies; ++b) trackData[b] = glm::vec4(colors[b], 0.0f);
+
+    glGenBuffers(1, &trackBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, trackBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, bodies * sizeof(glm::vec4), trackData.data(), GL_DYNAMIC_DRAW);
+    glGenTextures(1, &trackTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, trackTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, trackBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    glUseProgram(program);
+    glUniform1i(locTrack, 0);
+    glUniform1i(locSlots, static_cast<GLint>(ringSlots + 1));
+    glUniform1i(locRing, static_cast<GLint>(ringSlots));
+    glUniform1i(locPoints, static_cast<GLint>(capacity));
+    glUniform1f(glGetUniformLocation(program, "uLogDepthC"), LOG_DEPTH_C);
+    glUniform1f(glGetUniformLocation(program, "uLogDepthScale"), logDepthScale());
+    glUseProgram(0);
+
+    firsts.reserve(3 * bodies);
+    counts.reserve(3 * bodies);
+
+    clear();
+    return true;
+}
+
+void TrailRenderer::clear() {
+    // Restarted rings write from slot 0, which in-flight draws may still
+    // read: let them finish (seeks and loops only)
+    for (std::size_t r = 0; r < REGIONS; ++r) waitForGPU(r);
+
+    for (Track& tr : tracks) {
+        tr.head   = static_cast<std::uint32_t>(ringSlots - 1);   // first point lands in slot 0
+        tr.length = 0;
+    }
+}
+
+/**
+ * @brief Blocks until the last draw in frame slot `r` has finished
+ *        (REGIONS frames ago, so normally long done).
+ */
+void TrailRenderer::waitForGPU(std::size_t r) {
+    if (!fence[r]) return;
+    glClientWaitSync(fence[r], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+    glDeleteSync(fence[r]);
+    fence[r] = nullptr;
+}
+
+void TrailRenderer::update(const std::vector<glm::dvec3>& centers,
+                           const glm::dvec3& viewPos,
+                           float pixelAngle) {
+    if (!program || centers.size() != tracks.size()) return;
+
+    const std::size_t bodies   = tracks.size();
+    const std::size_t slots    = ringSlots + 1;
+    const std::size_t r        = (region + 1) % REGIONS;
+    const std::size_t liveBase = bodies * slots + r * 2 * bodies;
+    const float cosTurn = std::cos(glm::radians(MAX_TURN_DEGREES));
+
+    // The ring slots written below and live segment copy r were last read
+    // by the draw REGIONS frames ago
+    waitForGPU(r);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    const GLsizeiptr bytes = static_cast<GLsizeiptr>((liveBase + 2 * bodies) * sizeof(TrailVertex));
+    auto* mapped = static_cast<TrailVertex*>(glMapBufferRange(
+        GL_ARRAY_BUFFER, 0, bytes,
+        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT));
+    if (!mapped) {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return;
+    }
+    region = r;
+
+    auto flush = [](std::size_t vertex, std::size_t n) {
+        glFlushMappedBufferRange(GL_ARRAY_BUFFER,
+                                 static_cast<GLintptr>(vertex * sizeof(TrailVertex)),
+                                 static_cast<GLsizeiptr>(n * sizeof(TrailVertex)));
+    };
+    auto split = [](const glm::dvec3& x) {
+        const glm::vec3 high(x);
+        return TrailVertex{high, glm::vec3(x - glm::dvec3(high))};
+    };
+    auto put = [&](std::size_t v, const glm::dvec3& x) {
+        mapped[v] = split(x);
+        flush(v, 1);
+    };
+
+    for (std::size_t b = 0; b < bodies; ++b) {
+        Track& tr = tracks[b];
+        const glm::dvec3& x = centers[b];
+
+        // Keep a point once the body moved a few pixels and turned, or
+        // moved far; the tolerance grows with distance from the camera
+        bool keep = tr.length == 0;
+        if (!keep) {
+            const glm::vec3 seg(x - tr.last);
+            const float d   = glm::length(seg);
+            const float px  = pixelAngle * static_cast<float>(glm::length(x - viewPos));
+            if (d > MIN_SEGMENT_PX * px) {
+                const bool straight = tr.dir != glm::vec3(0.0f) &&
+                                      glm::dot(seg / d, tr.dir) >= cosTurn;
+                keep = !straight || d > MAX_SEGMENT_PX * px;
+                if (keep) tr.dir = seg / d;
+            }
+        }
+
+        if (keep) {
+            tr.head   = static_cast<std::uint32_t>((tr.head + 1) % ringSlots);
+            tr.length = static_cast<std::uint32_t>(std::min<std::size_t>(tr.length + 1, capacity));
+            tr.last   = x;
+            if (tr.length == 1) tr.dir = glm::vec3(0.0f);
+
+            put(b * slots + tr.head, x);
+            if (tr.head == 0) put(b * slots + ringSlots, x);
+
+            trackData[b].w = static_cast<float>(tr.head);
+            trackDirty = true;
+        }
+
+        mapped[liveBase + 2 * b]     = split(tr.last);
+        mapped[liveBase + 2 * b + 1] = split(x);
+    }
+    flush(liveBase, 2 * bodies);
+
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (trackDirty) {
+        glBindBuffer(GL_TEXTURE_BUFFER, trackBuffer);
+        glBufferData(GL_TEXTURE_BUFFER, bodies * sizeof(glm::vec4), nullptr, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, bodies * sizeof(glm::vec4), trackData.data());
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        trackDirty = false;
+    }
+}
+
+void TrailRenderer::draw(const glm::mat4& viewProj, const glm::dvec3& origin) {
+    if (!program || tracks.empty()) return;
+
+    const std::size_t slots    = ringSlots + 1;
+    const std::size_t liveBase = tracks.size() * slots + region * 2 * tracks.size();
+
+    // Each ring as one range, or two when it wraps (the first one ends on
+    // the mirror of slot 0), then the live segment
+    firsts.clear();
+    counts.clear();
+    auto range = [&](std::size_t first, std::size_t count) {
+        if (count < 2) return;
+        firsts.push_back(static_cast<GLint>(first));
+        counts.push_back(static_cast<GLsizei>(count));
+    };
+    for (std::size_t b = 0; b < tracks.size(); ++b) {
+        const Track& tr = tracks[b];
+        if (tr.length == 0) continue;
+
+        const std::size_t start = (tr.head + ringSlots + 1 - tr.length) % ringSlots;
+        if (start + tr.length <= ringSlots) {
+            range(b * slots + start, tr.length);
+        } else {
+            range(b * slots + start, ringSlots - start + 1);
+            range(b * slots, tr.head + 1);
+        }
+        range(liveBase + 2 * b, 2);
+    }
+    if (firsts.empty()) return;
+
+    glUseProgram(program);
+    glUniformMatrix4fv(locViewProj, 1, GL_FALSE, glm::value_ptr(viewProj));
+    const glm::vec3 high(origin);
+    const glm::vec3 low(origin - glm::dvec3(high));
+    glUniform3fv(locOriginHigh, 1, glm::value_ptr(high));
+    glUniform3fv(locOriginLow,  1, glm::value_ptr(low));
+    glUniform1i(locLiveBase, static_cast<GLint>(liveBase));
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, trackTexture);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+
+    glBindVertexArray(vao);
+    glMultiDrawArrays(GL_LINE_STRIP, firsts.data(), counts.data(),
+                      static_cast<GLsizei>(firsts.size()));
+    glBindVertexArray(0);
+
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+
+    if (fence[region]) glDeleteSync(fence[region]);
+    fence[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
@@ -0,0 +1,88 @@
+/*******************
+ * trajectory_buffer.cpp
+ * @brief GPU-resident trajectory window implementation
+ * @author Sinan Demir
+ * @date 10/16/2026
+ ******************/
+
+#include "viewer/trajectory_buffer.h"
+
+#include <algorithm>
+#include <iostream>
+
+TrajectoryBuffer::~TrajectoryBuffer() {
+    if (texture) glDeleteTextures(1, &texture);
+    if (buffer)  glDeleteBuffers(1, &buffer);
+}
+
+bool TrajectoryBuffer::init(const glm::dvec3* states,
+                            std::size_t frames,
+                            std::size_t bodies) {
+    if (!states || frames == 0 || bodies == 0) return false;
+
+    source    = states;
+    numFrames = frames;
+    numBodies = bodies;
+
+    // Window = as many whole frames as the driver limit and budget allow
+    GLint maxTexels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+    std::size_t limit = std::min<std::size_t>(static_cast<std::size_t>(maxTexels),
+                                              MAX_WINDOW_BYTES / sizeof(glm::vec4));
+    window = std::clamp<std::size_t>(limit / (numBodies * TEXELS_PER_BODY),
+                                     std::min<std::size_t>(2, numFrames), numFrames);
+
+    texels.resize(window * numBodies * TEXELS_PER_BODY);
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+    glBufferData(GL_TEXTURE_BUFFER, texels.size() * sizeof(glm::vec4), nullptr, GL_STATIC_DRAW);
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_BUFFER, texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, buffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    uploadWindow(0);
+
+    if (window < numFrames) {
+        std::cout << "🎞️ Trajectory window: " << window << " of " << numFrames
+                  << " frames resident on the GPU\n";
+    }
+    return true;
+}
+
+GLint TrajectoryBuffer::select(std::size_t frame) {
+    frame %= numFrames;
+    const std::size_t last = std::min(frame + 1, numFrames - 1);
+    if (frame < firstFrame || last >= firstFrame + window) {
+        // Playback moves forward: start the new window at the playhead
+        uploadWindow(std::min(frame, numFrames - window));
+    }
+    return static_cast<GLint>(frame - firstFrame);
+}
+
+void TrajectoryBuffer::bind(GLuint unit) const {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_BUFFER, texture);
+}
+
+/**
+ * @brief Splits frames [first, first + window) into high/low/velocity
+ *        texels and uploads them into the buffer texture.
+ */
+void TrajectoryBuffer::uploadWindow(std::size_t first) {
+    firstFrame = first;
+
+    const glm::dvec3* state = source + first * numBodies * 2;
+    for (std::size_t i = 0; i < window * numBodies; ++i, state += 2) {
+        const glm::vec3 high(state[0]);
+        texels[3 * i]     = glm::vec4(high, 0.0f);
+        texels[3 * i + 1] = glm::vec4(glm::vec3(state[0] - glm::dvec3(high)), 0.0f);
+        texels[3 * i + 2] = glm::vec4(glm::vec3(state[1]), 0.0f);
+    }
+
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, texels.size() * sizeof(glm::vec4), texels.data());
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
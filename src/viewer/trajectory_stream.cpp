@@ -0,0 +1,372 @@
+/*******************
+ * trajectory_stream.cpp
+ * @brief Out-of-core trajectory playback implementation
+ * @author Sinan Demir
+ * @date 10/16/2026
+ ******************/
+
+#include "viewer/trajectory_stream.h"
+#include "trajectory_binary.h"
+#include "trajectory_csv.h"
+
+#include <algorithm>
+#include <filesystem>
+
+// --------------------------------------------------
+// Frame sources
+// --------------------------------------------------
+
+/**
+ * @brief Sequential frame reader with byte-offset repositioning.
+ */
+struct TrajectoryStream::Source {
+    virtual ~Source() = default;
+    virtual const std::vector<std::string>& names() const = 0;
+    /// Next frame with time, positions and velocities.
+    virtual bool next(TrajectoryFrame& frame) = 0;
+    /// Offset of the frame next() returns next.
+    virtual long long tell() = 0;
+    virtual void seek(long long offset) = 0;
+
+    /**
+     * @brief Positions the source at or shortly before frame `target`
+     *        without reading the frames in between.
+     * @param loFrame, lo  a frame known to be <= target and its offset
+     * @param hi           an offset at or past the start of frame
+     *                     target + 1 (-1 if unknown: end of file)
+     * @return index of the frame next() returns next (<= target; fewer
+     *         frames than that if the file ends first)
+     */
+    virtual std::size_t jump(std::size_t target, std::size_t loFrame, long long lo, long long hi) = 0;
+};
+
+namespace {
+
+long long currentSize(const std::string& path) {
+    std::error_code ec;
+    const auto bytes = std::filesystem::file_size(path, ec);
+    return ec ? 0 : static_cast<long long>(bytes);
+}
+
+/**
+ * @brief CSV rows with t = (step + 1) * dt and finite-difference
+ *        velocities. Reads one row ahead for the central difference.
+ */
+class CSVSource : public TrajectoryStream::Source {
+public:
+    CSVSource(const std::string& path, double dt) : reader(path), path(path), dt(dt) {
+        dataStart = static_cast<long long>(reader.tell());
+        TrajectoryCSVRow first;
+        if (reader.next(first)) {
+            firstStep = first.step;
+            rowBytes  = std::max(1.0, double(static_cast<long long>(reader.tell()) - dataStart));
+        }
+        reader.seek(dataStart);
+    }
+
+    const std::vector<std::string>& names() const override { return reader.bodyNames(); }
+
+    bool next(TrajectoryFrame& frame) override {
+        if (!primed) {
+            curOffset = static_cast<long long>(reader.tell());
+            if (!reader.next(cur)) return false;
+            primed  = true;
+            hasPrev = false;
+        }
+        if (done) return false;
+
+        const long long aheadOffset = static_cast<long long>(reader.tell());
+        const bool hasNext = reader.next(ahead);
+
+        const std::size_t n = cur.positions.size();
+        frame.t = time(cur);
+        frame.positions = cur.positions;
+        frame.velocities.resize(n);
+        for (std::size_t b = 0; b < n; ++b) {
+            if (hasPrev && hasNext) {
+                frame.velocities[b] = (ahead.positions[b] - prev.positions[b]) / (time(ahead) - time(prev));
+            } else if (hasNext) {
+                frame.velocities[b] = (ahead.positions[b] - cur.positions[b]) / (time(ahead) - time(cur));
+            } else if (hasPrev) {
+                frame.velocities[b] = (cur.positions[b] - prev.positions[b]) / (time(cur) - time(prev));
+            } else {
+                frame.velocities[b] = vec3(0.0, 0.0, 0.0);
+            }
+        }
+
+        std::swap(prev, cur);
+        hasPrev = true;
+        if (hasNext) {
+            std::swap(cur, ahead);
+            curOffset = aheadOffset;
+        } else {
+            done = true;
+        }
+        return true;
+    }
+
+    long long tell() override { return primed ? curOffset : static_cast<long long>(reader.tell()); }
+
+    void seek(long long offset) override {
+        reader.seek(offset);
+        primed = hasPrev = done = false;
+    }
+
+    /**
+     * @brief Interpolation search on the step column (rows are numbered
+     *        step - first step, one row per step as runSimulation writes
+     *        them): probe an estimated offset, resync on the next row and
+     *        narrow [lo, hi] until the target is a few rows ahead.
+     */
+    std::size_t jump(std::size_t target, std::size_t loFrame, long long lo, long long hi) override {
+        constexpr std::size_t NEAR_ROWS  = 16;   // read sequentially from here
+        constexpr int         MAX_PROBES = 64;
+
+        if (hi < 0) hi = currentSize(path);
+        double perRow = loFrame ? double(lo - dataStart) / double(loFrame) : rowBytes;
+
+        TrajectoryCSVRow row;
+        for (int probe = 0; probe < MAX_PROBES && target - loFrame > NEAR_ROWS; ++probe) {
+            // Aim a few rows short so the probe rarely lands past the target
+            const std::size_t rows = target - loFrame - NEAR_ROWS / 2;
+            long long guess = lo + static_cast<long long>(double(rows) * perRow);
+            if (guess >= hi) guess = lo + (hi - lo) / 2;   // estimate overshot: bisect
+            if (guess <= lo) break;
+
+            reader.syncTo(guess);
+            const long long at = static_cast<long long>(reader.tell());
+            if (at < 0 || !reader.next(row) || row.step < firstStep) {
+                hi = guess;   // past the last row
+                continue;
+            }
+
+            const std::size_t f = static_cast<std::size_t>(row.step - firstStep);
+            if (f > target || f <= loFrame) {
+                hi = guess;
+            } else {
+                perRow  = double(at - lo) / double(f - loFrame);
+                lo      = at;
+                loFrame = f;
+            }
+        }
+
+        seek(lo);
+        return loFrame;
+    }
+
+private:
+    double time(const TrajectoryCSVRow& row) const { return static_cast<double>(row.step + 1) * dt; }
+
+    TrajectoryCSVReader reader;
+    std::string         path;
+    double              dt;
+    long long           dataStart = 0;
+    long                firstStep = 0;
+    double              rowBytes  = 1.0;   ///< length of the first row
+    TrajectoryCSVRow    prev, cur, ahead;
+    long long           curOffset = 0;
+    bool                primed  = false;
+    bool                hasPrev = false;
+    bool                done    = false;
+};
+
+class BinarySource : public TrajectoryStream::Source {
+public:
+    explicit BinarySource(const std::string& path)
+        : reader(path), path(path), dataStart(static_cast<long long>(reader.tell())) {}
+
+    const std::vector<std::string>& names() const override { return reader.bodyNames(); }
+
+    bool next(TrajectoryFrame& frame) override { return reader.next(frame); }
+
+    long long tell() override { return static_cast<long long>(reader.tell()); }
+    void seek(long long offset) override { reader.seek(offset); }
+
+    /// Frames have a fixed size: straight to header + frame * frameBytes.
+    std::size_t jump(std::size_t target, std::size_t, long long, long long) override {
+        const long long bytes    = static_cast<long long>(reader.frameBytes());
+        const long long complete = std::max(0LL, currentSize(path) - dataStart) / bytes;
+        const std::size_t frame  = std::min(target, static_cast<std::size_t>(complete));
+        reader.seek(dataStart + static_cast<long long>(frame) * bytes);
+        return frame;
+    }
+
+private:
+    TrajectoryBinaryReader reader;
+    std::string            path;
+    long long              dataStart;
+};
+
+} // namespace
+
+// --------------------------------------------------
+// TrajectoryStream
+// --------------------------------------------------
+
+TrajectoryStream::TrajectoryStream(const std::string& path, double csvDt, std::size_t bufferBytes) {
+    if (isTrajectoryBinary(path)) {
+        source = std::make_unique<BinarySource>(path);
+    } else {
+        source = std::make_unique<CSVSource>(path, csvDt);
+    }
+
+    names    = source->names();
+    bodies   = names.size();
+    capacity = std::max<std::size_t>(2, bufferBytes / (2 * bodies * sizeof(vec3)));
+    ring.resize(capacity * 2 * bodies);
+    times.resize(capacity);
+
+    headerEnd = source->tell();
+    fileBytes = static_cast<long long>(std::filesystem::file_size(path));
+    checkpoints.push_back(headerEnd);
+
+    reader = std::thread(&TrajectoryStream::run, this);
+}
+
+TrajectoryStream::~TrajectoryStream() {
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        stopping = true;
+    }
+    cv.notify_all();
+    if (reader.joinable()) reader.join();
+}
+
+std::size_t TrajectoryStream::approxFrames() const {
+    const std::size_t exact = total.load();
+    return exact ? exact : estimate.load();
+}
+
+std::size_t TrajectoryStream::buffered() const {
+    std::lock_guard<std::mutex> lk(mtx);
+    return count;
+}
+
+/**
+ * @brief Copies one buffered frame out of the ring (lock held).
+ */
+void TrajectoryStream::copySlot(std::size_t frame, TrajectoryFrame& out) const {
+    const std::size_t slot = frame % capacity;
+    const vec3* src = &ring[slot * 2 * bodies];
+    out.t = times[slot];
+    out.positions.assign(src, src + bodies);
+    out.velocities.assign(src + bodies, src + 2 * bodies);
+}
+
+bool TrajectoryStream::acquire(std::size_t frame, TrajectoryFrame& out, TrajectoryFrame* following) {
+    std::lock_guard<std::mutex> lk(mtx);
+
+    const std::size_t end = total.load();
+    if (end && frame >= end) return false;
+
+    const bool lastFrame = end && frame + 1 == end;
+    const std::size_t need = (following && !lastFrame) ? 2 : 1;
+
+    if (!seekPending && frame >= base && frame + need <= base + count) {
+        // Frames behind the playhead are no longer needed
+        count -= frame - base;
+        base   = frame;
+
+        copySlot(frame, out);
+        if (following) copySlot(frame + need - 1, *following);
+        cv.notify_one();
+        return true;
+    }
+
+    // The reader gets there on its own if the frame is just ahead of it
+    const bool comingUp = frame >= base && frame < base + capacity;
+    if (!comingUp && !(seekPending && seekTarget == frame)) {
+        base        = frame;
+        count       = 0;
+        seekTarget  = frame;
+        seekPending = true;
+        atEnd       = false;
+        cv.notify_one();
+    }
+    return false;
+}
+
+/**
+ * @brief Reader thread: keeps the ring full ahead of the playhead and
+ *        serves seek requests.
+ */
+void TrajectoryStream::run() {
+    TrajectoryFrame frame;
+    std::size_t next = 0;   // index of the frame the source returns next
+
+    std::unique_lock<std::mutex> lk(mtx);
+    while (true) {
+        cv.wait(lk, [&] { return stopping || seekPending || (!atEnd && count < capacity); });
+        if (stopping) return;
+
+        if (seekPending) {
+            const std::size_t target = seekTarget;
+            seekPending = false;
+
+            lk.unlock();
+            const bool reached = reposition(target);
+            next = target;
+            lk.lock();
+
+            if (!reached) total.store(next = endFrame);
+            if (!seekPending) atEnd = !reached;
+            continue;
+        }
+
+        lk.unlock();
+        const long long offset = source->tell();
+        const bool ok = source->next(frame);
+        lk.lock();
+
+        if (seekPending) continue;   // superseded while reading
+
+        if (!ok || frame.positions.size() != bodies || frame.velocities.size() != bodies) {
+            atEnd = true;
+            total.store(next);
+            continue;
+        }
+
+        if (next % CHECKPOINT_EVERY == 0 && next / CHECKPOINT_EVERY == checkpoints.size()) {
+            checkpoints.push_back(offset);
+        }
+
+        const std::size_t slot = next % capacity;
+        std::copy(frame.positions.begin(), frame.positions.end(), ring.begin() + slot * 2 * bodies);
+        std::copy(frame.velocities.begin(), frame.velocities.end(), ring.begin() + (slot * 2 + 1) * bodies);
+        times[slot] = frame.t;
+        ++count;
+        ++next;
+
+        // Rough total from bytes per frame so far (seek step size)
+        if (!total.load() && offset > headerEnd && next % 256 == 0) {
+            const double perFrame = double(offset - headerEnd) / double(next - 1);
+            estimate.store(static_cast<std::size_t>(double(fileBytes - headerEnd) / perFrame));
+        }
+    }
+}
+
+/**
+ * @brief Positions the source so its next frame is `target`: jumps to the
+ *        frame before it (bracketed by the nearest checkpoints) and reads
+ *        up to the target, so a CSV target gets a central difference as in
+ *        a sequential read. Only called on the reader thread.
+ * @return false if the file ends first (frame count in endFrame)
+ */
+bool TrajectoryStream::reposition(std::size_t target) {
+    const std::size_t early = target ? target - 1 : 0;
+    const std::size_t k     = std::min(early / CHECKPOINT_EVERY, checkpoints.size() - 1);
+    const long long   hi    = k + 1 < checkpoints.size() ? checkpoints[k + 1] : -1;
+
+    TrajectoryFrame skipped;
+    for (std::size_t n = source->jump(early, k * CHECKPOINT_EVERY, checkpoints[k], hi); n < target; ++n) {
+        const long long offset = source->tell();
+        if (!source->next(skipped)) {
+            endFrame = n;
+            return false;
+        }
+        if (n % CHECKPOINT_EVERY == 0 && n / CHECKPOINT_EVERY == checkpoints.size()) {
+            checkpoints.push_back(offset);
+        }
+    }
+    return true;
+}
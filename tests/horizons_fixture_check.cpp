@@ -0,0 +1,196 @@
+/********************
+ * Author: Sinan Demir
+ * File: horizons_fixture_check.cpp
+ * Date: 10/16/2026
+ * Purpose:
+ *    Offline check of the HORIZONS parser against the replies in
+ *    tests/fixtures/horizons (KM-S, KM-D and AU-D tables, labelled and
+ *    CSV layouts, a GM header, raw API JSON and in-band errors).
+ *
+ *    Usage: horizons_fixture_check <fixture-dir>
+ *    Exit code 0 if every expectation holds (run by `ctest`).
+ *********************/
+
+#include "horizons_parser.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+int g_failures = 0;
+
+void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::cerr << "❌ " << what << "\n";
+        ++g_failures;
+    }
+}
+
+// Relative tolerance: the fixtures carry 16 significant digits
+void checkClose(double got, double want, const std::string& what) {
+    const double tol = 1e-12 * std::max(1.0, std::fabs(want));
+    if (!(std::fabs(got - want) <= tol)) {
+        std::ostringstream msg;
+        msg.precision(17);
+        msg << what << ": got " << got << ", want " << want;
+        check(false, msg.str());
+    }
+}
+
+void checkVec(const vec3& got, double x, double y, double z, const std::string& what) {
+    checkClose(got.x(), x, what + ".x");
+    checkClose(got.y(), y, what + ".y");
+    checkClose(got.z(), z, what + ".z");
+}
+
+std::string readFixture(const std::string& dir, const std::string& name) {
+    std::ifstream in(dir + "/" + name, std::ios::binary);
+    if (!in) throw std::runtime_error("cannot open fixture " + dir + "/" + name);
+    std::ostringstream buf;
+    buf << in.rdbuf();
+    return buf.str();
+}
+
+// True if fn() throws std::exception
+template <typename Fn>
+bool throws(Fn fn) {
+    try {
+        fn();
+    }
+    catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+// KM-S, VEC_TABLE 3 (LT/RG/RR lines ignored), GM from the geophysical header
+void checkEarthKmS(const std::string& dir) {
+    const HorizonsEphemeris e = parseHorizonsVectors(readFixture(dir, "earth_399_km_s.txt"));
+    check(e.targetName == "Earth", "earth: target name '" + e.targetName + "'");
+    check(e.targetId == "399", "earth: target id '" + e.targetId + "'");
+    check(e.centerName == "Solar System Barycenter", "earth: center name '" + e.centerName + "'");
+    check(e.centerId == "0", "earth: center id '" + e.centerId + "'");
+    checkClose(e.gm, 3.98600435436e14, "earth: GM");
+    check(e.states.size() == 2, "earth: expected 2 states");
+    if (e.states.size() != 2) return;
+
+    checkClose(e.states[0].jdTDB, 2460676.5, "earth[0].jd");
+    check(e.states[0].calendar == "2025-Jan-01 00:00:00.0000 TDB",
+          "earth[0].calendar '" + e.states[0].calendar + "'");
+    checkVec(e.states[0].position, -2.524181046186580e10, 1.329837287312346e11, 5.764431092147853e10,
+             "earth[0].position");
+    checkVec(e.states[0].velocity, -2.981570265318714e4, -4.732183497862913e3, -2.050671382015637e3,
+             "earth[0].velocity");
+
+    checkClose(e.states[1].jdTDB, 2460677.5, "earth[1].jd");
+    checkVec(e.states[1].position, -2.781258411207396e10, 1.325534106382941e11, 5.745776530893622e10,
+             "earth[1].position");
+    checkVec(e.states[1].velocity, -2.971839210464093e4, -5.227446903281568e3, -2.265441736710925e3,
+             "earth[1].velocity");
+}
+
+// KM-D, VEC_TABLE 2; GM sits in the right-hand column of the header
+void checkMoonKmD(const std::string& dir) {
+    const HorizonsEphemeris e = parseHorizonsVectors(readFixture(dir, "moon_301_km_d.txt"));
+    check(e.targetName == "Moon", "moon: target name '" + e.targetName + "'");
+    check(e.targetId == "301", "moon: target id '" + e.targetId + "'");
+    checkClose(e.gm, 4.902800066e12, "moon: GM");
+    check(e.states.size() == 2, "moon: expected 2 states");
+    if (e.states.size() != 2) return;
+
+    checkClose(e.states[0].jdTDB, 2460676.5, "moon[0].jd");
+    checkVec(e.states[0].position, -2.486720953150316e10, 1.332251930466581e11, 5.777823640185012e10,
+             "moon[0].position");
+    // km/day -> m/s
+    checkVec(e.states[0].velocity, -30444.874605680707, -3762.290985194994, -1622.365255830685,
+             "moon[0].velocity");
+
+    checkClose(e.states[1].jdTDB, 2460677.0, "moon[1].jd");
+    check(e.states[1].calendar == "2025-Jan-01 12:00:00.0000 TDB",
+          "moon[1].calendar '" + e.states[1].calendar + "'");
+    checkVec(e.states[1].velocity, -30407.7177535245, -4094.958635633406, -1776.9557237510808,
+             "moon[1].velocity");
+}
+
+// AU-D, CSV_FORMAT=YES, barycenter without GM (fallback mass applies)
+void checkJupiterAuDCsv(const std::string& dir) {
+    const HorizonsEphemeris e = parseHorizonsVectors(readFixture(dir, "jupiter_bary_5_au_d_csv.txt"));
+    check(e.targetName == "Jupiter Barycenter", "jupiter: target name '" + e.targetName + "'");
+    check(e.targetId == "5", "jupiter: target id '" + e.targetId + "'");
+    check(e.gm == 0.0, "jupiter: header has no GM");
+    check(naifFallbackMass(e.targetId) > 1.8e27, "jupiter: fallback mass");
+    check(e.states.size() == 3, "jupiter: expected 3 states");
+    if (e.states.size() != 3) return;
+
+    checkClose(e.states[0].jdTDB, 2460676.5, "jupiter[0].jd");
+    checkVec(e.states[0].position, 160127124535.86383, 677351191401.9651, 286433873228.3077,
+             "jupiter[0].position");
+
+    checkClose(e.states[2].jdTDB, 2460678.5, "jupiter[2].jd");
+    check(e.states[2].calendar == "2025-Jan-03 00:00:00.0000 TDB",
+          "jupiter[2].calendar '" + e.states[2].calendar + "'");
+    checkVec(e.states[2].position, 157895705481.08994, 677892141826.2039, 286720288608.6066,
+             "jupiter[2].position");
+    // AU/day -> m/s
+    checkVec(e.states[2].velocity, -12924.346697807065, 3117.709842489554, 1654.0643624253428,
+             "jupiter[2].velocity");
+}
+
+// Raw API JSON, API error object, in-band error text, non-JSON live reply
+void checkReplies(const std::string& dir) {
+    const std::string text = readFixture(dir, "earth_399_km_s.txt");
+    check(extractHorizonsResult(readFixture(dir, "earth_399_api.json"), true) == text,
+          "api json: result differs from the saved text");
+    check(extractHorizonsResult(text) == text, "plain text: not returned as is");
+
+    check(throws([&] { extractHorizonsResult(text, true); }),
+          "plain text accepted where JSON is required");
+    check(throws([&] { extractHorizonsResult("<html>502 Bad Gateway</html>", true); }),
+          "HTML error page accepted as a reply");
+    check(throws([&] { extractHorizonsResult(readFixture(dir, "error_api.json"), true); }),
+          "api error object accepted");
+
+    // HORIZONS reports e.g. ambiguous targets inside "result"
+    const std::string ambiguous = extractHorizonsResult(readFixture(dir, "ambiguous_api.json"), true);
+    check(throws([&] { parseHorizonsVectors(ambiguous); }),
+          "in-band error (no $$SOE) parsed as an ephemeris");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: horizons_fixture_check <fixture-dir>\n";
+        return 2;
+    }
+    const std::string dir = argv[1];
+
+    const struct {
+        const char* name;
+        void (*fn)(const std::string&);
+    } cases[] = {
+        {"earth KM-S",         checkEarthKmS},
+        {"moon KM-D",          checkMoonKmD},
+        {"jupiter AU-D (CSV)", checkJupiterAuDCsv},
+        {"API replies",        checkReplies},
+    };
+
+    for (const auto& c : cases) {
+        const int before = g_failures;
+        try {
+            c.fn(dir);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "❌ " << c.name << ": " << e.what() << "\n";
+            ++g_failures;
+        }
+        std::cout << (g_failures == before ? "✅ " : "❌ ") << c.name << "\n";
+    }
+    return g_failures == 0 ? 0 : 1;
+}
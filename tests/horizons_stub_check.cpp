@@ -0,0 +1,260 @@
+/********************
+ * Author: Sinan Demir
+ * File: horizons_stub_check.cpp
+ * Date: 10/16/2026
+ * Purpose:
+ *    fetchHorizonsBatch + CurlMultiTransport + HorizonsCache against a
+ *    local stub HTTP server (no network). The stub answers COMMAND='399'
+ *    with the Earth fixture, COMMAND='MARS' with HORIZONS' "multiple
+ *    matches" result and the /html path with a non-JSON error page.
+ *
+ *    Checks that:
+ *      - a fetched ephemeris is cached and served on the next run
+ *      - "2025-01-01" and "2025-01-01 00:00" share an entry (as sent)
+ *      - GET vs POST and different endpoints do not share entries
+ *      - in-band errors and non-JSON replies fail and are not cached
+ *
+ *    Usage: horizons_stub_check <fixture-dir>
+ *********************/
+
+#include "horizons.h"
+#include "horizons_cache.h"
+#include "horizons_parser.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+int g_failures = 0;
+
+void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::cerr << "❌ " << what << "\n";
+        ++g_failures;
+    }
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream buf;
+    buf << in.rdbuf();
+    return buf.str();
+}
+
+/********************
+ * class StubServer
+ * @brief: One-thread HTTP/1.1 server on 127.0.0.1 (ephemeral port); one
+ *         request per connection, replies chosen from the request line
+ *         and body.
+ *********************/
+class StubServer {
+public:
+    StubServer(std::string earthJson, std::string ambiguousJson)
+        : earth(std::move(earthJson)), ambiguous(std::move(ambiguousJson))
+    {
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family      = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port        = 0;
+        socklen_t len = sizeof(addr);
+        if (fd < 0 ||
+            ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            ::listen(fd, 16) != 0 ||
+            ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+            throw std::runtime_error("stub server: cannot listen on 127.0.0.1");
+        }
+        port   = ntohs(addr.sin_port);
+        worker = std::thread([this] { serve(); });
+    }
+
+    ~StubServer() {
+        stopping = true;
+        ::shutdown(fd, SHUT_RDWR);
+        ::close(fd);
+        worker.join();
+    }
+
+    std::string url(const std::string& path) const {
+        return "http://127.0.0.1:" + std::to_string(port) + path;
+    }
+
+    int requests() const { return served.load(); }
+
+private:
+    void serve() {
+        while (!stopping) {
+            const int c = ::accept(fd, nullptr, nullptr);
+            if (c < 0) continue;
+            handle(c);
+            ::close(c);
+        }
+    }
+
+    // Reads headers and Content-Length bytes of body, then replies
+    void handle(int c) {
+        std::string req;
+        char buf[4096];
+        std::size_t headerEnd = std::string::npos, need = 0;
+        while (true) {
+            const ssize_t n = ::recv(c, buf, sizeof(buf), 0);
+            if (n <= 0) return;
+            req.append(buf, static_cast<std::size_t>(n));
+            if (headerEnd == std::string::npos) {
+                headerEnd = req.find("\r\n\r\n");
+                if (headerEnd == std::string::npos) continue;
+                const std::size_t cl = req.find("Content-Length: ");
+                if (cl != std::string::npos && cl < headerEnd) {
+                    need = std::stoul(req.substr(cl + 16));
+                }
+            }
+            if (req.size() >= headerEnd + 4 + need) break;
+        }
+        ++served;
+
+        std::string type = "application/json", body;
+        const std::string requestLine = req.substr(0, req.find("\r\n"));
+        if (requestLine.find(" /html") != std::string::npos) {
+            type = "text/html";
+            body = "<html><body>502 Bad Gateway</body></html>";
+        }
+        else if (req.find("COMMAND='399'") != std::string::npos) {
+            body = earth;
+        }
+        else {
+            body = ambiguous;
+        }
+
+        std::ostringstream out;
+        out << "HTTP/1.1 200 OK\r\n"
+            << "Content-Type: " << type << "\r\n"
+            << "Content-Length: " << body.size() << "\r\n"
+            << "Connection: close\r\n\r\n"
+            << body;
+        const std::string reply = out.str();
+        for (std::size_t sent = 0; sent < reply.size();) {
+            const ssize_t n = ::send(c, reply.data() + sent, reply.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return;
+            sent += static_cast<std::size_t>(n);
+        }
+    }
+
+    std::string earth, ambiguous;
+    int fd = -1;
+    unsigned short port = 0;
+    std::atomic<bool> stopping{false};
+    std::atomic<int> served{0};
+    std::thread worker;
+};
+
+HorizonsFetchOptions request(const std::string& command, const std::string& start) {
+    HorizonsFetchOptions o;
+    o.command    = command;
+    o.center     = "@0";
+    o.start_time = start;
+    o.stop_time  = "2025-01-02";
+    o.step_size  = "1 d";
+    return o;
+}
+
+bool fetchOne(const std::string& endpoint, bool usePost, const HorizonsFetchOptions& req,
+              const HorizonsCache& cache, std::string& text) {
+    CurlTransportOptions topt;
+    topt.endpoint       = endpoint;
+    topt.usePost        = usePost;
+    topt.timeoutSeconds = 10;
+    CurlMultiTransport transport(topt);
+
+    std::vector<std::string> texts;
+    const bool ok = fetchHorizonsBatch({req}, transport, &cache, texts);
+    text = texts.empty() ? std::string() : texts[0];
+    return ok;
+}
+
+std::size_t cacheEntries(const std::string& dir) {
+    std::size_t n = 0;
+    std::error_code ec;
+    for (const auto& e : fs::directory_iterator(dir, ec)) {
+        if (e.path().extension() == ".txt") ++n;
+    }
+    return n;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: horizons_stub_check <fixture-dir>\n";
+        return 2;
+    }
+    const std::string dir = argv[1];
+
+    const fs::path cacheDir = fs::temp_directory_path()
+                            / ("orbit-sim-stub-cache-" + std::to_string(::getpid()));
+    fs::remove_all(cacheDir);
+    const HorizonsCache cache(cacheDir.string());
+
+    try {
+        StubServer stub(readFile(dir + "/earth_399_api.json"), readFile(dir + "/ambiguous_api.json"));
+        const std::string api   = stub.url("/api");
+        const std::string other = stub.url("/other");
+        std::string text;
+
+        // ---- fetch, then served from cache ----
+        check(fetchOne(api, false, request("399", "2025-01-01"), cache, text),
+              "GET 399: fetch failed");
+        check(hasVectorsTable(text) && parseHorizonsVectors(text).targetId == "399",
+              "GET 399: not the Earth ephemeris");
+        check(stub.requests() == 1, "GET 399: expected 1 request");
+        check(cacheEntries(cacheDir.string()) == 1, "GET 399: expected 1 cache entry");
+
+        check(fetchOne(api, false, request("399", "2025-01-01 00:00"), cache, text),
+              "GET 399 (time as sent): fetch failed");
+        check(stub.requests() == 1, "GET 399: '2025-01-01' and '2025-01-01 00:00' not one entry");
+
+        // ---- method and endpoint are part of the key ----
+        check(fetchOne(api, true, request("399", "2025-01-01"), cache, text),
+              "POST 399: fetch failed");
+        check(stub.requests() == 2, "POST 399: served from the GET entry");
+
+        check(fetchOne(other, false, request("399", "2025-01-01"), cache, text),
+              "GET 399 (other endpoint): fetch failed");
+        check(stub.requests() == 3, "other endpoint: served from another endpoint's entry");
+        check(cacheEntries(cacheDir.string()) == 3, "expected 3 cache entries");
+
+        // ---- in-band error: fails, not cached ----
+        check(!fetchOne(api, false, request("MARS", "2025-01-01"), cache, text),
+              "MARS: ambiguous target accepted");
+        check(!fetchOne(api, false, request("MARS", "2025-01-01"), cache, text),
+              "MARS: ambiguous target accepted on retry");
+        check(stub.requests() == 5, "MARS: in-band error served from cache");
+
+        // ---- non-JSON reply: fails, not cached ----
+        check(!fetchOne(stub.url("/html"), false, request("399", "2025-01-01"), cache, text),
+              "HTML reply accepted");
+        check(cacheEntries(cacheDir.string()) == 3, "a failed reply was cached");
+    }
+    catch (const std::exception& e) {
+        std::cerr << "❌ " << e.what() << "\n";
+        ++g_failures;
+    }
+
+    fs::remove_all(cacheDir);
+    std::cout << (g_failures == 0 ? "✅ " : "❌ ") << "HORIZONS stub server checks\n";
+    return g_failures == 0 ? 0 : 1;
+}